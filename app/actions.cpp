@@ -22,6 +22,7 @@
 #include <iostream>
 #include <mutex>
 #include <sstream>
+#include <string_view>
 
 // + standard includes
 #include <sys/stat.h>  // for stat()
@@ -129,6 +130,12 @@ std::ostream& operator<<(std::ostream& os, const std::pair<std::string, int>& st
 
 //! Print image Structure information
 int printStructure(std::ostream& out, Exiv2::PrintStructureOption option, const std::string& path);
+
+/*!
+  @brief Append \em str to \em json as a JSON string. Bytes which are not
+         part of a valid UTF-8 sequence are taken as Latin-1 characters.
+ */
+void appendJsonString(std::string& json, std::string_view str);
 }  // namespace
 
 // *****************************************************************************
@@ -212,6 +219,8 @@ int Print::run(const std::string& path) {
         return setModeAndPrintStructure(Exiv2::kpsXMP, path_, binary());
       case Params::pmIccProfile:
         return setModeAndPrintStructure(Exiv2::kpsIccProfile, path_, binary());
+      case Params::pmJson:
+        return printJson();
     }
     return 0;
   } catch (const Exiv2::Error& e) {
@@ -348,8 +357,6 @@ int Print::printList() {
     return -1;
   }
 
-  auto image = Exiv2::ImageFactory::open(path_);
-  image->readMetadata();
   // Set defaults for metadata types and data columns
   if (Params::instance().printTags_ == MetadataId::invalid) {
     Params::instance().printTags_ = MetadataId::exif | MetadataId::iptc | MetadataId::xmp;
@@ -357,6 +364,10 @@ int Print::printList() {
   if (Params::instance().printItems_ == 0) {
     Params::instance().printItems_ = Params::prKey | Params::prType | Params::prCount | Params::prTrans;
   }
+  auto image = Exiv2::ImageFactory::open(path_);
+  image->setReadFilter(readFilter());
+  image->setMakerNotePolicy(makerNotePolicy());
+  image->readMetadata();
   return printMetadata(image.get());
 }  // Print::printList
 
@@ -368,7 +379,7 @@ int Print::printMetadata(const Exiv2::Image* image) {
     for (auto&& md : exifData) {
       ret |= printMetadatum(md, image);
     }
-    if (exifData.empty())
+    if (exifData.empty() && (image->readFilter() & Exiv2::mdExif))
       noExif = true;
   }
 
@@ -378,7 +389,7 @@ int Print::printMetadata(const Exiv2::Image* image) {
     for (auto&& md : iptcData) {
       ret |= printMetadatum(md, image);
     }
-    if (iptcData.empty())
+    if (iptcData.empty() && (image->readFilter() & Exiv2::mdIptc))
       noIptc = true;
   }
 
@@ -388,7 +399,7 @@ int Print::printMetadata(const Exiv2::Image* image) {
     for (auto&& md : xmpData) {
       ret |= printMetadatum(md, image);
     }
-    if (xmpData.empty())
+    if (xmpData.empty() && (image->readFilter() & Exiv2::mdXmp))
       noXmp = true;
   }
 
@@ -410,6 +421,73 @@ int Print::printMetadata(const Exiv2::Image* image) {
   return rc;
 }  // Print::printMetadata
 
+int Print::printJson() {
+  if (!Exiv2::fileExists(path_)) {
+    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    return -1;
+  }
+
+  if (Params::instance().printTags_ == MetadataId::invalid) {
+    Params::instance().printTags_ = MetadataId::exif | MetadataId::iptc | MetadataId::xmp;
+  }
+  auto image = Exiv2::ImageFactory::open(path_);
+  image->setReadFilter(readFilter());
+  image->setMakerNotePolicy(makerNotePolicy());
+  image->readMetadata();
+  const Exiv2::ExifData& exifData = image->exifData();
+
+  // Build the whole line first and write it at once, most metadata fit in 64 bytes
+  std::string json;
+  json.reserve(64 * (1 + exifData.count() + image->iptcData().count() + image->xmpData().count()));
+  json += R"({"file":)";
+  appendJsonString(json, path_);
+  json += R"(,"metadata":[)";
+
+  bool ret = false;
+  auto appendMetadatum = [&](const Exiv2::Metadatum& md) {
+    if (!grepTag(md.key()) || !keyTag(md.key()))
+      return;
+    if (Params::instance().unknown_ && md.tagName().starts_with("0x"))
+      return;
+    json += ret ? R"(,{"key":)" : R"({"key":)";
+    ret = true;
+    appendJsonString(json, md.key());
+    json += R"(,"type":)";
+    if (const char* tn = md.typeName()) {
+      appendJsonString(json, tn);
+    } else {
+      json += "null";
+    }
+    json += R"(,"count":)";
+    json += std::to_string(md.count());
+    json += R"(,"value":)";
+    appendJsonString(json, md.toString());
+    json += R"(,"interpreted":)";
+    appendJsonString(json, md.print(&exifData));
+    json += '}';
+  };
+
+  if ((Params::instance().printTags_ & MetadataId::exif) == MetadataId::exif) {
+    for (auto&& md : exifData)
+      appendMetadatum(md);
+  }
+  if ((Params::instance().printTags_ & MetadataId::iptc) == MetadataId::iptc) {
+    for (auto&& md : image->iptcData())
+      appendMetadatum(md);
+  }
+  if ((Params::instance().printTags_ & MetadataId::xmp) == MetadataId::xmp) {
+    for (auto&& md : image->xmpData())
+      appendMetadatum(md);
+  }
+  json += "]}\n";
+  std::cout.write(json.data(), static_cast<std::streamsize>(json.size()));
+
+  // With -g or -K, return 1 if no matching tags were found
+  if ((!Params::instance().greps_.empty() || !Params::instance().keys_.empty()) && !ret)
+    return 1;
+  return 0;
+}  // Print::printJson
+
 bool Print::grepTag(const std::string& key) {
   bool result = Params::instance().greps_.empty();
   for (auto const& g : Params::instance().greps_) {
@@ -431,6 +509,40 @@ bool Print::keyTag(const std::string& key) {
   return result;
 }
 
+uint16_t Print::readFilter() {
+  auto metadataIds = static_cast<uint16_t>(Params::instance().printTags_);
+  if (Params::instance().keys_.empty())
+    return metadataIds;
+  // With -K only the families of the requested keys can be printed
+  uint16_t keyIds = Exiv2::mdNone;
+  for (const auto& key : Params::instance().keys_) {
+    if (key.starts_with("Exif."))
+      keyIds |= Exiv2::mdExif;
+    else if (key.starts_with("Iptc."))
+      keyIds |= Exiv2::mdIptc;
+    else if (key.starts_with("Xmp."))
+      keyIds |= Exiv2::mdXmp;
+  }
+  return metadataIds & keyIds;
+}
+
+Exiv2::MakerNotePolicy Print::makerNotePolicy() {
+  if (Params::instance().keys_.empty())
+    return Exiv2::MakerNotePolicy::full;
+  // With -K the makernote is only decoded if one of the keys is a makernote key
+  auto mnPolicy = Exiv2::MakerNotePolicy::none;
+  for (const auto& key : Params::instance().keys_) {
+    if (!key.starts_with("Exif."))
+      continue;
+    if (key == "Exif.Photo.MakerNote")
+      mnPolicy = Exiv2::MakerNotePolicy::rawBlob;
+    auto groupName = key.substr(5, key.find('.', 5) - 5);
+    if (Exiv2::ExifTags::isMakerGroup(groupName))
+      return Exiv2::MakerNotePolicy::full;
+  }
+  return mnPolicy;
+}
+
 static void binaryOutput(const std::ostringstream& os) {
   std::cout << os.str();
 }
@@ -834,39 +946,41 @@ int Extract::writeThumbnail() const {
     return -1;
   }
   auto image = Exiv2::ImageFactory::open(path_);
-  image->readMetadata();
-  Exiv2::ExifData& exifData = image->exifData();
-  if (exifData.empty()) {
-    std::cerr << path_ << ": " << _("No Exif data found in the file") << "\n";
-    return -3;
-  }
-  int rc = 0;
-  Exiv2::ExifThumb exifThumb(exifData);
-  std::string thumbExt = exifThumb.extension();
-  if (thumbExt.empty()) {
-    std::cerr << path_ << ": " << _("Image does not contain an Exif thumbnail") << "\n";
-  } else {
-    if ((Params::instance().target_ & Params::ctStdInOut) != 0) {
-      Exiv2::DataBuf buf = exifThumb.copy();
-      std::cout.write(buf.c_str(), buf.size());
-      return 0;
+  // Try to read a JPEG thumbnail directly, without decoding the Exif data
+  Exiv2::DataBuf buf = image->readExifThumbnail();
+  std::string thumbExt = ".jpg";
+  std::string mimeType = "image/jpeg";
+  if (buf.empty()) {
+    image->readMetadata();
+    Exiv2::ExifData& exifData = image->exifData();
+    if (exifData.empty()) {
+      std::cerr << path_ << ": " << _("No Exif data found in the file") << "\n";
+      return -3;
     }
-
-    std::string thumb = newFilePath(path_, "-thumb");
-    std::string thumbPath = thumb + thumbExt;
-    if (dontOverwrite(thumbPath))
+    Exiv2::ExifThumbC exifThumb(exifData);
+    thumbExt = exifThumb.extension();
+    if (thumbExt.empty()) {
+      std::cerr << path_ << ": " << _("Image does not contain an Exif thumbnail") << "\n";
       return 0;
-    if (Params::instance().verbose_) {
-      Exiv2::DataBuf buf = exifThumb.copy();
-      if (!buf.empty()) {
-        std::cout << _("Writing thumbnail") << " (" << exifThumb.mimeType() << ", " << buf.size() << " " << _("Bytes")
-                  << ") " << _("to file") << " " << thumbPath << '\n';
-      }
-    }
-    rc = static_cast<int>(exifThumb.writeFile(thumb));
-    if (rc == 0) {
-      std::cerr << path_ << ": " << _("Exif data doesn't contain a thumbnail") << "\n";
     }
+    mimeType = exifThumb.mimeType();
+    buf = exifThumb.copy();
+  }
+  if ((Params::instance().target_ & Params::ctStdInOut) != 0) {
+    std::cout.write(buf.c_str(), buf.size());
+    return 0;
+  }
+
+  std::string thumbPath = newFilePath(path_, "-thumb") + thumbExt;
+  if (dontOverwrite(thumbPath))
+    return 0;
+  if (Params::instance().verbose_ && !buf.empty()) {
+    std::cout << _("Writing thumbnail") << " (" << mimeType << ", " << buf.size() << " " << _("Bytes") << ") "
+              << _("to file") << " " << thumbPath << '\n';
+  }
+  int rc = buf.empty() ? 0 : static_cast<int>(Exiv2::writeFile(buf, thumbPath));
+  if (rc == 0) {
+    std::cerr << path_ << ": " << _("Exif data doesn't contain a thumbnail") << "\n";
   }
   return rc;
 }  // Extract::writeThumbnail
@@ -1285,11 +1399,7 @@ void Modify::delMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
     }
   }
   if (modifyCmd.metadataId_ == MetadataId::iptc) {
-    Exiv2::IptcData::iterator pos;
-    const Exiv2::IptcKey iptcKey(modifyCmd.key_);
-    while ((pos = iptcData.findKey(iptcKey)) != iptcData.end()) {
-      iptcData.erase(pos);
-    }
+    iptcData.eraseKey(Exiv2::IptcKey(modifyCmd.key_));
   }
   if (modifyCmd.metadataId_ == MetadataId::xmp) {
     const Exiv2::XmpKey xmpKey(modifyCmd.key_);
@@ -1991,4 +2101,53 @@ int printStructure(std::ostream& out, Exiv2::PrintStructureOption option, const
   image->printStructure(out, option);
   return 0;
 }
+
+void appendJsonString(std::string& json, std::string_view str) {
+  static constexpr char hexDigits[] = "0123456789abcdef";
+  auto appendEscape = [&json](unsigned char c) {
+    json += "\\u00";
+    json += hexDigits[c >> 4];
+    json += hexDigits[c & 0xf];
+  };
+
+  json.reserve(json.size() + str.size() + 2);
+  json += '"';
+  for (size_t i = 0; i < str.size(); ++i) {
+    const auto c = static_cast<unsigned char>(str[i]);
+    if (c == '"' || c == '\\') {
+      json += '\\';
+      json += static_cast<char>(c);
+    } else if (c == '\n') {
+      json += "\\n";
+    } else if (c == '\r') {
+      json += "\\r";
+    } else if (c == '\t') {
+      json += "\\t";
+    } else if (c < 0x20) {
+      appendEscape(c);
+    } else if (c < 0x80) {
+      json += static_cast<char>(c);
+    } else {
+      size_t len = 0;
+      if (c >= 0xc2 && c <= 0xdf)
+        len = 2;
+      else if (c >= 0xe0 && c <= 0xef)
+        len = 3;
+      else if (c >= 0xf0 && c <= 0xf4)
+        len = 4;
+      bool valid = len > 0 && i + len <= str.size();
+      for (size_t j = 1; valid && j < len; ++j) {
+        const auto cc = static_cast<unsigned char>(str[i + j]);
+        valid = cc >= 0x80 && cc <= 0xbf;
+      }
+      if (valid) {
+        json.append(str.substr(i, len));
+        i += len - 1;
+      } else {
+        appendEscape(c);
+      }
+    }
+  }
+  json += '"';
+}
 }  // namespace
@@ -144,10 +144,16 @@ class Print : public Task {
   int printSummary();
   //! Print Exif, IPTC and XMP metadata in user defined format
   int printList();
+  //! Print Exif, IPTC and XMP metadata as one line of JSON
+  int printJson();
   //! Return true if key should be printed, else false
   static bool grepTag(const std::string& key);
   //! Return true if key should be printed, else false
   static bool keyTag(const std::string& key);
+  //! Return the metadata to read for printing, derived from the metadata types and keys requested
+  static uint16_t readFilter();
+  //! Return how to read the makernote, derived from the keys requested
+  static Exiv2::MakerNotePolicy makerNotePolicy();
   //! Print all metadata in a user defined format
   int printMetadata(const Exiv2::Image* image);
   //! Print a metadatum in a user defined format, return true if something was printed
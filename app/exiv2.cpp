@@ -116,6 +116,13 @@ bool parseLine(ModifyCmd& modifyCmd, const std::string& line, int num);
   @param input Input string, assumed to be UTF-8
  */
 std::string parseEscapes(const std::string& input);
+
+/*!
+  @brief Print the timing and I/O counters of the current thread
+  @param os Output stream
+  @param file Name of the file the counters belong to
+ */
+void printStats(std::ostream& os, const std::string& file);
 }  // namespace
 
 // *****************************************************************************
@@ -176,7 +183,11 @@ int main(int argc, char* const argv[]) {
                     << '\n';
         }
         task->setBinary(params.binary_);
+        if (params.stats_)
+          Exiv2::threadStats().reset();
         int ret = task->run(file);
+        if (params.stats_)
+          printStats(std::cerr, file);
         if (returnCode == EXIT_SUCCESS)
           returnCode = ret;
       }
@@ -196,7 +207,7 @@ int main(int argc, char* const argv[]) {
 // class Params
 
 Params::Params() :
-    optstring_(":hVvqfbuktTFa:Y:O:D:r:p:P:d:e:i:c:m:M:l:S:g:K:n:Q:"),
+    optstring_(":hVvqfbusktTFa:Y:O:D:r:p:P:d:e:i:c:m:M:l:S:g:K:n:Q:"),
     target_(ctExif | ctIptc | ctComment | ctXmp),
     yodAdjust_(emptyYodAdjust_),
     format_("%Y%m%d_%H%M%S") {
@@ -268,6 +279,7 @@ void Params::help(std::ostream& os) const {
      << _("   -Q lvl  Set log-level to d(ebug), i(nfo), w(arning), e(rror) or m(ute)\n")
      << _("   -b      Obsolete, reserved for use with the test suit\n")
      << _("   -u      Show unknown tags (e.g., Exif.SonyMisc3c.0x022b)\n")
+     << _("   -s      Print timing and I/O statistics per file to stderr (stats)\n")
      << _("   -g str  Only output where 'str' matches in output text (grep)\n"
           "           Append /i to 'str' for case insensitive\n")
      << _("   -K key  Only output where 'key' exactly matches tag's key\n")
@@ -294,6 +306,7 @@ void Params::help(std::ostream& os) const {
      << _("             R : Recursive print structure of image (debug build only)\n")
      << _("             S : Print structure of image (limited file types)\n")
      << _("             X : Extract \"raw\" XMP\n")
+     << _("             j : Exif, IPTC and XMP tags as one line of JSON per file\n")
      << _("   -P flgs Print flags for fine control of tag lists ('print' action):\n")
      << _("             E : Exif tags\n") << _("             I : IPTC tags\n") << _("             X : XMP tags\n")
      << _("             x : Tag number for Exif or IPTC tags (in hexadecimal)\n")
@@ -377,6 +390,13 @@ int Params::option(int opt, const std::string& optArg, int optOpt) {
     case 'u':
       unknown_ = false;
       break;
+    case 's':
+      if (!Exiv2::statsEnabled()) {
+        std::cerr << progname() << ": " << _("Option") << " -s " << _("is not supported by this build of Exiv2\n");
+        rc = 1;
+      }
+      stats_ = true;
+      break;
     case 'f':
       force_ = true;
       fileExistsPolicy_ = overwritePolicy;
@@ -390,7 +410,8 @@ int Params::option(int opt, const std::string& optArg, int optOpt) {
       break;
     case 'K':
       rc = evalKey(optArg);
-      printMode_ = pmList;
+      if (printMode_ != pmJson)
+        printMode_ = pmList;
       break;
     case 'n':
       charset_ = optArg;
@@ -666,6 +687,10 @@ int Params::evalPrint(const std::string& optArg) {
           action_ = Action::print;
           printMode_ = pmXMP;
           break;
+        case 'j':
+          action_ = Action::print;
+          printMode_ = pmJson;
+          break;
         default:
           std::cerr << progname() << ": " << _("Unrecognized print mode") << " `" << optArg << "'\n";
           rc = 1;
@@ -1011,13 +1036,13 @@ int Params::getopt(int argc, char* const Argv[]) {
   argv.back() = nullptr;
 
   const std::unordered_map<std::string, std::string> longs{
-      {"--adjust", "-a"},    {"--binary", "-b"},  {"--comment", "-c"}, {"--delete", "-d"},   {"--days", "-D"},
-      {"--extract", "-e"},   {"--force", "-f"},   {"--Force", "-F"},   {"--grep", "-g"},     {"--help", "-h"},
-      {"--insert", "-i"},    {"--keep", "-k"},    {"--key", "-K"},     {"--location", "-l"}, {"--modify", "-m"},
-      {"--Modify", "-M"},    {"--encode", "-n"},  {"--months", "-O"},  {"--print", "-p"},    {"--Print", "-P"},
-      {"--quiet", "-q"},     {"--log", "-Q"},     {"--rename", "-r"},  {"--suffix", "-S"},   {"--timestamp", "-t"},
-      {"--Timestamp", "-T"}, {"--unknown", "-u"}, {"--verbose", "-v"}, {"--Version", "-V"},  {"--version", "-V"},
-      {"--years", "-Y"},
+      {"--adjust", "-a"},    {"--binary", "-b"},    {"--comment", "-c"}, {"--delete", "-d"},   {"--days", "-D"},
+      {"--extract", "-e"},   {"--force", "-f"},     {"--Force", "-F"},   {"--grep", "-g"},     {"--help", "-h"},
+      {"--insert", "-i"},    {"--keep", "-k"},      {"--key", "-K"},     {"--location", "-l"}, {"--modify", "-m"},
+      {"--Modify", "-M"},    {"--encode", "-n"},    {"--months", "-O"},  {"--print", "-p"},    {"--Print", "-P"},
+      {"--quiet", "-q"},     {"--log", "-Q"},       {"--rename", "-r"},  {"--stats", "-s"},    {"--suffix", "-S"},
+      {"--timestamp", "-t"}, {"--Timestamp", "-T"}, {"--unknown", "-u"}, {"--verbose", "-v"},  {"--Version", "-V"},
+      {"--version", "-V"},   {"--years", "-Y"},
   };
 
   for (int i = 0; i < argc; i++) {
@@ -1499,4 +1524,21 @@ std::string parseEscapes(const std::string& input) {
   return result;
 }
 
+void printStats(std::ostream& os, const std::string& file) {
+  const auto& stats = Exiv2::threadStats();
+  os << _("Statistics for") << " " << file << ":\n";
+  for (size_t i = 0; i < Exiv2::statsPhaseCount; ++i) {
+    const auto phase = static_cast<Exiv2::StatsPhase>(i);
+    const auto& ps = stats.phase(phase);
+    if (ps.calls_ == 0)
+      continue;
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(ps.time_).count();
+    os << "  " << std::left << std::setw(16) << Exiv2::statsPhaseName(phase) << std::right << std::setw(8)
+       << ps.calls_ << " " << _("calls") << " " << std::setw(10) << us << " us\n";
+  }
+  os << "  " << _("reads") << " " << stats.reads_ << " (" << stats.bytesRead_ << " " << _("bytes") << "), "
+     << _("writes") << " " << stats.writes_ << " (" << stats.bytesWritten_ << " " << _("bytes") << "), " << _("seeks")
+     << " " << stats.seeks_ << ", " << _("mmaps") << " " << stats.mmaps_ << "\n";
+}
+
 }  // namespace
@@ -133,6 +133,7 @@ class Params : public Util::Getopt {
     pmXMP,
     pmIccProfile,
     pmRecursive,
+    pmJson,
   };
 
   //! Individual items to print, bitmap
@@ -194,6 +195,7 @@ class Params : public Util::Getopt {
   bool force_{false};                             //!< Force overwrites flag.
   bool binary_{false};                            //!< Suppress long binary values.
   bool unknown_{true};                            //!< Suppress unknown tags.
+  bool stats_{false};                             //!< Print timing and I/O statistics.
   bool preserve_{false};                          //!< Preserve timestamps flag.
   bool timestamp_{false};                         //!< Rename also sets the file timestamp.
   bool timestampOnly_{false};                     //!< Rename only sets the file timestamp.
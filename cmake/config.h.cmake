@@ -18,6 +18,9 @@
 // Define if you want to enable the decoding of video metadata
 #cmakedefine EXV_ENABLE_VIDEO
 
+// Define if you want per-phase timing and I/O counters.
+#cmakedefine EXV_ENABLE_STATS
+
 // Define if you want BMFF support.
 #cmakedefine EXV_ENABLE_BMFF
 
@@ -42,6 +42,8 @@ if (APPLE)
     set(CMAKE_FIND_FRAMEWORK NEVER)
 endif()
 
+find_package(Threads REQUIRED)
+
 if( EXIV2_ENABLE_PNG )
     find_package( ZLIB REQUIRED )
 endif( )
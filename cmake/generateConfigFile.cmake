@@ -38,5 +38,6 @@ int main() {
 
 set(EXV_ENABLE_NLS ${EXIV2_ENABLE_NLS})
 set(EXV_ENABLE_VIDEO ${EXIV2_ENABLE_VIDEO})
+set(EXV_ENABLE_STATS ${EXIV2_ENABLE_STATS})
 
 configure_file(cmake/config.h.cmake ${CMAKE_BINARY_DIR}/exv_conf.h @ONLY)
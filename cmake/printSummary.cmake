@@ -54,6 +54,7 @@ OptionOutput( "Building BMFF support:              " EXIV2_ENABLE_BMFF
 OptionOutput( "Brotli support for JPEG XL:         " EXIV2_ENABLE_BMFF AND BROTLI_FOUND )
 OptionOutput( "Native language support:            " EXIV2_ENABLE_NLS                   )
 OptionOutput( "Building video support:             " EXIV2_ENABLE_VIDEO                 )
+OptionOutput( "Timing and I/O statistics:          " EXIV2_ENABLE_STATS                 )
 OptionOutput( "Nikon lens database:                " EXIV2_ENABLE_LENSDATA              )
 OptionOutput( "Building webready support:          " EXIV2_ENABLE_WEBREADY              )
 if    ( EXIV2_ENABLE_WEBREADY )
@@ -13,6 +13,7 @@
 
 // + standard includes
 #include <memory>
+#include <vector>
 
 // *****************************************************************************
 // namespace extensions
@@ -275,15 +276,28 @@ class EXIV2API IoCloser {
  */
 class EXIV2API FileIo : public BasicIo {
  public:
+  //! Implementations of the file access
+  enum class Backend {
+    stdio,       //!< Buffered C stdio streams
+    positional,  //!< A file descriptor with pread and pwrite and a private read-ahead buffer
+  };
+
   //! @name Creators
   //@{
   /*!
     @brief Constructor that accepts the file path on which IO will be
         performed. The constructor does not open the file, and
-        therefore never fails.
+        therefore never fails. The file is accessed with the default
+        backend, see setDefaultBackend().
     @param path The full path of a file
    */
   explicit FileIo(const std::string& path);
+  /*!
+    @brief Constructor that accepts the file path and the backend to
+        access the file with. Platforms without pread and pwrite always
+        use the stdio backend.
+   */
+  FileIo(const std::string& path, Backend backend);
 #ifdef _WIN32
   explicit FileIo(const std::wstring& path);
 #endif
@@ -464,6 +478,36 @@ class EXIV2API FileIo : public BasicIo {
           are all downloaded from the remote file to memory.
    */
   void populateFakeData() override;
+  //! Return the backend the file is accessed with
+  [[nodiscard]] Backend backend() const;
+  /*!
+    @brief Read data at \em offset without using or changing the current
+        IO position. Several threads may call this method on the same
+        open instance at the same time, as long as no other method is
+        called concurrently. Only the positional backend supports it.
+    @return Number of bytes read, fewer than \em rcount at the end of
+        the file or on failure
+    @throw Error with the stdio backend
+   */
+  size_t readAt(byte* buf, size_t rcount, size_t offset) const;
+  /*!
+    @brief Read the first \em count bytes of the file into memory. The
+        positional backend serves later reads of them from memory, also
+        after the file is closed and reopened, until it is written to.
+        The instance need not be open, so another thread can prefetch
+        the file before it is handed to the thread which parses it. Has
+        no effect with the stdio backend.
+    @return 0 if successful
+   */
+  int prefetch(size_t count);
+  //@}
+
+  //! @name Backend selection
+  //@{
+  //! Set the backend of the FileIo instances which are created afterwards
+  static void setDefaultBackend(Backend backend);
+  //! Return the backend of newly created FileIo instances, Backend::stdio unless set
+  static Backend defaultBackend();
   //@}
 
  private:
@@ -540,6 +584,15 @@ class EXIV2API MemIo : public BasicIo {
            0 if failure;
    */
   size_t write(BasicIo& src) override;
+  /*!
+    @brief Preallocate the internal memory block for at least \em size
+        bytes. Use this as a hint when the final size of the data to be
+        written is approximately known, to avoid growing the memory block
+        repeatedly. The size of the data and the IO position do not change.
+    @param size Number of bytes to allocate.
+    @throw Error if the memory cannot be allocated.
+   */
+  void reserve(size_t size);
   /*!
     @brief Write one byte to the memory block. The IO position is
         advanced by one byte.
@@ -608,6 +661,12 @@ class EXIV2API MemIo : public BasicIo {
    */
   byte* mmap(bool /*isWriteable*/ = false) override;
   int munmap() override;
+  /*!
+    @brief Free the memory blocks which MemIo objects destroyed on the
+        calling thread keep for reuse by later MemIo objects. A thread
+        keeps up to 4 blocks and 64 MB until it exits or calls this.
+   */
+  static void releasePool();
   //@}
 
   //! @name Accessors
@@ -650,6 +709,102 @@ class EXIV2API MemIo : public BasicIo {
 
 };  // class MemIo
 
+/*!
+  @brief Forwards all calls to another BasicIo and records an event for each
+      open, close, read, write, seek, mmap and transfer. Use it to analyse
+      the I/O pattern of a parser, e.g. by opening the image with
+      ImageFactory::open(const std::string&, bool, bool) and inspecting
+      events() or summary() after Image::readMetadata().
+
+  Reads with getb() and writes with putb() are recorded as one byte reads
+  and writes.
+ */
+class EXIV2API TracingIo : public BasicIo {
+ public:
+  //! Kinds of recorded events
+  enum Op { opOpen, opClose, opRead, opWrite, opSeek, opMmap, opMunmap, opTransfer };
+
+  //! One recorded call
+  struct Event {
+    Op op_;          //!< Kind of the call
+    size_t offset_;  //!< IO position before a read or write, after a seek
+    size_t length_;  //!< Number of bytes read, written, mapped or transferred
+  };
+
+  //! Totals of the recorded events
+  struct Summary {
+    size_t opens_{0};         //!< Number of open calls
+    size_t reads_{0};         //!< Number of read and getb calls
+    size_t smallReads_{0};    //!< Number of reads of less than smallReadSize bytes
+    size_t bytesRead_{0};     //!< Number of bytes read
+    size_t writes_{0};        //!< Number of write and putb calls
+    size_t bytesWritten_{0};  //!< Number of bytes written
+    size_t seeks_{0};         //!< Number of seek calls
+    size_t mmaps_{0};         //!< Number of mmap calls
+    size_t size_{0};          //!< Size of the IO source when the summary was made
+
+    //! Bytes read per byte of the IO source, 0 for an empty source
+    [[nodiscard]] double readAmplification() const {
+      return size_ == 0 ? 0.0 : static_cast<double>(bytesRead_) / static_cast<double>(size_);
+    }
+  };
+
+  //! Reads of fewer bytes are counted as small reads in the summary
+  static constexpr size_t smallReadSize = 16;
+
+  //! @name Creators
+  //@{
+  //! Constructor, takes ownership of the IO to forward to
+  explicit TracingIo(BasicIo::UniquePtr io);
+  //@}
+
+  //! @name Manipulators
+  //@{
+  int open() override;
+  int close() override;
+  size_t write(const byte* data, size_t wcount) override;
+  size_t write(BasicIo& src) override;
+  int putb(byte data) override;
+  DataBuf read(size_t rcount) override;
+  size_t read(byte* buf, size_t rcount) override;
+  int getb() override;
+  void transfer(BasicIo& src) override;
+  int seek(int64_t offset, Position pos) override;
+  byte* mmap(bool isWriteable = false) override;
+  int munmap() override;
+  void populateFakeData() override;
+  //! Remove all recorded events
+  void clearEvents();
+  //@}
+
+  //! @name Accessors
+  //@{
+  [[nodiscard]] size_t tell() const override;
+  [[nodiscard]] size_t size() const override;
+  [[nodiscard]] bool isopen() const override;
+  [[nodiscard]] int error() const override;
+  [[nodiscard]] bool eof() const override;
+  [[nodiscard]] const std::string& path() const noexcept override;
+  //! Return the IO all calls are forwarded to
+  [[nodiscard]] BasicIo& io() const {
+    return *io_;
+  }
+  //! Return the recorded events in the order of the calls
+  [[nodiscard]] const std::vector<Event>& events() const {
+    return events_;
+  }
+  //! Return the totals of the recorded events
+  [[nodiscard]] Summary summary() const;
+  //@}
+
+ private:
+  //! Record an event
+  void record(Op op, size_t offset, size_t length);
+
+  BasicIo::UniquePtr io_;
+  std::vector<Event> events_;
+};  // class TracingIo
+
 /*!
   @brief Provides binary IO for the data from stdin and data uri path.
  */
@@ -132,6 +132,56 @@ EXIV2API ExifData::const_iterator sensingMethod(const ExifData& ed);
 //! expected/desired metadata most of the time.
 EXIV2API ExifData::const_iterator afPoint(const ExifData& ed);
 
+/*!
+  @brief Results of all easy access functions for one %Exif metadata container.
+         Each member holds the iterator the function of the same name returns.
+ */
+struct EXIV2API EasyAccessData {
+  ExifData::const_iterator orientation;        //!< Result of orientation()
+  ExifData::const_iterator isoSpeed;           //!< Result of isoSpeed()
+  ExifData::const_iterator dateTimeOriginal;   //!< Result of dateTimeOriginal()
+  ExifData::const_iterator flashBias;          //!< Result of flashBias()
+  ExifData::const_iterator exposureMode;       //!< Result of exposureMode()
+  ExifData::const_iterator sceneMode;          //!< Result of sceneMode()
+  ExifData::const_iterator macroMode;          //!< Result of macroMode()
+  ExifData::const_iterator imageQuality;       //!< Result of imageQuality()
+  ExifData::const_iterator whiteBalance;       //!< Result of whiteBalance()
+  ExifData::const_iterator lensName;           //!< Result of lensName()
+  ExifData::const_iterator saturation;         //!< Result of saturation()
+  ExifData::const_iterator sharpness;          //!< Result of sharpness()
+  ExifData::const_iterator contrast;           //!< Result of contrast()
+  ExifData::const_iterator sceneCaptureType;   //!< Result of sceneCaptureType()
+  ExifData::const_iterator meteringMode;       //!< Result of meteringMode()
+  ExifData::const_iterator make;               //!< Result of make()
+  ExifData::const_iterator model;              //!< Result of model()
+  ExifData::const_iterator exposureTime;       //!< Result of exposureTime()
+  ExifData::const_iterator fNumber;            //!< Result of fNumber()
+  ExifData::const_iterator shutterSpeedValue;  //!< Result of shutterSpeedValue()
+  ExifData::const_iterator apertureValue;      //!< Result of apertureValue()
+  ExifData::const_iterator brightnessValue;    //!< Result of brightnessValue()
+  ExifData::const_iterator exposureBiasValue;  //!< Result of exposureBiasValue()
+  ExifData::const_iterator maxApertureValue;   //!< Result of maxApertureValue()
+  ExifData::const_iterator subjectDistance;    //!< Result of subjectDistance()
+  ExifData::const_iterator lightSource;        //!< Result of lightSource()
+  ExifData::const_iterator flash;              //!< Result of flash()
+  ExifData::const_iterator serialNumber;       //!< Result of serialNumber()
+  ExifData::const_iterator focalLength;        //!< Result of focalLength()
+  ExifData::const_iterator subjectArea;        //!< Result of subjectArea()
+  ExifData::const_iterator flashEnergy;        //!< Result of flashEnergy()
+  ExifData::const_iterator exposureIndex;      //!< Result of exposureIndex()
+  ExifData::const_iterator sensingMethod;      //!< Result of sensingMethod()
+  ExifData::const_iterator afPoint;            //!< Result of afPoint()
+};
+
+/*!
+  @brief Resolve all easy access fields of \em ed at once. The container is
+         indexed in a single pass and the candidate keys of every field are then
+         looked up in the index, which is much cheaper than calling the easy
+         access functions one by one. The results are the same as those of the
+         individual functions.
+ */
+EXIV2API EasyAccessData easyAccess(const ExifData& ed);
+
 }  // namespace Exiv2
 
 #endif  // EXIV2_EASYACCESS_HPP
@@ -19,6 +19,7 @@
 
 // + standard includes
 #include <list>
+#include <utility>
 
 // *****************************************************************************
 // namespace extensions
@@ -256,6 +257,22 @@ class EXIV2API ExifThumbC {
   [[nodiscard]] const char* extension() const;
   //@}
 
+  /*!
+    @brief Find the JPEG thumbnail in the TIFF structure \em pData, \em size
+           without decoding the %Exif data.
+
+    Only the TIFF header, the pointer from IFD0 to IFD1 and the entries of
+    IFD1 are read. The thumbnail is found if IFD1 has the JPEGInterchangeFormat
+    and JPEGInterchangeFormatLength tags as single values, the Compression tag,
+    if present, is 6 (JPEG) and the thumbnail lies within the data. It is
+    then the same as that returned by copy() after the data is decoded.
+
+    @return Offset and size of the thumbnail in \em pData. The size is 0 if
+           the thumbnail is not found, e.g., because it is in TIFF format or
+           the structure is unusual; decode the data and use copy() then.
+   */
+  static std::pair<size_t, size_t> findJpeg(const byte* pData, size_t size);
+
  private:
   // DATA
   const ExifData& exifData_;  //!< Const reference to the Exif metadata.
@@ -366,6 +383,17 @@ class EXIV2API ExifThumb : public ExifThumbC {
 //! Container type to hold all metadata
 using ExifMetadata = std::list<Exifdatum>;
 
+/*!
+  @brief How the makernote is handled when Exif data is decoded, see
+         ExifParser::decode() and Image::setMakerNotePolicy().
+ */
+enum class MakerNotePolicy {
+  none,     //!< Skip the makernote: it is neither decoded nor kept
+  rawBlob,  //!< Keep the makernote as the undecoded Exif.Photo.MakerNote tag
+  lazy,     //!< As rawBlob, decode it on the first lookup of a makernote key with findKey()
+  full,     //!< Decode the makernote while decoding the Exif data
+};
+
 /*!
   @brief A container for Exif data.  This is a top-level class of the %Exiv2
          library. The container holds Exifdatum objects.
@@ -444,8 +472,21 @@ class EXIV2API ExifData {
   /*!
     @brief Find the first Exifdatum with the given \em key, return an
            iterator to it.
+
+    If the makernote was read with MakerNotePolicy::lazy and is still
+    pending, looking up a makernote key decodes it first.
    */
   iterator findKey(const ExifKey& key);
+  /*!
+    @brief Decode a makernote which was not decoded with the rest of the
+           Exif data and insert its tags after the Exif.Photo.MakerNote tag.
+           Makernote tags which were set while the makernote was pending are
+           kept and not duplicated. Does nothing if there is no pending
+           makernote.
+
+    Existing iterators remain valid.
+   */
+  void decodeMakerNote();
   //@}
 
   //! @name Accessors
@@ -461,6 +502,12 @@ class EXIV2API ExifData {
   /*!
     @brief Find the first Exifdatum with the given \em key, return a const
            iterator to it.
+
+    As the non-const findKey(), this decodes a makernote which was read
+    with MakerNotePolicy::lazy on the lookup of a makernote key. The
+    container is modified then, so it must not be shared between threads
+    while such a makernote is pending. Iterating over the container does
+    not decode the makernote, call decodeMakerNote() first for that.
    */
   [[nodiscard]] const_iterator findKey(const ExifKey& key) const;
   //! Return true if there is no Exif metadata
@@ -471,11 +518,17 @@ class EXIV2API ExifData {
   [[nodiscard]] size_t count() const {
     return exifMetadata_.size();
   }
+  /*!
+    @brief Return true if the makernote was read with MakerNotePolicy::rawBlob
+           or MakerNotePolicy::lazy and has not been decoded yet, see
+           decodeMakerNote().
+   */
+  [[nodiscard]] bool makerNotePending() const;
   //@}
 
  private:
   // DATA
-  ExifMetadata exifMetadata_;
+  mutable ExifMetadata exifMetadata_;  //!< Mutable for the lazy makernote decoding of findKey() const
 };  // class ExifData
 
 /*!
@@ -497,9 +550,13 @@ class EXIV2API ExifParser {
     @param pData 	  Pointer to the data buffer. Must point to data in
                     binary Exif format; no checks are performed.
     @param size 	  Length of the data buffer
+    @param mnPolicy How to handle the makernote. With MakerNotePolicy::rawBlob
+                    and MakerNotePolicy::lazy, the Exif.Photo.MakerNote tag
+                    keeps what is needed to decode the makernote later.
     @return Byte order in which the data is encoded.
   */
-  static ByteOrder decode(ExifData& exifData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, const byte* pData, size_t size,
+                          MakerNotePolicy mnPolicy = MakerNotePolicy::full);
   /*!
     @brief Encode Exif metadata from the provided metadata to binary Exif
            format.
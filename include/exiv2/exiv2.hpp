@@ -26,6 +26,7 @@
 #include "exiv2/iptc.hpp"
 #include "exiv2/jp2image.hpp"
 #include "exiv2/jpgimage.hpp"
+#include "exiv2/metadatacache.hpp"
 #include "exiv2/metadatum.hpp"
 #include "exiv2/mrwimage.hpp"
 #include "exiv2/orfimage.hpp"
@@ -41,6 +42,9 @@
 #include "exiv2/psdimage.hpp"
 #include "exiv2/rafimage.hpp"
 #include "exiv2/rw2image.hpp"
+#include "exiv2/scanner.hpp"
+#include "exiv2/serializer.hpp"
+#include "exiv2/stats.hpp"
 
 #include "exiv2/tags.hpp"
 #include "exiv2/tgaimage.hpp"
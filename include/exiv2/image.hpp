@@ -90,6 +90,26 @@ class EXIV2API Image {
         type).
    */
   virtual void readMetadata() = 0;
+  /*!
+    @brief Read the JPEG %Exif thumbnail of the image, without reading the
+        metadata.
+
+    Formats which support it locate the thumbnail through IFD1 of the raw
+    %Exif data, see ExifThumbC::findJpeg(), which is much faster than
+    decoding all of the %Exif data and its makernote. The metadata of the
+    image is neither read nor changed.
+
+    The fast path is supported by JPEG, EXV and TIFF images (not by the
+    RAW formats with their own image class). For other formats, and if the
+    thumbnail cannot be found this way, e.g., because it is in TIFF
+    format, the returned buffer is empty: read the metadata and use
+    ExifThumbC to get the thumbnail then.
+
+    @return A copy of the thumbnail, empty if it was not found
+    @throw Error if opening or reading of the file fails or the image
+        data is not valid
+   */
+  DataBuf readExifThumbnail();
   /*!
     @brief Write metadata back to the image.
 
@@ -300,6 +320,71 @@ class EXIV2API Image {
     little-endian byte order (II) is used by default.
    */
   void setByteOrder(ByteOrder byteOrder);
+  /*!
+    @brief Select the metadata decoded by readMetadata().
+
+    Metadata which is not selected is skipped while reading the image and
+    its container is left empty, so callers which only need some of the
+    metadata avoid the cost of decoding the rest. The selection is a hint:
+    formats which store other metadata inside their %Exif structure (e.g.,
+    TIFF) always decode the %Exif data, and formats which do not support
+    the selection decode all metadata. The default is to decode all
+    metadata.
+
+    Do not write an image which was read with a restricted selection:
+    the metadata which was skipped would be removed from the image.
+
+    @param metadataIds Bitmask of MetadataId values to decode.
+   */
+  void setReadFilter(uint16_t metadataIds);
+  /*!
+    @brief Set how readMetadata() handles the %Exif makernote.
+
+    Decoding the makernote, with all its binary arrays, is often the bulk
+    of the cost of reading an image. With MakerNotePolicy::rawBlob the
+    makernote is kept as the binary Exif.Photo.MakerNote tag, with
+    MakerNotePolicy::lazy it is additionally decoded on the first lookup
+    of a makernote key with ExifData::findKey(), see
+    ExifData::decodeMakerNote(). Both policies keep a reference to the
+    %Exif data to decode the makernote from: a TIFF file is read again,
+    for other images a copy of their %Exif data is kept. writeMetadata()
+    writes a makernote which was not decoded unchanged, unless it has to
+    move, in which case it is decoded first.
+    MakerNotePolicy::none skips the makernote entirely;
+    do not write an image which was read with this policy. The default is
+    MakerNotePolicy::full.
+
+    The policy is honoured by JPEG, TIFF (including the RAW formats read
+    by TiffImage), PNG, WebP, PSD and JPEG 2000 images. Other formats
+    always decode the makernote.
+   */
+  void setMakerNotePolicy(MakerNotePolicy mnPolicy);
+  /*!
+    @brief Stop readMetadata() at the start of the image data.
+
+    Some formats allow metadata after the image data, e.g., the text
+    chunks of PNG images. Finding it means walking the whole image, which
+    is slow for PNG images with many small IDAT chunks. When set, metadata
+    stored after the image data is not read. writeMetadata() throws if the
+    last read stopped at the image data, as it would remove the metadata
+    which was skipped from the image. The default is false.
+
+    The option is honoured by PNG images. Other formats ignore it.
+   */
+  void setStopAtImageData(bool stop);
+  /*!
+    @brief Set the compression level of the metadata written by
+        writeMetadata(), from 0 (no compression) over 1 (fast) to 9
+        (best). The default, -1, keeps the levels of the format.
+
+    The level is honoured by PNG images for the zlib compressed chunks:
+    the comment, the IPTC profile and the ICC profile. By default, PNG
+    text chunks are compressed with level 9 and the ICC profile with the
+    zlib default level. Other formats ignore the level.
+
+    @throw Error if \em level is out of range.
+   */
+  void setCompressionLevel(int level);
 
   /*!
     @brief Print out the structure of image file.
@@ -448,6 +533,14 @@ class EXIV2API Image {
   [[deprecated]] [[nodiscard]] bool supportsMetadata(MetadataId metadataId) const;
   //! Return the flag indicating the source when writing XMP metadata.
   [[nodiscard]] bool writeXmpFromPacket() const;
+  //! Return the bitmask of MetadataId values decoded by readMetadata().
+  [[nodiscard]] uint16_t readFilter() const;
+  //! Return how readMetadata() handles the %Exif makernote.
+  [[nodiscard]] MakerNotePolicy makerNotePolicy() const;
+  //! Return true if readMetadata() stops at the start of the image data.
+  [[nodiscard]] bool stopAtImageData() const;
+  //! Return the compression level of the metadata written by writeMetadata(), see setCompressionLevel().
+  [[nodiscard]] int compressionLevel() const;
   //! Return list of native previews. This is meant to be used only by the PreviewManager.
   [[nodiscard]] const NativePreviewList& nativePreviews() const;
   //@}
@@ -490,6 +583,11 @@ class EXIV2API Image {
   //! Return tag type for given tag id.
   static const char* typeName(uint16_t tag);
 
+  //! Record whether readMetadata() stopped at the image data, see setStopAtImageData()
+  void setStoppedAtImageData(bool stopped);
+  //! Return true if the last readMetadata() stopped at the image data
+  [[nodiscard]] bool stoppedAtImageData() const;
+
  private:
   // DATA
   ImageType imageType_;         //!< Image type
@@ -504,6 +602,10 @@ class EXIV2API Image {
   std::map<int, std::string> tags_;  //!< Map of tags
   bool init_{true};                  //!< Flag marking if map of tags needs to be initialized
 
+  // Pimpl idiom, last so that the offsets of the members above stay unchanged
+  class Impl;
+  std::unique_ptr<Impl> p_;  //!< Options of readMetadata() and writeMetadata()
+
 };  // class Image
 
 //! Type for function pointer that creates new Image instances
@@ -552,6 +654,13 @@ class EXIV2API ImageFactory {
         unknown image type.
    */
   static Image::UniquePtr open(const std::string& path, bool useCurl = true);
+  /*!
+    @brief Like open(const std::string&, bool), but read the file through a
+        TracingIo if \em traceIo is true. The TracingIo records the calls from
+        the type detection on; get it with dynamic_cast<TracingIo&>(image->io())
+        to inspect its events() or summary().
+   */
+  static Image::UniquePtr open(const std::string& path, bool useCurl, bool traceIo);
 #ifdef _WIN32
   static Image::UniquePtr open(const std::wstring& path);
 #endif
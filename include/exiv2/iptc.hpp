@@ -193,6 +193,12 @@ class EXIV2API IptcData {
            by this call.
    */
   iterator erase(iterator pos);
+  /*!
+    @brief Delete all Iptcdatum instances with the given key in one pass,
+           return the number of deleted instances. Note that iterators into
+           the metadata are potentially invalidated by this call.
+   */
+  size_t eraseKey(const IptcKey& key);
   /*!
     @brief Delete all Iptcdatum instances resulting in an empty container.
    */
@@ -23,6 +23,8 @@ class EXIV2API JpegBase : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  //! Read the JPEG %Exif thumbnail of the image, see Image::readExifThumbnail()
+  DataBuf readExifThumbnail();
   void writeMetadata() override;
   void printStructure(std::ostream& out, PrintStructureOption option, size_t depth) override;
   //@}
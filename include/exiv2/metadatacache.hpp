@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef EXIV2_METADATACACHE_HPP
+#define EXIV2_METADATACACHE_HPP
+
+#include "exiv2lib_export.h"
+
+#include "config.h"
+
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <memory>
+#include <string>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+// *****************************************************************************
+// class declarations
+class Image;
+
+// *****************************************************************************
+// class definitions
+/*!
+  @brief Persistent cache of the metadata of image files.
+
+  The cache is a single append-only file. Each entry holds the Exif, IPTC
+  and XMP metadata, the XMP packet and the comment of an image file, the
+  containers serialized with MetadataSerializer. An entry is keyed by the
+  path of the file and stamped with the identity of the file: device,
+  inode, size and modification time. It is only used while the identity
+  matches; a changed file is read again and its new entry is appended,
+  superseding the old one.
+
+  The file is memory-mapped for reading. Every entry carries a checksum, so
+  several processes may read the cache while one process appends to it:
+  readers skip damaged entries and stop at an incomplete one. Within a
+  process, the methods of one instance may be called from several threads.
+ */
+class EXIV2API MetadataCache {
+ public:
+  //! @name Creators
+  //@{
+  /*!
+    @brief Open the cache file \em path, create it if it does not exist.
+        A cache of another format version is replaced.
+    @throw Error if the file cannot be opened or created, or is not a cache
+   */
+  explicit MetadataCache(const std::string& path);
+  //! Destructor
+  ~MetadataCache();
+  //@}
+
+  MetadataCache(const MetadataCache&) = delete;
+  MetadataCache& operator=(const MetadataCache&) = delete;
+
+  //! @name Manipulators
+  //@{
+  /*!
+    @brief Fill the metadata of \em image from the cache if it has an entry
+        for the file of the image which matches the identity of the file.
+    @return true if the metadata was taken from the cache, false if it has
+        to be read from the file
+   */
+  bool read(Image& image);
+  /*!
+    @brief Store the metadata of \em image as the entry of the file of the
+        image. Images which are not files and metadata which cannot be
+        serialized, e.g., XMP values of an unsupported type, are ignored.
+    @throw Error if the cache file cannot be written
+   */
+  void write(const Image& image);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the path of the cache file
+  [[nodiscard]] const std::string& path() const;
+  //! Return the number of files with an entry
+  [[nodiscard]] size_t size() const;
+  //@}
+
+ private:
+  // Pimpl idiom
+  class Impl;
+  std::unique_ptr<Impl> p_;
+};
+
+}  // namespace Exiv2
+
+#endif  // EXV_ENABLE_FILESYSTEM
+
+#endif  // EXIV2_METADATACACHE_HPP
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef EXIV2_SCANNER_HPP
+#define EXIV2_SCANNER_HPP
+
+#include "exiv2lib_export.h"
+
+#include "error.hpp"
+#include "image.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+class MetadataCache;
+
+//! Order in which a MetadataScanner passes its results to the callback
+enum class ScanOrder {
+  completion,  //!< As soon as a file is done
+  input,       //!< In the order of the input paths
+};
+
+//! Settings of a MetadataScanner
+struct ScanOptions {
+  size_t threads_{0};                                       //!< Number of worker threads, 0 for one per hardware thread
+  size_t maxPending_{0};                                    //!< Maximum number of images held, 0 for two per thread
+  ScanOrder order_{ScanOrder::completion};                  //!< Order of the results
+  MakerNotePolicy makerNotePolicy_{MakerNotePolicy::full};  //!< Makernote handling of readMetadata()
+  size_t prefetchSize_{0};                                  //!< Number of bytes read ahead per file, 0 for none
+  MetadataCache* cache_{nullptr};                           //!< Cache of the metadata of the files, nullptr for none
+};
+
+//! Outcome of scanning one file
+struct ScanResult {
+  //! Return true if the file was scanned without an error
+  [[nodiscard]] bool ok() const {
+    return errorCode_ == ErrorCode::kerSuccess;
+  }
+
+  size_t index_{0};                             //!< Position of the file in the input
+  std::string path_;                            //!< Path of the file
+  Image::UniquePtr image_;                      //!< The image with its metadata, nullptr if it could not be read
+  ErrorCode errorCode_{ErrorCode::kerSuccess};  //!< Code of the error, kerErrorMessage if it is not an Exiv2 error
+  std::string error_;                           //!< Message of the error, empty if the file was scanned successfully
+};
+
+/*!
+  @brief Read (and optionally modify and write) the metadata of many files
+      on a pool of worker threads.
+
+  Each file is opened with ImageFactory::open(), which detects its type, and
+  its metadata is read. If a modifier is set, it is called with the image and
+  the metadata is written back. An error in one file is reported in its
+  ScanResult and does not stop the batch.
+
+  Results are passed to the callback on the thread which called scan(), one
+  at a time, so the callback does not need to synchronize. To bound the
+  memory use, workers do not start on another file while
+  ScanOptions::maxPending_ files are in progress or waiting for the callback.
+  Workers live for the whole batch and so reuse their thread-local scratch
+  buffers from one file to the next. The memory blocks kept for reuse by
+  MemIo, see MemIo::releasePool(), are freed at the end of scan().
+
+  If ScanOptions::prefetchSize_ is set, as many I/O threads as workers read
+  the start of upcoming local files into memory with FileIo::prefetch(), so
+  that reading overlaps with parsing. Files read ahead count as pending.
+  Files are only read ahead if the default FileIo backend, see
+  FileIo::setDefaultBackend(), is the positional one.
+
+  If ScanOptions::cache_ is set, the metadata of unchanged files is taken
+  from the cache instead of being read, and the metadata of the other files
+  is stored in it after reading. The cache is not used for files read with
+  MakerNotePolicy::none, as their entries differ in the makernote, nor if a
+  modifier is set, as the images are written from the metadata read from
+  the files.
+ */
+class EXIV2API MetadataScanner {
+ public:
+  //! Function which stores the next path in its argument, returns false at the end of the input
+  using Source = std::function<bool(std::string& path)>;
+  //! Function which modifies the metadata of an image before it is written
+  using Modifier = std::function<void(Image& image)>;
+  //! Function which receives the result of a file, it may take the image from it
+  using Callback = std::function<void(ScanResult& result)>;
+
+  //! @name Creators
+  //@{
+  //! Default constructor
+  MetadataScanner() = default;
+  //! Constructor with settings
+  explicit MetadataScanner(const ScanOptions& options);
+  //@}
+
+  //! @name Manipulators
+  //@{
+  //! Set the function to modify the metadata of each image; the images are written if one is set
+  void setModifier(Modifier modifier);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the settings
+  [[nodiscard]] const ScanOptions& options() const {
+    return options_;
+  }
+  /*!
+    @brief Scan the files \em paths and pass the result of each to \em callback.
+    @return Number of files which could not be scanned
+    @throw Any exception thrown by \em callback, after the workers stopped
+   */
+  size_t scan(const std::vector<std::string>& paths, const Callback& callback) const;
+  /*!
+    @brief Scan the files returned by \em next and pass the result of each
+        to \em callback. \em next is called by one thread at a time.
+    @return Number of files which could not be scanned
+    @throw Any exception thrown by \em next or \em callback, after the workers stopped
+   */
+  size_t scan(const Source& next, const Callback& callback) const;
+  //@}
+
+ private:
+  ScanOptions options_;  //!< Settings
+  Modifier modifier_;    //!< Modifier of the metadata, empty to only read
+};
+
+}  // namespace Exiv2
+
+#endif  // EXIV2_SCANNER_HPP
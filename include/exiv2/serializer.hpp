@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef EXIV2_SERIALIZER_HPP
+#define EXIV2_SERIALIZER_HPP
+
+#include "exiv2lib_export.h"
+
+#include "exif.hpp"
+#include "iptc.hpp"
+#include "tags.hpp"
+#include "value.hpp"
+#include "xmp_exiv2.hpp"
+
+#include <string_view>
+#include <vector>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+// *****************************************************************************
+// class definitions
+/*!
+  @brief Read-only view of metadata serialized by MetadataSerializer::encode().
+
+  The constructor checks the serialized data and indexes its entries. The
+  entries refer to the serialized data, which must outlive the view: values
+  are neither copied nor converted until value() is called. Use the view to
+  look at a few entries without decoding all of them.
+ */
+class EXIV2API MetadataView {
+ public:
+  //! An %Exif metadatum in the serialized data
+  struct EXIV2API ExifEntry {
+    IfdId ifdId_;           //!< IFD id of the group
+    uint16_t tag_;          //!< Tag number
+    int idx_;               //!< Index of the tag within the original Exif data
+    TypeId typeId_;         //!< Type of the value, comment for a CommentValue
+    ByteOrder byteOrder_;   //!< Byte order of the value
+    const byte* data_;      //!< Value, as written by Value::copy()
+    size_t size_;           //!< Size of the value
+    const byte* dataArea_;  //!< Data area of the value, see Value::dataArea()
+    size_t sizeDataArea_;   //!< Size of the data area
+
+    //! Return the key of the metadatum
+    [[nodiscard]] ExifKey key() const;
+    //! Return a copy of the value
+    [[nodiscard]] Value::UniquePtr value() const;
+  };
+
+  //! An IPTC dataset in the serialized data
+  struct EXIV2API IptcEntry {
+    uint16_t record_;   //!< Record id
+    uint16_t dataset_;  //!< Dataset number
+    TypeId typeId_;     //!< Type of the value
+    const byte* data_;  //!< Value, as written by Value::copy() in big endian byte order
+    size_t size_;       //!< Size of the value
+
+    //! Return the key of the dataset
+    [[nodiscard]] IptcKey key() const;
+    //! Return a copy of the value
+    [[nodiscard]] Value::UniquePtr value() const;
+  };
+
+  //! An XMP property in the serialized data
+  struct EXIV2API XmpEntry {
+    std::string_view prefix_;           //!< Namespace prefix when the data was serialized
+    std::string_view ns_;               //!< Namespace URI
+    std::string_view property_;         //!< Property path, the third part of the key
+    TypeId typeId_;                     //!< Type of the value
+    XmpValue::XmpArrayType arrayType_;  //!< Array type of the value
+    XmpValue::XmpStruct struct_;        //!< Structure indicator of the value
+    size_t count_;                      //!< Number of items of the value
+    const byte* data_;                  //!< Items of the value
+    size_t size_;                       //!< Size of the items
+
+    /*!
+      @brief Return the key of the property. The namespace is registered
+          if it is not known yet; if it is known with another prefix,
+          that prefix is used.
+     */
+    [[nodiscard]] XmpKey key() const;
+    //! Return a copy of the value
+    [[nodiscard]] Value::UniquePtr value() const;
+  };
+
+  //! @name Creators
+  //@{
+  /*!
+    @brief Index the metadata serialized in \em pData, \em size.
+    @throw Error if the data is not serialized metadata of a supported
+        format version, or is truncated
+   */
+  MetadataView(const byte* pData, size_t size);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the byte order of the %Exif values
+  [[nodiscard]] ByteOrder byteOrder() const {
+    return byteOrder_;
+  }
+  //! Return the %Exif metadata in their original order
+  [[nodiscard]] const std::vector<ExifEntry>& exifData() const {
+    return exifData_;
+  }
+  //! Return the IPTC datasets in their original order
+  [[nodiscard]] const std::vector<IptcEntry>& iptcData() const {
+    return iptcData_;
+  }
+  //! Return the XMP properties in their original order
+  [[nodiscard]] const std::vector<XmpEntry>& xmpData() const {
+    return xmpData_;
+  }
+  //@}
+
+ private:
+  // DATA
+  ByteOrder byteOrder_{invalidByteOrder};  //!< Byte order of the Exif values
+  std::vector<ExifEntry> exifData_;        //!< Exif metadata
+  std::vector<IptcEntry> iptcData_;        //!< IPTC datasets
+  std::vector<XmpEntry> xmpData_;          //!< XMP properties
+};  // class MetadataView
+
+/*!
+  @brief Stateless class to serialize metadata containers to a compact,
+         versioned binary format and back.
+
+  Unlike the EXV, Exif or XMP encoders, serialization is not lossy and does
+  not depend on the layout of the metadata in a file: decode() restores the
+  containers as they were passed to encode(), in the same order. %Exif tags
+  and IPTC datasets are stored by their numeric ids and the raw bytes of
+  their values, XMP properties by an index into a table of namespaces, the
+  property path and the items of their values. Use it to cache metadata or
+  to pass it between processes; it is not meant as a file format.
+ */
+class EXIV2API MetadataSerializer {
+ public:
+  /*!
+    @brief Serialize the metadata of the containers and append the result
+           to \em blob.
+
+    A pending makernote of \em exifData is decoded into a copy of the
+    container first, as by the %Exif encoders.
+
+    @param blob      Container the serialized metadata is appended to
+    @param exifData  %Exif metadata container
+    @param iptcData  IPTC metadata container
+    @param xmpData   XMP metadata container
+    @param byteOrder Byte order of the %Exif values, e.g., that of the image
+    @throw Error if an XMP value is not supported by the XMP encoder either
+   */
+  static void encode(Blob& blob, const ExifData& exifData, const IptcData& iptcData, const XmpData& xmpData,
+                     ByteOrder byteOrder = littleEndian);
+  /*!
+    @brief Replace the metadata of the containers with that serialized in
+           \em pData, \em size. Unknown XMP namespaces are registered.
+
+    @return Byte order of the %Exif values
+    @throw Error if the data is not serialized metadata, see MetadataView
+   */
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+};  // class MetadataSerializer
+
+}  // namespace Exiv2
+
+#endif  // EXIV2_SERIALIZER_HPP
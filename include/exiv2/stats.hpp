@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef EXIV2_STATS_HPP
+#define EXIV2_STATS_HPP
+
+#include "exiv2lib_export.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+//! Phases of reading and writing metadata which are timed
+enum class StatsPhase {
+  typeDetection,    //!< Image type detection in the ImageFactory
+  segmentScan,      //!< Scan of the segments, chunks or boxes of an image
+  tiffParse,        //!< Parse and decode of a TIFF structure
+  makerNoteDecode,  //!< Traversal of a makernote IFD
+  xmpParse,         //!< Parse of an XMP packet
+  encode,           //!< Encode of a TIFF structure or an XMP packet
+  transfer,         //!< Transfer of a temporary result to the original IO
+};
+
+//! Number of phases in @ref StatsPhase
+inline constexpr size_t statsPhaseCount = 7;
+
+//! Number of times a phase was entered and the time spent in it
+struct PhaseStats {
+  uint64_t calls_{0};                //!< Number of (outermost) calls
+  std::chrono::nanoseconds time_{};  //!< Total time spent in the phase
+};
+
+/*!
+  @brief Timing and I/O counters of the calling thread.
+
+  The counters are only updated if the library is built with
+  EXIV2_ENABLE_STATS, see statsEnabled(). Phase timings are inclusive: the
+  time of a phase contains that of the phases nested in it, a phase nested
+  in itself is counted once. The I/O counters cover all FileIo and MemIo
+  instances used by the thread.
+ */
+struct EXIV2API Stats {
+  //! Return the counters of \em phase
+  PhaseStats& phase(StatsPhase phase) {
+    return phases_.at(static_cast<size_t>(phase));
+  }
+  //! Return the counters of \em phase
+  [[nodiscard]] const PhaseStats& phase(StatsPhase phase) const {
+    return phases_.at(static_cast<size_t>(phase));
+  }
+  //! Set all counters to zero
+  void reset();
+
+  std::array<PhaseStats, statsPhaseCount> phases_{};  //!< Counters per phase
+  uint64_t reads_{0};                                 //!< Number of read and getb calls
+  uint64_t bytesRead_{0};                             //!< Number of bytes read
+  uint64_t writes_{0};                                //!< Number of write and putb calls
+  uint64_t bytesWritten_{0};                          //!< Number of bytes written
+  uint64_t seeks_{0};                                 //!< Number of seek calls
+  uint64_t mmaps_{0};                                 //!< Number of mmap calls
+};
+
+// *********************************************************************
+// free functions
+//! Return true if the library was built with timing and I/O counters
+EXIV2API bool statsEnabled();
+
+//! Return the counters of the calling thread
+EXIV2API Stats& threadStats();
+
+//! Return the name of \em phase, e.g. "tiffParse"
+EXIV2API const char* statsPhaseName(StatsPhase phase);
+
+}  // namespace Exiv2
+
+#endif  // EXIV2_STATS_HPP
@@ -9,6 +9,8 @@
 // included header files
 #include "metadatum.hpp"
 
+#include <functional>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
@@ -294,6 +296,16 @@ class EXIV2API ExifKey : public Key {
            and group name.
    */
   ExifKey(uint16_t tag, const std::string& groupName);
+  /*!
+    @brief Constructor to create an Exif key from the tag number and
+           IFD id. Unlike the constructors above, no strings are parsed
+           or built; the key string is only formatted when requested.
+    @param tag The tag value
+    @param ifdId The IFD id of the group
+    @throw Error if the key cannot be constructed from the tag number
+           and IFD id.
+   */
+  ExifKey(uint16_t tag, IfdId ifdId);
   /*!
     @brief Constructor to create an Exif key from a TagInfo instance.
     @param ti The TagInfo instance
@@ -353,6 +365,17 @@ class EXIV2API ExifKey : public Key {
 //! Output operator for TagInfo
 EXIV2API std::ostream& operator<<(std::ostream& os, const TagInfo& ti);
 
+//! Compare two %Exif keys by their (IfdId, tag) identity, without formatting the key strings
+EXIV2API bool operator==(const ExifKey& lhs, const ExifKey& rhs);
+
 }  // namespace Exiv2
 
+//! Hash an %Exif key by its (IfdId, tag) identity, consistent with operator==
+template <>
+struct std::hash<Exiv2::ExifKey> {
+  size_t operator()(const Exiv2::ExifKey& key) const noexcept {
+    return std::hash<uint64_t>()((static_cast<uint64_t>(key.ifdId()) << 16) | key.tag());
+  }
+};
+
 #endif  // EXIV2_TAGS_HPP
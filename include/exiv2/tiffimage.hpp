@@ -45,6 +45,8 @@ class EXIV2API TiffImage : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  //! Read the JPEG %Exif thumbnail of the image, see Image::readExifThumbnail()
+  DataBuf readExifThumbnail();
   void writeMetadata() override;
 
   /*!
@@ -101,10 +103,12 @@ class EXIV2API TiffParser {
     @param pData    Pointer to the data buffer. Must point to data in TIFF
                     format; no checks are performed.
     @param size     Length of the data buffer.
+    @param mnPolicy How to handle the makernote, see ExifParser::decode().
 
     @return Byte order in which the data is encoded.
   */
-  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                          MakerNotePolicy mnPolicy = MakerNotePolicy::full);
   /*!
     @brief Encode metadata from the provided metadata to TIFF format.
 
@@ -303,6 +303,15 @@ EXIV2API size_t f2Data(byte* buf, float f, ByteOrder byteOrder);
  */
 EXIV2API size_t d2Data(byte* buf, double d, ByteOrder byteOrder);
 
+/*!
+  @brief Copy \em count values of \em size bytes each (2, 4 or 8) from the
+         data buffer \em src to \em dst, converting them between byte order
+         \em byteOrder and the byte order of the platform. This is the bulk
+         equivalent of getULong(), ul2Data() and the like, for arrays of
+         values. The buffers may be the same, but must not overlap otherwise.
+ */
+EXIV2API void convertByteOrder(byte* dst, const byte* src, size_t count, size_t size, ByteOrder byteOrder);
+
 /*!
   @brief Print len bytes from buf in hex and ASCII format to the given
          stream, prefixed with the position in the buffer adjusted by
@@ -15,6 +15,7 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <type_traits>
 
 // *****************************************************************************
 // namespace extensions
@@ -1429,6 +1430,20 @@ inline size_t toData(byte* buf, double t, ByteOrder byteOrder) {
   return d2Data(buf, t, byteOrder);
 }
 
+/*!
+  @brief Size of the numbers a value of type T consists of, if ValueType<T>
+         converts arrays of such values with convertByteOrder(); 0 otherwise.
+ */
+template <typename T>
+constexpr size_t bulkValueSize() {
+  if constexpr (std::is_arithmetic_v<T>)
+    return sizeof(T);
+  else if constexpr (std::is_same_v<T, URational> || std::is_same_v<T, Rational>)
+    return sizeof(typename T::first_type);
+  else
+    return 0;
+}
+
 template <typename T>
 ValueType<T>::ValueType() : Value(getType<T>()) {
 }
@@ -1469,6 +1484,24 @@ int ValueType<T>::read(const byte* buf, size_t len, ByteOrder byteOrder) {
   size_t ts = TypeInfo::typeSize(typeId());
   if (ts > 0 && len % ts != 0)
     len = (len / ts) * ts;
+  if constexpr (constexpr size_t size = bulkValueSize<T>(); size > 0) {
+    if (ts == sizeof(T)) {
+      if constexpr (std::is_arithmetic_v<T>) {
+        value_.resize(len / ts);
+        convertByteOrder(reinterpret_cast<byte*>(value_.data()), buf, len / size, size, byteOrder);
+      } else {
+        // A rational is not trivially copyable, convert its numbers and pair them up
+        std::vector<typename T::first_type> numbers(len / size);
+        convertByteOrder(reinterpret_cast<byte*>(numbers.data()), buf, numbers.size(), size, byteOrder);
+        value_.reserve(len / ts);
+        for (size_t i = 0; i < numbers.size(); i += 2)
+          value_.emplace_back(numbers[i], numbers[i + 1]);
+      }
+      return 0;
+    }
+  }
+  if (ts > 0)
+    value_.reserve(len / ts);
   for (size_t i = 0; i < len; i += ts) {
     value_.push_back(getValue<T>(buf + i, byteOrder));
   }
@@ -1490,6 +1523,23 @@ int ValueType<T>::read(const std::string& buf) {
 
 template <typename T>
 size_t ValueType<T>::copy(byte* buf, ByteOrder byteOrder) const {
+  if constexpr (constexpr size_t size = bulkValueSize<T>(); size > 0) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      const size_t len = value_.size() * sizeof(T);
+      convertByteOrder(buf, reinterpret_cast<const byte*>(value_.data()), len / size, size, byteOrder);
+      return len;
+    } else {
+      // A rational is not trivially copyable, copy its numbers and convert them in place
+      byte* p = buf;
+      for (const auto& [first, second] : value_) {
+        std::memcpy(p, &first, size);
+        std::memcpy(p + size, &second, size);
+        p += 2 * size;
+      }
+      convertByteOrder(buf, buf, 2 * value_.size(), size, byteOrder);
+      return 2 * value_.size() * size;
+    }
+  }
   size_t offset = 0;
   for (const auto& val : value_) {
     offset += toData(buf + offset, val, byteOrder);
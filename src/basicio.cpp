@@ -9,15 +9,19 @@
 #include "futils.hpp"
 #include "http.hpp"
 #include "image_int.hpp"
+#include "stats_int.hpp"
 #include "types.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cstdio>   // for remove, rename
 #include <cstdlib>  // for alloc, realloc, free
 #include <cstring>  // std::memcpy
 #include <ctime>    // timestamp for the name of temporary file
 #include <fstream>  // write the temporary file
 #include <iostream>
+#include <vector>
 
 #if __has_include(<sys/mman.h>)
 #include <sys/mman.h>  // for mmap and munmap
@@ -44,6 +48,8 @@ namespace fs = std::filesystem;
 #endif
 
 #ifndef _WIN32
+#include <fcntl.h>     // open flags of the positional FileIo backend
+#include <sys/stat.h>  // fstat
 #define _fileno fileno
 #define _isatty isatty
 #endif
@@ -84,6 +90,22 @@ class FileIo::Impl {
   std::string openMode_;   //!< File open mode
   FILE* fp_{};             //!< File stream pointer
   OpMode opMode_{opSeek};  //!< File open mode
+  Backend backend_;        //!< Backend used to open the file
+
+  // Positional backend
+  static constexpr size_t minReadAhead = 4096;         //!< Read-ahead after a jump
+  static constexpr size_t maxReadAhead = 256 * 1024;  //!< Read-ahead limit of sequential reads
+  int fd_{-1};                                        //!< File descriptor
+  bool writable_{};                                   //!< fd_ allows writing
+  bool append_{};                                     //!< Writes go to the end of the file
+  bool eof_{};                                        //!< A read reached the end of the file
+  bool error_{};                                      //!< A read or write failed
+  size_t pos_{};                                      //!< IO position
+  std::vector<byte> buf_;                             //!< Read-ahead buffer
+  size_t bufOffset_{};                                //!< File offset of the read-ahead buffer
+  size_t bufSize_{};                                  //!< Number of valid bytes in the read-ahead buffer
+  size_t readAhead_{minReadAhead};                    //!< Current read-ahead size
+  std::vector<byte> head_;                            //!< Prefetched start of the file
 
 #ifdef _WIN32
   HANDLE hFile_{};  //!< Duplicated fd
@@ -109,12 +131,30 @@ class FileIo::Impl {
   int switchMode(OpMode opMode);
   //! stat wrapper for internal use
   int stat(StructStat& buf) const;
+  //! Return true if the file is open
+  [[nodiscard]] bool isOpen() const {
+    return fp_ || fd_ >= 0;
+  }
+  //! Return the file descriptor of the open file
+  [[nodiscard]] int descriptor() const {
+    return fp_ ? _fileno(fp_) : fd_;
+  }
+  //! Write with the backend of the open file, the caller switches the mode
+  size_t write(const byte* data, size_t wcount);
+#ifndef _WIN32
+  //! Open the file with the positional backend, \em mode is a mode of fopen
+  int openFd(const std::string& mode);
+  //! Read at the IO position of the positional backend, through the read-ahead buffer
+  size_t readFd(byte* buf, size_t rcount);
+  //! Read \em rcount bytes at \em offset unless the end of the file is reached, return -1 on failure
+  ssize_t pread(byte* buf, size_t rcount, size_t offset) const;
+#endif
   // NOT IMPLEMENTED
   Impl(const Impl&) = delete;             //!< Copy constructor
   Impl& operator=(const Impl&) = delete;  //!< Assignment
 };
 
-FileIo::Impl::Impl(std::string path) : path_(std::move(path)) {
+FileIo::Impl::Impl(std::string path) : path_(std::move(path)), backend_(Backend::stdio) {
 #ifdef _WIN32
   wchar_t t[512];
   const auto nw = MultiByteToWideChar(CP_UTF8, 0, path_.data(), static_cast<int>(path_.size()), t, 512);
@@ -122,7 +162,7 @@ FileIo::Impl::Impl(std::string path) : path_(std::move(path)) {
 #endif
 }
 #ifdef _WIN32
-FileIo::Impl::Impl(std::wstring path) : wpath_(std::move(path)) {
+FileIo::Impl::Impl(std::wstring path) : wpath_(std::move(path)), backend_(Backend::stdio) {
   char t[1024];
   const auto nc =
       WideCharToMultiByte(CP_UTF8, 0, wpath_.data(), static_cast<int>(wpath_.size()), t, 1024, nullptr, nullptr);
@@ -131,6 +171,24 @@ FileIo::Impl::Impl(std::wstring path) : wpath_(std::move(path)) {
 #endif
 
 int FileIo::Impl::switchMode(OpMode opMode) {
+  // The prefetched data may no longer match the file
+  if (opMode == opWrite)
+    head_ = {};
+#ifndef _WIN32
+  if (fd_ >= 0) {
+    // A file descriptor has no modes, it is only reopened to write to a read-only file
+    if (opMode != opWrite || writable_)
+      return 0;
+    ::close(fd_);
+    fd_ = -1;
+    const size_t pos = pos_;
+    if (openFd("r+b") != 0)
+      return 1;
+    openMode_ = "r+b";
+    pos_ = pos;
+    return 0;
+  }
+#endif
   if (opMode_ == opMode)
     return 0;
   OpMode oldOpMode = opMode_;
@@ -204,7 +262,137 @@ int FileIo::Impl::stat(StructStat& buf) const {
   }
 }  // FileIo::Impl::stat
 
-FileIo::FileIo(const std::string& path) : p_(std::make_unique<Impl>(path)) {
+size_t FileIo::Impl::write(const byte* data, size_t wcount) {
+#ifndef _WIN32
+  if (fd_ >= 0) {
+    // The read-ahead buffer may cover the written range
+    bufSize_ = 0;
+    if (append_) {
+      struct stat st {};
+      if (::fstat(fd_, &st) != 0) {
+        error_ = true;
+        return 0;
+      }
+      pos_ = static_cast<size_t>(st.st_size);
+    }
+    size_t writeCount = 0;
+    while (writeCount < wcount) {
+      const auto r = ::pwrite(fd_, data + writeCount, wcount - writeCount, static_cast<off_t>(pos_ + writeCount));
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r <= 0) {
+        error_ = true;
+        break;
+      }
+      writeCount += static_cast<size_t>(r);
+    }
+    pos_ += writeCount;
+    return writeCount;
+  }
+#endif
+  return std::fwrite(data, 1, wcount, fp_);
+}
+
+#ifndef _WIN32
+int FileIo::Impl::openFd(const std::string& mode) {
+  const bool update = mode.find('+') != std::string::npos;
+  int flags = update ? O_RDWR : O_WRONLY;
+  switch (mode.front()) {
+    case 'r':
+      flags = update ? O_RDWR : O_RDONLY;
+      break;
+    case 'w':
+      flags |= O_CREAT | O_TRUNC;
+      break;
+    case 'a':
+      flags |= O_CREAT;
+      break;
+    default:
+      errno = EINVAL;
+      return 1;
+  }
+  fd_ = ::open(path_.c_str(), flags, 0666);
+  if (fd_ < 0)
+    return 1;
+  writable_ = mode.front() != 'r' || update;
+  append_ = mode.front() == 'a';
+  return 0;
+}
+
+ssize_t FileIo::Impl::pread(byte* buf, size_t rcount, size_t offset) const {
+  size_t readCount = 0;
+  while (readCount < rcount) {
+    const auto r = ::pread(fd_, buf + readCount, rcount - readCount, static_cast<off_t>(offset + readCount));
+    if (r < 0 && errno == EINTR)
+      continue;
+    if (r < 0)
+      return -1;
+    if (r == 0)
+      break;
+    readCount += static_cast<size_t>(r);
+  }
+  return static_cast<ssize_t>(readCount);
+}
+
+size_t FileIo::Impl::readFd(byte* buf, size_t rcount) {
+  size_t readCount = 0;
+  if (pos_ < head_.size()) {
+    readCount = std::min(rcount, head_.size() - pos_);
+    std::memcpy(buf, head_.data() + pos_, readCount);
+    pos_ += readCount;
+  } else if (pos_ >= bufOffset_ && pos_ < bufOffset_ + bufSize_) {
+    readCount = std::min(rcount, bufOffset_ + bufSize_ - pos_);
+    std::memcpy(buf, buf_.data() + (pos_ - bufOffset_), readCount);
+    pos_ += readCount;
+  }
+  if (readCount == rcount)
+    return readCount;
+
+  // Reads which continue where the buffer or the prefetched data ends grow the read-ahead, a jump resets it
+  if ((bufSize_ != 0 && pos_ == bufOffset_ + bufSize_) || (!head_.empty() && pos_ == head_.size()))
+    readAhead_ = std::min(2 * readAhead_, maxReadAhead);
+  else
+    readAhead_ = minReadAhead;
+
+  const size_t rest = rcount - readCount;
+  ssize_t r = 0;
+  if (rest >= readAhead_) {
+    // Large reads bypass the buffer
+    r = pread(buf + readCount, rest, pos_);
+  } else {
+    buf_.resize(readAhead_);
+    r = pread(buf_.data(), readAhead_, pos_);
+    bufOffset_ = pos_;
+    bufSize_ = r < 0 ? 0 : static_cast<size_t>(r);
+    if (r >= 0) {
+      r = static_cast<ssize_t>(std::min(rest, bufSize_));
+      std::memcpy(buf + readCount, buf_.data(), r);
+    }
+  }
+  if (r < 0) {
+    error_ = true;
+    return readCount;
+  }
+  pos_ += static_cast<size_t>(r);
+  readCount += static_cast<size_t>(r);
+  if (readCount < rcount)
+    eof_ = true;
+  return readCount;
+}
+#endif
+
+namespace {
+//! Backend of the FileIo instances created without one
+std::atomic<FileIo::Backend> defaultFileIoBackend{FileIo::Backend::stdio};
+}  // namespace
+
+FileIo::FileIo(const std::string& path) : FileIo(path, defaultBackend()) {
+}
+
+FileIo::FileIo(const std::string& path, [[maybe_unused]] Backend backend) : p_(std::make_unique<Impl>(path)) {
+#ifndef _WIN32
+  p_->backend_ = backend;
+#endif
 }
 #ifdef _WIN32
 FileIo::FileIo(const std::wstring& path) : p_(std::make_unique<Impl>(path)) {
@@ -238,8 +426,10 @@ int FileIo::munmap() {
 #endif
   }
   if (p_->isWriteable_) {
-    if (p_->fp_)
+    if (p_->isOpen())
       p_->switchMode(Impl::opRead);
+    // Writes through the mapping may have changed the buffered data
+    p_->bufSize_ = 0;
     p_->isWriteable_ = false;
   }
   p_->pMappedArea_ = nullptr;
@@ -248,6 +438,7 @@ int FileIo::munmap() {
 }
 
 byte* FileIo::mmap(bool isWriteable) {
+  EXV_STATS_ADD(mmaps_, 1);
   if (munmap() != 0) {
     throw Error(ErrorCode::kerCallFailed, path(), strError(), "munmap");
   }
@@ -261,7 +452,7 @@ byte* FileIo::mmap(bool isWriteable) {
   if (p_->isWriteable_) {
     prot |= PROT_WRITE;
   }
-  void* rc = ::mmap(nullptr, p_->mappedLength_, prot, MAP_SHARED, _fileno(p_->fp_), 0);
+  void* rc = ::mmap(nullptr, p_->mappedLength_, prot, MAP_SHARED, p_->descriptor(), 0);
   if (MAP_FAILED == rc) {
     throw Error(ErrorCode::kerCallFailed, path(), strError(), "mmap");
   }
@@ -320,6 +511,7 @@ byte* FileIo::mmap(bool isWriteable) {
 
 void FileIo::setPath(const std::string& path) {
   close();
+  p_->head_ = {};
   p_->path_ = path;
 #ifdef _WIN32
   wchar_t t[512];
@@ -342,7 +534,10 @@ void FileIo::setPath(const std::wstring& path) {
 size_t FileIo::write(const byte* data, size_t wcount) {
   if (p_->switchMode(Impl::opWrite) != 0)
     return 0;
-  return std::fwrite(data, 1, wcount, p_->fp_);
+  const size_t writeCount = p_->write(data, wcount);
+  EXV_STATS_ADD(writes_, 1);
+  EXV_STATS_ADD(bytesWritten_, writeCount);
+  return writeCount;
 }
 
 size_t FileIo::write(BasicIo& src) {
@@ -357,7 +552,9 @@ size_t FileIo::write(BasicIo& src) {
   size_t writeTotal = 0;
   size_t readCount = src.read(buf, sizeof(buf));
   while (readCount != 0) {
-    size_t writeCount = std::fwrite(buf, 1, readCount, p_->fp_);
+    size_t writeCount = p_->write(buf, readCount);
+    EXV_STATS_ADD(writes_, 1);
+    EXV_STATS_ADD(bytesWritten_, writeCount);
     writeTotal += writeCount;
     if (writeCount != readCount) {
       // try to reset back to where write stopped
@@ -371,7 +568,8 @@ size_t FileIo::write(BasicIo& src) {
 }
 
 void FileIo::transfer(BasicIo& src) {
-  const bool wasOpen = (p_->fp_ != nullptr);
+  EXV_STATS_PHASE(transfer);
+  const bool wasOpen = p_->isOpen();
   const std::string lastMode(p_->openMode_);
 
   if (auto fileIo = dynamic_cast<FileIo*>(&src)) {
@@ -460,10 +658,17 @@ void FileIo::transfer(BasicIo& src) {
 int FileIo::putb(byte data) {
   if (p_->switchMode(Impl::opWrite) != 0)
     return EOF;
+  EXV_STATS_ADD(writes_, 1);
+  EXV_STATS_ADD(bytesWritten_, 1);
+#ifndef _WIN32
+  if (p_->fd_ >= 0)
+    return p_->write(&data, 1) == 1 ? data : EOF;
+#endif
   return putc(data, p_->fp_);
 }
 
 int FileIo::seek(int64_t offset, Position pos) {
+  EXV_STATS_ADD(seeks_, 1);
   int fileSeek = 0;
   switch (pos) {
     case BasicIo::cur:
@@ -479,6 +684,24 @@ int FileIo::seek(int64_t offset, Position pos) {
 
   if (p_->switchMode(Impl::opSeek) != 0)
     return 1;
+#ifndef _WIN32
+  if (p_->fd_ >= 0) {
+    int64_t base = 0;
+    if (pos == BasicIo::cur) {
+      base = static_cast<int64_t>(p_->pos_);
+    } else if (pos == BasicIo::end) {
+      struct stat st {};
+      if (::fstat(p_->fd_, &st) != 0)
+        return 1;
+      base = st.st_size;
+    }
+    if (base + offset < 0)
+      return 1;
+    p_->pos_ = static_cast<size_t>(base + offset);
+    p_->eof_ = false;
+    return 0;
+  }
+#endif
 #ifdef _WIN32
   return _fseeki64(p_->fp_, offset, fileSeek);
 #else
@@ -487,6 +710,10 @@ int FileIo::seek(int64_t offset, Position pos) {
 }
 
 size_t FileIo::tell() const {
+#ifndef _WIN32
+  if (p_->fd_ >= 0)
+    return p_->pos_;
+#endif
 #ifdef _WIN32
   auto pos = _ftelli64(p_->fp_);
 #else
@@ -506,6 +733,14 @@ size_t FileIo::size() const {
 #endif
   }
 
+#ifndef _WIN32
+  if (p_->fd_ >= 0) {
+    struct stat st {};
+    if (::fstat(p_->fd_, &st) != 0)
+      return std::numeric_limits<size_t>::max();
+    return static_cast<size_t>(st.st_size);
+  }
+#endif
   Impl::StructStat buf;
   if (p_->stat(buf))
     return std::numeric_limits<size_t>::max();
@@ -519,8 +754,14 @@ int FileIo::open() {
 
 int FileIo::open(const std::string& mode) {
   close();
+  if (mode.front() != 'r')
+    p_->head_ = {};
   p_->openMode_ = mode;
   p_->opMode_ = Impl::opSeek;
+#ifndef _WIN32
+  if (p_->backend_ == Backend::positional)
+    return p_->openFd(mode);
+#endif
 #ifdef _WIN32
   wchar_t wmode[10];
   MultiByteToWideChar(CP_UTF8, 0, mode.c_str(), -1, wmode, 10);
@@ -535,7 +776,7 @@ int FileIo::open(const std::string& mode) {
 }
 
 bool FileIo::isopen() const {
-  return p_->fp_ != nullptr;
+  return p_->isOpen();
 }
 
 int FileIo::close() {
@@ -547,6 +788,18 @@ int FileIo::close() {
       rc |= 1;
     p_->fp_ = nullptr;
   }
+#ifndef _WIN32
+  if (p_->fd_ >= 0) {
+    if (::close(p_->fd_) != 0)
+      rc |= 1;
+    p_->fd_ = -1;
+  }
+  p_->pos_ = 0;
+  p_->eof_ = false;
+  p_->error_ = false;
+  p_->bufSize_ = 0;
+  p_->readAhead_ = Impl::minReadAhead;
+#endif
   return rc;
 }
 
@@ -566,21 +819,40 @@ size_t FileIo::read(byte* buf, size_t rcount) {
   if (p_->switchMode(Impl::opRead) != 0) {
     return 0;
   }
-  return std::fread(buf, 1, rcount, p_->fp_);
+#ifndef _WIN32
+  const size_t readCount = p_->fd_ >= 0 ? p_->readFd(buf, rcount) : std::fread(buf, 1, rcount, p_->fp_);
+#else
+  const size_t readCount = std::fread(buf, 1, rcount, p_->fp_);
+#endif
+  EXV_STATS_ADD(reads_, 1);
+  EXV_STATS_ADD(bytesRead_, readCount);
+  return readCount;
 }
 
 int FileIo::getb() {
   if (p_->switchMode(Impl::opRead) != 0)
     return EOF;
+  EXV_STATS_ADD(reads_, 1);
+  EXV_STATS_ADD(bytesRead_, 1);
+#ifndef _WIN32
+  if (p_->fd_ >= 0) {
+    byte data = 0;
+    return p_->readFd(&data, 1) == 1 ? data : EOF;
+  }
+#endif
   return getc(p_->fp_);
 }
 
 int FileIo::error() const {
-  return p_->fp_ ? ferror(p_->fp_) : 0;
+  if (p_->fp_)
+    return ferror(p_->fp_);
+  return p_->error_ ? 1 : 0;
 }
 
 bool FileIo::eof() const {
-  return std::feof(p_->fp_) != 0;
+  if (p_->fp_)
+    return std::feof(p_->fp_) != 0;
+  return p_->eof_;
 }
 
 const std::string& FileIo::path() const noexcept {
@@ -589,7 +861,144 @@ const std::string& FileIo::path() const noexcept {
 
 void FileIo::populateFakeData() {
 }
+
+FileIo::Backend FileIo::backend() const {
+  return p_->backend_;
+}
+
+size_t FileIo::readAt(byte* buf, size_t rcount, size_t offset) const {
+  // The stdio backend would have to move the position of the shared stream
+  if (p_->backend_ != Backend::positional)
+    throw Error(ErrorCode::kerFunctionNotSupported, "FileIo::readAt with the stdio backend");
+  EXV_STATS_ADD(reads_, 1);
+#ifndef _WIN32
+  if (p_->fd_ >= 0) {
+    const auto readCount = p_->pread(buf, rcount, offset);
+    EXV_STATS_ADD(bytesRead_, readCount < 0 ? 0 : readCount);
+    return readCount < 0 ? 0 : static_cast<size_t>(readCount);
+  }
 #endif
+  return 0;
+}
+
+int FileIo::prefetch(size_t count) {
+#ifndef _WIN32
+  if (p_->backend_ != Backend::positional)
+    return 0;
+  const bool wasOpen = p_->fd_ >= 0;
+  if (!wasOpen && p_->openFd("rb") != 0)
+    return 1;
+  p_->head_.resize(count);
+  const auto r = p_->pread(p_->head_.data(), count, 0);
+  p_->head_.resize(r < 0 ? 0 : static_cast<size_t>(r));
+  EXV_STATS_ADD(reads_, 1);
+  EXV_STATS_ADD(bytesRead_, p_->head_.size());
+  if (!wasOpen) {
+    ::close(p_->fd_);
+    p_->fd_ = -1;
+  }
+  return r < 0 ? 1 : 0;
+#else
+  return 0;
+#endif
+}
+
+void FileIo::setDefaultBackend(Backend backend) {
+  defaultFileIoBackend = backend;
+}
+
+FileIo::Backend FileIo::defaultBackend() {
+  return defaultFileIoBackend;
+}
+#endif
+
+namespace {
+/*!
+  @brief Per-thread cache of the memory blocks released by MemIo objects.
+         Repeated writes of similar images reuse the blocks of earlier
+         writes instead of going back to the allocator each time.
+ */
+class MemIoPool {
+ public:
+  MemIoPool() = default;
+  ~MemIoPool() {
+    destroyed_ = true;
+    for (auto&& [data, size] : blocks_)
+      std::free(data);
+  }
+  MemIoPool(const MemIoPool&) = delete;
+  MemIoPool& operator=(const MemIoPool&) = delete;
+
+  //! Return a block of at least \em size bytes and set \em sizeAlloced to its size
+  static byte* acquire(size_t size, size_t& sizeAlloced) {
+    if (!destroyed_) {
+      auto& blocks = instance().blocks_;
+      auto best = blocks.end();
+      for (auto i = blocks.begin(); i != blocks.end(); ++i) {
+        if (i->second >= size && (best == blocks.end() || i->second < best->second))
+          best = i;
+      }
+      if (best != blocks.end()) {
+        auto data = best->first;
+        sizeAlloced = best->second;
+        instance().total_ -= sizeAlloced;
+        blocks.erase(best);
+        return data;
+      }
+    }
+    auto data = static_cast<byte*>(std::malloc(size));
+    if (!data) {
+      throw Error(ErrorCode::kerMallocFailed);
+    }
+    sizeAlloced = size;
+    return data;
+  }
+
+  //! Keep the block \em data of \em sizeAlloced bytes for reuse or free it
+  static void release(byte* data, size_t sizeAlloced) {
+    if (destroyed_ || sizeAlloced > maxTotal_) {
+      std::free(data);
+      return;
+    }
+    auto& pool = instance();
+    // Make room by dropping the smallest blocks
+    while (!pool.blocks_.empty() && (pool.blocks_.size() == maxBlocks_ || pool.total_ + sizeAlloced > maxTotal_)) {
+      auto smallest = std::min_element(pool.blocks_.begin(), pool.blocks_.end(),
+                                       [](const auto& a, const auto& b) { return a.second < b.second; });
+      std::free(smallest->first);
+      pool.total_ -= smallest->second;
+      pool.blocks_.erase(smallest);
+    }
+    pool.blocks_.emplace_back(data, sizeAlloced);
+    pool.total_ += sizeAlloced;
+  }
+
+  //! Free the blocks kept by the calling thread
+  static void clear() {
+    if (destroyed_)
+      return;
+    auto& pool = instance();
+    for (auto&& [data, size] : pool.blocks_)
+      std::free(data);
+    pool.blocks_.clear();
+    pool.total_ = 0;
+  }
+
+ private:
+  static MemIoPool& instance() {
+    thread_local MemIoPool pool;
+    return pool;
+  }
+
+  static constexpr size_t maxBlocks_ = 4;                 //!< Maximum number of blocks kept per thread
+  static constexpr size_t maxTotal_ = 64 * 1024 * 1024;  //!< Maximum number of bytes kept per thread
+  //! Set when the pool of this thread is gone, e.g., for MemIo objects destroyed late at thread exit
+  static inline thread_local bool destroyed_ = false;
+
+  std::vector<std::pair<byte*, size_t>> blocks_;  //!< Cached blocks and their sizes
+  size_t total_{0};                               //!< Sum of the sizes of the cached blocks
+};
+}  // namespace
 
 //! Internal Pimpl structure of class MemIo.
 class MemIo::Impl final {
@@ -608,6 +1017,8 @@ class MemIo::Impl final {
 
   // METHODS
   void reserve(size_t wcount);  //!< Reserve memory
+  void allocate(size_t size);   //!< Make the memory area an owned buffer of at least \em size bytes
+  void release();               //!< Give the buffer back to the pool
 
   // NOT IMPLEMENTED
   Impl(const Impl&) = delete;             //!< Copy constructor
@@ -668,41 +1079,62 @@ class BlockMap {
   size_t size_{};
 };
 
-void MemIo::Impl::reserve(size_t wcount) {
-  const size_t need = wcount + idx_;
-  size_t blockSize = 32 * 1024;  // 32768
-  const size_t maxBlockSize = 4 * 1024 * 1024;
-
+void MemIo::Impl::allocate(size_t size) {
+  if (isMalloced_ && size <= sizeAlloced_)
+    return;
   if (!isMalloced_) {
-    // Minimum size for 1st block
-    auto size = std::max<size_t>(blockSize * (1 + need / blockSize), size_);
-    auto data = static_cast<byte*>(std::malloc(size));
-    if (!data) {
-      throw Error(ErrorCode::kerMallocFailed);
-    }
-    if (data_) {
+    size_t sizeAlloced = 0;
+    auto data = MemIoPool::acquire(std::max(size, size_), sizeAlloced);
+    if (data_ && size_ > 0) {
       std::memcpy(data, data_, size_);
     }
     data_ = data;
-    sizeAlloced_ = size;
+    sizeAlloced_ = sizeAlloced;
     isMalloced_ = true;
+    return;
+  }
+  // Large blocks are usually remapped rather than copied by realloc
+  auto data = static_cast<byte*>(std::realloc(data_, size));
+  if (!data) {
+    throw Error(ErrorCode::kerMallocFailed);
+  }
+  data_ = data;
+  sizeAlloced_ = size;
+}
+
+void MemIo::Impl::release() {
+  if (isMalloced_) {
+    MemIoPool::release(data_, sizeAlloced_);
+  }
+  data_ = nullptr;
+  sizeAlloced_ = 0;
+  isMalloced_ = false;
+}
+
+void MemIo::Impl::reserve(size_t wcount) {
+  const size_t need = wcount + idx_;
+  const size_t blockSize = 32 * 1024;  // 32768
+
+  if (!isMalloced_) {
+    // Minimum size for 1st block
+    allocate(blockSize * (1 + need / blockSize));
   }
 
   if (need > size_) {
     if (need > sizeAlloced_) {
-      blockSize = std::min(2 * sizeAlloced_, maxBlockSize);
-      // Allocate in blocks
-      size_t want = blockSize * (1 + need / blockSize);
-      data_ = static_cast<byte*>(std::realloc(data_, want));
-      if (!data_) {
-        throw Error(ErrorCode::kerMallocFailed);
-      }
-      sizeAlloced_ = want;
+      // Grow geometrically, in blocks, so that the number of reallocations
+      // is logarithmic in the final size
+      const size_t want = std::max(need, sizeAlloced_ + sizeAlloced_ / 2);
+      allocate(blockSize * (1 + want / blockSize));
     }
     size_ = need;
   }
 }
 
+void MemIo::releasePool() {
+  MemIoPool::clear();
+}
+
 MemIo::MemIo() : p_(std::make_unique<Impl>()) {
 }
 
@@ -710,12 +1142,17 @@ MemIo::MemIo(const byte* data, size_t size) : p_(std::make_unique<Impl>(data, si
 }
 
 MemIo::~MemIo() {
-  if (p_->isMalloced_) {
-    std::free(p_->data_);
-  }
+  p_->release();
+}
+
+void MemIo::reserve(size_t size) {
+  if (size > p_->size_)
+    p_->allocate(size);
 }
 
 size_t MemIo::write(const byte* data, size_t wcount) {
+  EXV_STATS_ADD(writes_, 1);
+  EXV_STATS_ADD(bytesWritten_, wcount);
   p_->reserve(wcount);
   if (data) {
     std::memcpy(&p_->data_[p_->idx_], data, wcount);
@@ -725,18 +1162,19 @@ size_t MemIo::write(const byte* data, size_t wcount) {
 }
 
 void MemIo::transfer(BasicIo& src) {
+  EXV_STATS_PHASE(transfer);
   if (auto memIo = dynamic_cast<MemIo*>(&src)) {
     // Optimization if src is another instance of MemIo
-    if (p_->isMalloced_) {
-      std::free(p_->data_);
-    }
+    p_->release();
     p_->idx_ = 0;
     p_->data_ = memIo->p_->data_;
     p_->size_ = memIo->p_->size_;
+    p_->sizeAlloced_ = memIo->p_->sizeAlloced_;
     p_->isMalloced_ = memIo->p_->isMalloced_;
     memIo->p_->idx_ = 0;
     memIo->p_->data_ = nullptr;
     memIo->p_->size_ = 0;
+    memIo->p_->sizeAlloced_ = 0;
     memIo->p_->isMalloced_ = false;
   } else {
     // Generic reopen to reset position to start
@@ -770,12 +1208,15 @@ size_t MemIo::write(BasicIo& src) {
 }
 
 int MemIo::putb(byte data) {
+  EXV_STATS_ADD(writes_, 1);
+  EXV_STATS_ADD(bytesWritten_, 1);
   p_->reserve(1);
   p_->data_[p_->idx_++] = data;
   return data;
 }
 
 int MemIo::seek(int64_t offset, Position pos) {
+  EXV_STATS_ADD(seeks_, 1);
   int64_t newIdx = 0;
 
   switch (pos) {
@@ -804,6 +1245,7 @@ int MemIo::seek(int64_t offset, Position pos) {
 }
 
 byte* MemIo::mmap(bool /*isWriteable*/) {
+  EXV_STATS_ADD(mmaps_, 1);
   return p_->data_;
 }
 
@@ -847,6 +1289,8 @@ size_t MemIo::read(byte* buf, size_t rcount) {
     std::memcpy(buf, &p_->data_[p_->idx_], allow);
   }
   p_->idx_ += allow;
+  EXV_STATS_ADD(reads_, 1);
+  EXV_STATS_ADD(bytesRead_, allow);
   if (rcount > avail) {
     p_->eof_ = true;
   }
@@ -858,6 +1302,8 @@ int MemIo::getb() {
     p_->eof_ = true;
     return EOF;
   }
+  EXV_STATS_ADD(reads_, 1);
+  EXV_STATS_ADD(bytesRead_, 1);
   return p_->data_[p_->idx_++];
 }
 
@@ -877,6 +1323,153 @@ const std::string& MemIo::path() const noexcept {
 void MemIo::populateFakeData() {
 }
 
+TracingIo::TracingIo(BasicIo::UniquePtr io) : io_(std::move(io)) {
+}
+
+void TracingIo::record(Op op, size_t offset, size_t length) {
+  events_.push_back({op, offset, length});
+}
+
+int TracingIo::open() {
+  record(opOpen, 0, 0);
+  return io_->open();
+}
+
+int TracingIo::close() {
+  record(opClose, 0, 0);
+  return io_->close();
+}
+
+size_t TracingIo::write(const byte* data, size_t wcount) {
+  const size_t offset = io_->tell();
+  const size_t writeCount = io_->write(data, wcount);
+  record(opWrite, offset, writeCount);
+  return writeCount;
+}
+
+size_t TracingIo::write(BasicIo& src) {
+  const size_t offset = io_->tell();
+  const size_t writeCount = io_->write(src);
+  record(opWrite, offset, writeCount);
+  return writeCount;
+}
+
+int TracingIo::putb(byte data) {
+  const size_t offset = io_->tell();
+  const int rc = io_->putb(data);
+  record(opWrite, offset, rc == EOF ? 0 : 1);
+  return rc;
+}
+
+DataBuf TracingIo::read(size_t rcount) {
+  const size_t offset = io_->tell();
+  DataBuf buf = io_->read(rcount);
+  record(opRead, offset, buf.size());
+  return buf;
+}
+
+size_t TracingIo::read(byte* buf, size_t rcount) {
+  const size_t offset = io_->tell();
+  const size_t readCount = io_->read(buf, rcount);
+  record(opRead, offset, readCount);
+  return readCount;
+}
+
+int TracingIo::getb() {
+  const size_t offset = io_->tell();
+  const int rc = io_->getb();
+  record(opRead, offset, rc == EOF ? 0 : 1);
+  return rc;
+}
+
+void TracingIo::transfer(BasicIo& src) {
+  const size_t length = src.size();
+  io_->transfer(src);
+  record(opTransfer, 0, length);
+}
+
+int TracingIo::seek(int64_t offset, Position pos) {
+  const int rc = io_->seek(offset, pos);
+  record(opSeek, io_->tell(), 0);
+  return rc;
+}
+
+byte* TracingIo::mmap(bool isWriteable) {
+  byte* pData = io_->mmap(isWriteable);
+  record(opMmap, 0, io_->size());
+  return pData;
+}
+
+int TracingIo::munmap() {
+  record(opMunmap, 0, 0);
+  return io_->munmap();
+}
+
+void TracingIo::populateFakeData() {
+  io_->populateFakeData();
+}
+
+void TracingIo::clearEvents() {
+  events_.clear();
+}
+
+size_t TracingIo::tell() const {
+  return io_->tell();
+}
+
+size_t TracingIo::size() const {
+  return io_->size();
+}
+
+bool TracingIo::isopen() const {
+  return io_->isopen();
+}
+
+int TracingIo::error() const {
+  return io_->error();
+}
+
+bool TracingIo::eof() const {
+  return io_->eof();
+}
+
+const std::string& TracingIo::path() const noexcept {
+  return io_->path();
+}
+
+TracingIo::Summary TracingIo::summary() const {
+  Summary ret;
+  for (const auto& event : events_) {
+    switch (event.op_) {
+      case opOpen:
+        ++ret.opens_;
+        break;
+      case opRead:
+        ++ret.reads_;
+        if (event.length_ < smallReadSize)
+          ++ret.smallReads_;
+        ret.bytesRead_ += event.length_;
+        break;
+      case opWrite:
+        ++ret.writes_;
+        ret.bytesWritten_ += event.length_;
+        break;
+      case opSeek:
+        ++ret.seeks_;
+        break;
+      case opMmap:
+        ++ret.mmaps_;
+        break;
+      case opClose:
+      case opMunmap:
+      case opTransfer:
+        break;
+    }
+  }
+  ret.size_ = io_->size();
+  return ret;
+}
+
 #ifdef EXV_ENABLE_FILESYSTEM
 XPathIo::XPathIo(const std::string& orgPath) : FileIo(XPathIo::writeDataToFile(orgPath)), tempFilePath_(path()) {
 }
@@ -10,6 +10,7 @@
 #include "futils.hpp"
 #include "image.hpp"
 #include "image_int.hpp"
+#include "stats_int.hpp"
 #include "tags.hpp"
 #include "tiffcomposite_int.hpp"
 #include "tiffimage_int.hpp"
@@ -703,6 +704,7 @@ void BmffImage::openOrThrow() const {
 }
 
 void BmffImage::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
   openOrThrow();
   IoCloser closer(*io_);
 
@@ -17,12 +17,17 @@
 #include "properties.hpp"
 #include "tags.hpp"
 #include "types.hpp"
+#include "utils.hpp"
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
 
 // + standard includes
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #ifdef EXV_HAVE_ICONV
 #ifndef SUPPRESS_WARNINGS
@@ -273,7 +278,16 @@ class Converter {
   bool prepareExifTarget(const char* to, bool force = false);
   bool prepareIptcTarget(const char* to, bool force = false);
   bool prepareXmpTarget(const char* to, bool force = false);
-  std::string computeExifDigest(bool tiff);
+  //! Compute the tiff:NativeDigest and exif:NativeDigest values in one pass over the Exif data
+  std::pair<std::string, std::string> computeExifDigests();
+  //! Write the digests \em digests, as returned by computeExifDigests(), to XMP
+  void writeExifDigest(const std::pair<std::string, std::string>& digests);
+  //! Return the identity of the Exif tag or IPTC dataset of each conversion rule, see datumId()
+  static const std::vector<uint32_t>& ruleIds();
+  //! Return the identities of the Exif tags and IPTC datasets which are the source of a conversion to XMP
+  [[nodiscard]] std::unordered_set<uint32_t> sourceIds() const;
+  //! Return the XMP keys, and the keys of the structures and arrays containing them, in the XMP data
+  [[nodiscard]] std::unordered_set<std::string> sourceXmpKeys() const;
 
   // DATA
   static const Conversion conversion_[];  //!< Conversion rules
@@ -499,17 +513,76 @@ Converter::Converter(IptcData& iptcData, XmpData& xmpData, const char* iptcChars
     exifData_(nullptr), iptcData_(&iptcData), xmpData_(&xmpData), iptcCharset_(iptcCharset) {
 }
 
+namespace {
+//! Return an identity of an Exif tag (\em group is the IfdId) or an IPTC dataset (\em group is the record)
+uint32_t datumId(uint32_t group, uint16_t tag) {
+  return group << 16 | tag;
+}
+}  // namespace
+
+const std::vector<uint32_t>& Converter::ruleIds() {
+  static const auto ids = [] {
+    std::vector<uint32_t> ret;
+    for (auto&& c : conversion_) {
+      if (c.metadataId_ == mdExif) {
+        ExifKey key(c.key1_);
+        ret.push_back(datumId(static_cast<uint32_t>(key.ifdId()), key.tag()));
+      } else {
+        IptcKey key(c.key1_);
+        ret.push_back(datumId(key.record(), key.tag()));
+      }
+    }
+    return ret;
+  }();
+  return ids;
+}
+
+std::unordered_set<uint32_t> Converter::sourceIds() const {
+  std::unordered_set<uint32_t> ids;
+  if (exifData_) {
+    const ExifData& exifData = *exifData_;
+    for (auto&& md : exifData)
+      ids.insert(datumId(static_cast<uint32_t>(md.ifdId()), md.tag()));
+  }
+  if (iptcData_) {
+    for (auto&& md : *iptcData_)
+      ids.insert(datumId(md.record(), md.tag()));
+  }
+  return ids;
+}
+
+std::unordered_set<std::string> Converter::sourceXmpKeys() const {
+  std::unordered_set<std::string> keys;
+  for (auto&& md : *xmpData_) {
+    std::string key = md.key();
+    for (auto i = key.find_first_of("/["); i != std::string::npos; i = key.find_first_of("/[", i + 1))
+      keys.insert(key.substr(0, i));
+    keys.insert(std::move(key));
+  }
+  return keys;
+}
+
 void Converter::cnvToXmp() {
-  for (auto&& c : conversion_) {
-    if ((c.metadataId_ == mdExif && exifData_) || (c.metadataId_ == mdIptc && iptcData_)) {
+  // Rules whose source is not in the Exif or IPTC data do nothing, the
+  // sources are collected in one pass to skip them without a lookup
+  const auto ids = sourceIds();
+  const auto& rules = ruleIds();
+  for (size_t i = 0; i < std::size(conversion_); ++i) {
+    const auto& c = conversion_[i];
+    if (((c.metadataId_ == mdExif && exifData_) || (c.metadataId_ == mdIptc && iptcData_)) && ids.contains(rules[i])) {
       std::invoke(c.key1ToKey2_, *this, c.key1_, c.key2_);
     }
   }
 }
 
 void Converter::cnvFromXmp() {
+  const auto keys = sourceXmpKeys();
   for (auto&& c : conversion_) {
     if ((c.metadataId_ == mdExif && exifData_) || (c.metadataId_ == mdIptc && iptcData_)) {
+      // Without their source, all rules do nothing, except those which remove the target first
+      if (!keys.contains(c.key2_) && c.key2ToKey1_ != &Converter::cnvXmpComment &&
+          c.key2ToKey1_ != &Converter::cnvXmpArray)
+        continue;
       std::invoke(c.key2ToKey1_, *this, c.key2_, c.key1_);
     }
   }
@@ -529,14 +602,12 @@ bool Converter::prepareExifTarget(const char* to, bool force) {
 }
 
 bool Converter::prepareIptcTarget(const char* to, bool force) {
-  auto pos = iptcData_->findKey(IptcKey(to));
-  if (pos == iptcData_->end())
+  const IptcKey key(to);
+  if (iptcData_->findKey(key) == iptcData_->end())
     return true;
   if (!overwrite_ && !force)
     return false;
-  while ((pos = iptcData_->findKey(IptcKey(to))) != iptcData_->end()) {
-    iptcData_->erase(pos);
-  }
+  iptcData_->eraseKey(key);
   return true;
 }
 
@@ -1163,13 +1234,14 @@ void Converter::cnvXmpGPSCoord(const char* from, const char* to) {
 }
 
 void Converter::cnvIptcValue(const char* from, const char* to) {
-  auto pos = iptcData_->findKey(IptcKey(from));
+  const IptcKey key(from);
+  auto pos = iptcData_->findKey(key);
   if (pos == iptcData_->end())
     return;
   if (!prepareXmpTarget(to))
     return;
   while (pos != iptcData_->end()) {
-    if (pos->key() == from) {
+    if (pos->tag() == key.tag() && pos->record() == key.record()) {
       std::string value = pos->toString();
       if (!pos->value().ok()) {
 #ifndef SUPPRESS_WARNINGS
@@ -1235,48 +1307,58 @@ void Converter::cnvXmpValueToIptc(const char* from, const char* to) {
 }
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
-std::string Converter::computeExifDigest(bool tiff) {
-  std::string res;
-  MD5_CTX context;
-  unsigned char digest[16];
-
-  MD5Init(&context);
-  for (auto&& c : conversion_) {
-    if (c.metadataId_ == mdExif) {
-      Exiv2::ExifKey key(c.key1_);
-      if (tiff && key.groupName() != "Image")
-        continue;
-      if (!tiff && key.groupName() == "Image")
-        continue;
-
-      if (!res.empty())
-        res += ',';
-      res += std::to_string(key.tag());
-      auto pos = exifData_->findKey(key);
-      if (pos == exifData_->end())
-        continue;
-      DataBuf data(pos->size());
-      pos->copy(data.data(), littleEndian /* FIXME ? */);
-      MD5Update(&context, data.c_data(), static_cast<uint32_t>(data.size()));
-    }
+std::pair<std::string, std::string> Converter::computeExifDigests() {
+  // Index the first datum of each tag, like findKey() would find it
+  std::unordered_map<uint32_t, const Exifdatum*> data;
+  const ExifData& exifData = *exifData_;
+  for (auto&& md : exifData)
+    data.try_emplace(datumId(static_cast<uint32_t>(md.ifdId()), md.tag()), &md);
+
+  std::string res[2];
+  MD5_CTX context[2];
+  MD5Init(&context[0]);
+  MD5Init(&context[1]);
+  const auto& rules = ruleIds();
+  for (size_t i = 0; i < std::size(conversion_); ++i) {
+    if (conversion_[i].metadataId_ != mdExif)
+      continue;
+    // The tiff digest covers the tags of IFD0, the exif digest all others
+    const auto tag = static_cast<uint16_t>(rules[i] & 0xffff);
+    const size_t d = (rules[i] >> 16) == static_cast<uint32_t>(IfdId::ifd0Id) ? 0 : 1;
+    if (!res[d].empty())
+      res[d] += ',';
+    res[d] += std::to_string(tag);
+    auto pos = data.find(rules[i]);
+    if (pos == data.end())
+      continue;
+    DataBuf buf(pos->second->size());
+    pos->second->copy(buf.data(), littleEndian /* FIXME ? */);
+    MD5Update(&context[d], buf.c_data(), static_cast<uint32_t>(buf.size()));
   }
-  MD5Final(digest, &context);
-  res += ';';
-  for (const auto& i : digest) {
-    res += stringFormat("{:02X}", i);
+  for (size_t d = 0; d < 2; ++d) {
+    unsigned char digest[16];
+    MD5Final(digest, &context[d]);
+    res[d] += ';';
+    Internal::hexEncode(res[d], digest, sizeof(digest), 0, true);
   }
-  return res;
+  return {std::move(res[0]), std::move(res[1])};
 }
 #else
-std::string Converter::computeExifDigest(bool) {
+std::pair<std::string, std::string> Converter::computeExifDigests() {
   return {};
 }
 #endif
 
 void Converter::writeExifDigest() {
 #ifdef EXV_HAVE_XMP_TOOLKIT
-  (*xmpData_)["Xmp.tiff.NativeDigest"] = computeExifDigest(true);
-  (*xmpData_)["Xmp.exif.NativeDigest"] = computeExifDigest(false);
+  writeExifDigest(computeExifDigests());
+#endif
+}
+
+void Converter::writeExifDigest([[maybe_unused]] const std::pair<std::string, std::string>& digests) {
+#ifdef EXV_HAVE_XMP_TOOLKIT
+  (*xmpData_)["Xmp.tiff.NativeDigest"] = digests.first;
+  (*xmpData_)["Xmp.exif.NativeDigest"] = digests.second;
 #endif
 }
 
@@ -1284,13 +1366,15 @@ void Converter::syncExifWithXmp() {
   auto td = xmpData_->findKey(XmpKey("Xmp.tiff.NativeDigest"));
   auto ed = xmpData_->findKey(XmpKey("Xmp.exif.NativeDigest"));
   if (td != xmpData_->end() && ed != xmpData_->end()) {
-    if (td->value().toString() == computeExifDigest(true) && ed->value().toString() == computeExifDigest(false)) {
+    const auto digests = computeExifDigests();
+    if (td->value().toString() == digests.first && ed->value().toString() == digests.second) {
       // We have both digests and the values match
       // XMP is up-to-date, we should update Exif
       setOverwrite(true);
       setErase(false);
 
       cnvFromXmp();
+      // The Exif data changed, the digests are computed again
       writeExifDigest();
       return;
     }
@@ -1299,8 +1383,9 @@ void Converter::syncExifWithXmp() {
     setOverwrite(true);
     setErase(false);
 
+    // The conversion to XMP does not change the Exif data, the digests are still valid
     cnvToXmp();
-    writeExifDigest();
+    writeExifDigest(digests);
     return;
   }
   // We don't have both digests, it is probably the first conversion to XMP
@@ -75,6 +75,33 @@ void Cr2Image::readMetadata() {
   setByteOrder(bo);
 }  // Cr2Image::readMetadata
 
+namespace {
+/*!
+  @brief Encode as Cr2Parser::encode() does. With \em spliceInPlace, \em pData
+         must be the mapped content of \em io, see TiffParserWorker::encode().
+ */
+WriteMethod encodeCr2(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
+                      const IptcData& iptcData, const XmpData& xmpData, bool spliceInPlace) {
+  // Delete IFDs which do not occur in TIFF images
+  static constexpr auto filteredIfds = std::array{
+      IfdId::panaRawId,
+  };
+  for (auto&& filteredIfd : filteredIfds) {
+#ifdef EXIV2_DEBUG_MESSAGES
+    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
+#endif
+    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), Internal::FindExifdatum(filteredIfd)),
+                   exifData.end());
+  }
+
+  auto header = Internal::Cr2Header(byteOrder);
+  Internal::OffsetWriter offsetWriter;
+  offsetWriter.setOrigin(Internal::OffsetWriter::cr2RawIfdOffset, Internal::Cr2Header::offset2addr(), byteOrder);
+  return Internal::TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Internal::Tag::root,
+                                            Internal::TiffMapping::findEncoder, &header, &offsetWriter, spliceInPlace);
+}
+}  // namespace
+
 void Cr2Image::writeMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing CR2 file " << io_->path() << "\n";
@@ -96,7 +123,8 @@ void Cr2Image::writeMetadata() {
     bo = littleEndian;
   }
   setByteOrder(bo);
-  Cr2Parser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
+  // pData is the mapped file, so the image data can be spliced into it in place
+  encodeCr2(*io_, pData, size, bo, exifData_, iptcData_, xmpData_, pData != nullptr);  // may throw
 }  // Cr2Image::writeMetadata
 
 ByteOrder Cr2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
@@ -107,23 +135,7 @@ ByteOrder Cr2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmp
 
 WriteMethod Cr2Parser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
                               const IptcData& iptcData, const XmpData& xmpData) {
-  // Delete IFDs which do not occur in TIFF images
-  static constexpr auto filteredIfds = std::array{
-      IfdId::panaRawId,
-  };
-  for (auto&& filteredIfd : filteredIfds) {
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
-#endif
-    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), Internal::FindExifdatum(filteredIfd)),
-                   exifData.end());
-  }
-
-  auto header = Internal::Cr2Header(byteOrder);
-  Internal::OffsetWriter offsetWriter;
-  offsetWriter.setOrigin(Internal::OffsetWriter::cr2RawIfdOffset, Internal::Cr2Header::offset2addr(), byteOrder);
-  return Internal::TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Internal::Tag::root,
-                                            Internal::TiffMapping::findEncoder, &header, &offsetWriter);
+  return encodeCr2(io, pData, size, byteOrder, exifData, iptcData, xmpData, false);
 }
 
 // *************************************************************************
@@ -737,7 +737,7 @@ void CrwMap::decode0x180e(const CiffComponent& ciffComponent, const CrwMapping*
   char s[m];
   std::strftime(s, m, "%Y:%m:%d %T", tm);
 
-  ExifKey key(pCrwMapping->tag_, Internal::groupName(pCrwMapping->ifdId_));
+  ExifKey key(pCrwMapping->tag_, pCrwMapping->ifdId_);
   AsciiValue value;
   value.read(s);
   image.exifData().add(key, &value);
@@ -775,7 +775,7 @@ void CrwMap::decode0x2008(const CiffComponent& ciffComponent, const CrwMapping*
 void CrwMap::decodeBasic(const CiffComponent& ciffComponent, const CrwMapping* pCrwMapping, Image& image,
                          ByteOrder byteOrder) {
   // create a key and value pair
-  ExifKey key(pCrwMapping->tag_, Internal::groupName(pCrwMapping->ifdId_));
+  ExifKey key(pCrwMapping->tag_, pCrwMapping->ifdId_);
   Value::UniquePtr value;
   if (ciffComponent.typeId() != directory) {
     value = Value::create(ciffComponent.typeId());
@@ -822,7 +822,7 @@ void CrwMap::encode(CiffHeader& pHead, const Image& image) {
 
 void CrwMap::encodeBasic(const Image& image, const CrwMapping& pCrwMapping, CiffHeader& pHead) {
   // Determine the source Exif metadatum
-  ExifKey ek(pCrwMapping.tag_, Internal::groupName(pCrwMapping.ifdId_));
+  ExifKey ek(pCrwMapping.tag_, pCrwMapping.ifdId_);
   auto ed = image.exifData().findKey(ek);
 
   // Set the new value or remove the entry
@@ -914,7 +914,7 @@ void CrwMap::encodeArray(const Image& image, const CrwMapping& pCrwMapping, Ciff
 
 void CrwMap::encode0x180e(const Image& image, const CrwMapping& pCrwMapping, CiffHeader& pHead) {
   time_t t = 0;
-  const ExifKey key(pCrwMapping.tag_, Internal::groupName(pCrwMapping.ifdId_));
+  const ExifKey key(pCrwMapping.tag_, pCrwMapping.ifdId_);
   if (auto ed = image.exifData().findKey(key); ed != image.exifData().end()) {
     std::tm tm = {};
     if (exifTime(ed->toString().c_str(), &tm) == 0) {
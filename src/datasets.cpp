@@ -13,6 +13,8 @@
 #include "types.hpp"
 
 #include <iomanip>
+#include <string_view>
+#include <unordered_map>
 
 // *****************************************************************************
 // class member definitions
@@ -374,28 +376,45 @@ constexpr const DataSet* IptcDataSets::records_[] = {
     nullptr,
 };
 
+namespace {
+//! Index of the datasets of a record by number and by name
+struct RecordIndex {
+  explicit RecordIndex(const DataSet* dataSet) {
+    // Including the end marker, which the linear searches this replaces also found
+    for (int idx = 0;; ++idx) {
+      byNumber_.try_emplace(dataSet[idx].number_, idx);
+      byName_.try_emplace(dataSet[idx].name_, idx);
+      if (dataSet[idx].number_ == 0xffff)
+        break;
+    }
+  }
+
+  std::unordered_map<uint16_t, int> byNumber_;
+  std::unordered_map<std::string_view, int> byName_;
+};
+
+//! Return the index of record \em recordId, which must be the envelope or application2 record
+const RecordIndex& recordIndex(uint16_t recordId) {
+  static const RecordIndex envelope(envelopeRecord);
+  static const RecordIndex application2(application2Record);
+  return recordId == IptcDataSets::envelope ? envelope : application2;
+}
+}  // namespace
+
 int IptcDataSets::dataSetIdx(uint16_t number, uint16_t recordId) {
   if (recordId != envelope && recordId != application2)
     return -1;
-  const DataSet* dataSet = records_[recordId];
-  int idx;
-  for (idx = 0; dataSet[idx].number_ != number; ++idx) {
-    if (dataSet[idx].number_ == 0xffff)
-      return -1;
-  }
-  return idx;
+  const auto& byNumber = recordIndex(recordId).byNumber_;
+  auto i = byNumber.find(number);
+  return i == byNumber.end() ? -1 : i->second;
 }
 
 int IptcDataSets::dataSetIdx(const std::string& dataSetName, uint16_t recordId) {
   if (recordId != envelope && recordId != application2)
     return -1;
-  const DataSet* dataSet = records_[recordId];
-  int idx;
-  for (idx = 0; dataSet[idx].name_ != dataSetName; ++idx) {
-    if (dataSet[idx].number_ == 0xffff)
-      return -1;
-  }
-  return idx;
+  const auto& byName = recordIndex(recordId).byName_;
+  auto i = byName.find(dataSetName);
+  return i == byName.end() ? -1 : i->second;
 }
 
 TypeId IptcDataSets::dataSetType(uint16_t number, uint16_t recordId) {
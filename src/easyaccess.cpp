@@ -3,63 +3,149 @@
 #include "easyaccess.hpp"
 
 #include "tags.hpp"
+#include "tags_int.hpp"
 #include "utils.hpp"
 #include "value.hpp"
 
-#include <cstring>
+#include <algorithm>
+#include <array>
 #include <sstream>
+#include <unordered_map>
 
 // *****************************************************************************
 namespace {
 using namespace Exiv2;
 
 /*!
-  @brief Search \em ed for a Metadatum specified by the \em keys.
-         The \em keys are searched in the order of their appearance, the
+  @brief An %Exif key compiled into its (IfdId, tag) identity. Matching a
+         Metadatum against a handle compares two integers instead of
+         building and comparing the key string.
+ */
+struct KeyHandle {
+  KeyHandle() = default;
+  //! Parse \em key once, resolving its group and tag
+  explicit KeyHandle(const char* key) {
+    const ExifKey exifKey(key);
+    ifdId_ = exifKey.ifdId();
+    tag_ = exifKey.tag();
+  }
+  //! Return true if \em md has the identity of this handle
+  [[nodiscard]] bool matches(const Exifdatum& md) const {
+    return md.tag() == tag_ && md.ifdId() == ifdId_;
+  }
+  //! Return the packed identity of this handle
+  [[nodiscard]] uint64_t packed() const {
+    return pack(ifdId_, tag_);
+  }
+  //! Combine IFD id and tag into a single integer
+  static uint64_t pack(IfdId ifdId, uint16_t tag) {
+    return (static_cast<uint64_t>(ifdId) << 16) | tag;
+  }
+
+  IfdId ifdId_{IfdId::ifdIdNotSet};
+  uint16_t tag_{0};
+};
+
+//! Compile a list of keys into handles, keeping the order of the list
+template <size_t N>
+std::array<KeyHandle, N> compileKeys(const char* const (&keys)[N]) {
+  std::array<KeyHandle, N> handles;
+  for (size_t i = 0; i < N; ++i)
+    handles[i] = KeyHandle(keys[i]);
+  return handles;
+}
+
+/*!
+  @brief Find metadata by handle. Without an index each lookup is a linear
+         scan of the container; after buildIndex() lookups are constant time.
+ */
+class KeyFinder {
+ public:
+  explicit KeyFinder(const ExifData& ed) : ed_(ed), pending_(ed.makerNotePending()) {
+  }
+
+  //! Index the first Metadatum of each (IfdId, tag) in a single pass over the container
+  void buildIndex() {
+    index_.reserve(ed_.count());
+    for (auto i = ed_.begin(); i != ed_.end(); ++i) {
+      index_.try_emplace(KeyHandle::pack(i->ifdId(), i->tag()), i);
+    }
+    indexed_ = true;
+  }
+
+  //! Return the first Metadatum matching \em handle or end()
+  [[nodiscard]] ExifData::const_iterator find(const KeyHandle& handle) const {
+    if (pending_ && Internal::isMakerIfd(handle.ifdId_)) {
+      // The lookup of a makernote key decodes a makernote read with MakerNotePolicy::lazy, which adds its tags
+      pending_ = false;
+      const size_t count = ed_.count();
+      auto pos = ed_.findKey(ExifKey(handle.tag_, handle.ifdId_));
+      if (ed_.count() != count)
+        indexed_ = false;  // the index misses the makernote tags
+      return pos;
+    }
+    if (!indexed_)
+      return std::find_if(ed_.begin(), ed_.end(), [&handle](const Exifdatum& md) { return handle.matches(md); });
+    auto pos = index_.find(handle.packed());
+    return pos == index_.end() ? ed_.end() : pos->second;
+  }
+
+  [[nodiscard]] const ExifData& exifData() const {
+    return ed_;
+  }
+
+ private:
+  const ExifData& ed_;
+  mutable bool pending_;
+  mutable bool indexed_{false};
+  std::unordered_map<uint64_t, ExifData::const_iterator> index_;
+};
+
+/*!
+  @brief Search for a Metadatum specified by the \em handles.
+         The \em handles are searched in the order of their appearance, the
          first available Metadatum is returned.
 
-  @param ed The %Exif metadata container to search
-  @param keys Array of keys to look for
+  @param kf Finder for the %Exif metadata container to search
+  @param handles Array of key handles to look for
   @param count Number of elements in the array
  */
-ExifData::const_iterator findMetadatum(const ExifData& ed, const char* const keys[], size_t count) {
+ExifData::const_iterator findMetadatum(const KeyFinder& kf, const KeyHandle* handles, size_t count) {
   for (size_t i = 0; i < count; ++i) {
-    auto pos = ed.findKey(ExifKey(keys[i]));
-    if (pos != ed.end())
+    auto pos = kf.find(handles[i]);
+    if (pos != kf.exifData().end())
       return pos;
   }
-  return ed.end();
+  return kf.exifData().end();
 }  // findMetadatum
 
 /*!
-  @brief Search \em ed for a Metadatum specified by the \em keys.
-         The \em keys are searched in the order of their appearance, the
+  @brief Search for a Metadatum specified by the \em handles.
+         The \em handles are searched in the order of their appearance, the
          first available Metadatum is returned, except it is in NikonLd4
          and its value 0.
          Example: Exif.NikonLd4.LensID and Exif.NikonLd4.LensIDNumber are
          usually together included, one of them has value 0 (which means
          undefined), so skip tag with value 0.
 
-  @param ed The %Exif metadata container to search
-  @param keys Array of keys to look for
+  @param kf Finder for the %Exif metadata container to search
+  @param handles Array of key handles to look for
   @param count Number of elements in the array
  */
-ExifData::const_iterator findMetadatumSkip0inNikonLd4(const ExifData& ed, const char* const keys[], size_t count) {
+ExifData::const_iterator findMetadatumSkip0inNikonLd4(const KeyFinder& kf, const KeyHandle* handles, size_t count) {
   for (size_t i = 0; i < count; ++i) {
-    auto pos = ed.findKey(ExifKey(keys[i]));
-    if (pos != ed.end()) {
-      if (strncmp(keys[i], "Exif.NikonLd4", 13) != 0 || pos->getValue()->toInt64(0) > 0)
+    auto pos = kf.find(handles[i]);
+    if (pos != kf.exifData().end()) {
+      if (handles[i].ifdId_ != IfdId::nikonLd4Id || pos->getValue()->toInt64(0) > 0)
         return pos;
     }
   }
-  return ed.end();
+  return kf.exifData().end();
 }  // findMetadatumSkip0inNikonLd4
-}  // anonymous namespace
 
 // *****************************************************************************
-// class member definitions
-namespace Exiv2 {
-ExifData::const_iterator orientation(const ExifData& ed) {
+// Candidate lists and resolution rules of the easy access functions
+ExifData::const_iterator findOrientation(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Image.Orientation",
       "Exif.Panasonic.Rotation",
@@ -75,10 +161,11 @@ ExifData::const_iterator orientation(const ExifData& ed) {
       "Exif.Sony1MltCsA100.Rotation",
       "Exif.SonyMisc3c.CameraOrientation",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator isoSpeed(const ExifData& ed) {
+ExifData::const_iterator findIsoSpeed(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ISOSpeedRatings",
       "Exif.Image.ISOSpeedRatings",
@@ -114,6 +201,11 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
     const char* keys[3];
   };
 
+  struct SensKeyHandleList {
+    int count;
+    std::array<KeyHandle, 3> handles;
+  };
+
   // covers Exif.Phot.SensitivityType values 1-7. Note that SOS, REI and
   // ISO do differ in their meaning. Values coming first in a list (and
   // existing as a tag) are picked up first and used as the "ISO" value.
@@ -131,12 +223,25 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
       "Exif.Photo.SensitivityType",
   };
 
+  static const auto handles = compileKeys(keys);
+  static const auto sensitivityTypeHandles = compileKeys(sensitivityType);
+  static const auto sensitivityHandles = [] {
+    std::array<SensKeyHandleList, std::size(sensitivityKey)> lists{};
+    for (size_t i = 0; i < lists.size(); ++i) {
+      lists[i].count = sensitivityKey[i].count;
+      for (int j = 0; j < sensitivityKey[i].count; ++j)
+        lists[i].handles[j] = KeyHandle(sensitivityKey[i].keys[j]);
+    }
+    return lists;
+  }();
+  const ExifData& ed = kf.exifData();
+
   // Find the first ISO value which is not "0"
   const size_t cnt = std::size(keys);
   auto md = ed.end();
   int64_t iso_val = -1;
   for (size_t idx = 0; idx < cnt;) {
-    md = findMetadatum(ed, keys + idx, cnt - idx);
+    md = findMetadatum(kf, handles.data() + idx, cnt - idx);
     if (md == ed.end())
       break;
     std::ostringstream os;
@@ -147,7 +252,7 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
     iso_val = parseInt64(os.str(), ok);
     if (ok && iso_val > 0)
       break;
-    while (md->key() != keys[idx++] && idx < cnt) {
+    while (!handles[idx++].matches(*md) && idx < cnt) {
     }
     md = ed.end();
   }
@@ -157,7 +262,7 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
   // ISO value (see EXIF 2.3 Annex G)
   int64_t iso_tmp_val = -1;
   while (iso_tmp_val == -1 && (iso_val == 65535 || md == ed.end())) {
-    auto md_st = findMetadatum(ed, sensitivityType, std::size(sensitivityType));
+    auto md_st = findMetadatum(kf, sensitivityTypeHandles.data(), sensitivityTypeHandles.size());
     // no SensitivityType? exit with existing data
     if (md_st == ed.end())
       break;
@@ -171,10 +276,10 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
       break;
     // pick up list of ISO tags, and check for at least one of
     // them available.
-    const SensKeyNameList* sensKeys = &sensitivityKey[st_val - 1];
+    const SensKeyHandleList* sensKeys = &sensitivityHandles[st_val - 1];
     md_st = ed.end();
     for (int idx = 0; idx < sensKeys->count; md_st = ed.end()) {
-      md_st = findMetadatum(ed, sensKeys->keys, sensKeys->count);
+      md_st = findMetadatum(kf, sensKeys->handles.data(), sensKeys->count);
       if (md_st == ed.end())
         break;
       std::ostringstream os_iso;
@@ -186,7 +291,7 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
         md = md_st;
         break;
       }
-      while (md_st->key() != sensKeys->keys[idx++] && idx < sensKeys->count) {
+      while (!sensKeys->handles[idx++].matches(*md_st) && idx < sensKeys->count) {
       }
     }
     break;
@@ -195,24 +300,26 @@ ExifData::const_iterator isoSpeed(const ExifData& ed) {
   return md;
 }
 
-ExifData::const_iterator dateTimeOriginal(const ExifData& ed) {
+ExifData::const_iterator findDateTimeOriginal(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.DateTimeOriginal",
       "Exif.Image.DateTimeOriginal",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator flashBias(const ExifData& ed) {
+ExifData::const_iterator findFlashBias(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonSi.FlashBias",           "Exif.Panasonic.FlashBias",       "Exif.Olympus.FlashBias",
       "Exif.OlympusCs.FlashExposureComp", "Exif.Minolta.FlashExposureComp", "Exif.SonyMinolta.FlashExposureComp",
       "Exif.Sony1.FlashExposureComp",     "Exif.Sony2.FlashExposureComp",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator exposureMode(const ExifData& ed) {
+ExifData::const_iterator findExposureMode(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ExposureProgram",     "Exif.Image.ExposureProgram",       "Exif.CanonCs.ExposureProgram",
       "Exif.MinoltaCs7D.ExposureMode",  "Exif.MinoltaCs5D.ExposureMode",    "Exif.MinoltaCsNew.ExposureMode",
@@ -221,10 +328,11 @@ ExifData::const_iterator exposureMode(const ExifData& ed) {
       "Exif.Sony2Cs.ExposureProgram",   "Exif.Sony1MltCsA100.ExposureMode", "Exif.SonyMisc2b.ExposureProgram",
       "Exif.Sigma.ExposureMode",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator sceneMode(const ExifData& ed) {
+ExifData::const_iterator findSceneMode(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonCs.EasyMode",
       "Exif.Fujifilm.PictureMode",
@@ -240,19 +348,21 @@ ExifData::const_iterator sceneMode(const ExifData& ed) {
       "Exif.Pentax.PictureMode",
       "Exif.PentaxDng.PictureMode",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator macroMode(const ExifData& ed) {
+ExifData::const_iterator findMacroMode(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonCs.Macro",       "Exif.Fujifilm.Macro",  "Exif.Olympus.Macro",          "Exif.Olympus2.Macro",
       "Exif.OlympusCs.MacroMode", "Exif.Panasonic.Macro", "Exif.MinoltaCsNew.MacroMode", "Exif.MinoltaCsOld.MacroMode",
       "Exif.Sony1.Macro",         "Exif.Sony2.Macro",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator imageQuality(const ExifData& ed) {
+ExifData::const_iterator findImageQuality(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonCs.Quality",        "Exif.Fujifilm.Quality",    "Exif.Sigma.Quality",
       "Exif.Nikon1.Quality",         "Exif.Nikon2.Quality",      "Exif.Nikon3.Quality",
@@ -266,10 +376,11 @@ ExifData::const_iterator imageQuality(const ExifData& ed) {
       "Exif.Sony1MltCsA100.Quality", "Exif.Casio.Quality",       "Exif.Casio2.QualityMode",
       "Exif.Casio2.Quality",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator whiteBalance(const ExifData& ed) {
+ExifData::const_iterator findWhiteBalance(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonSi.WhiteBalance",      "Exif.Fujifilm.WhiteBalance",    "Exif.Sigma.WhiteBalance",
       "Exif.Nikon1.WhiteBalance",       "Exif.Nikon2.WhiteBalance",      "Exif.Nikon3.WhiteBalance",
@@ -281,10 +392,11 @@ ExifData::const_iterator whiteBalance(const ExifData& ed) {
       "Exif.SonyMinolta.WhiteBalance",  "Exif.Casio.WhiteBalance",       "Exif.Casio2.WhiteBalance",
       "Exif.Casio2.WhiteBalance2",      "Exif.Photo.WhiteBalance",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator lensName(const ExifData& ed) {
+ExifData::const_iterator findLensName(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       // Try Exif.CanonCs.LensType first.
       // Exif.OlympusEq.LensType and Exif.Pentax.LensType in most cases give better information than
@@ -301,11 +413,12 @@ ExifData::const_iterator lensName(const ExifData& ed) {
       "Exif.Samsung2.LensType",     "Exif.Photo.LensSpecification",
       "Exif.Nikon3.Lens",
   };
+  static const auto handles = compileKeys(keys);
 
-  return findMetadatumSkip0inNikonLd4(ed, keys, std::size(keys));
+  return findMetadatumSkip0inNikonLd4(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator saturation(const ExifData& ed) {
+ExifData::const_iterator findSaturation(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.Saturation",        "Exif.CanonCs.Saturation",     "Exif.MinoltaCsNew.Saturation",
       "Exif.MinoltaCsOld.Saturation", "Exif.MinoltaCs7D.Saturation", "Exif.MinoltaCs5D.Saturation",
@@ -315,10 +428,11 @@ ExifData::const_iterator saturation(const ExifData& ed) {
       "Exif.Sony2.Saturation",        "Exif.Casio.Saturation",       "Exif.Casio2.Saturation",
       "Exif.Casio2.Saturation2",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator sharpness(const ExifData& ed) {
+ExifData::const_iterator findSharpness(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.Sharpness",        "Exif.CanonCs.Sharpness",       "Exif.Fujifilm.Sharpness",
       "Exif.MinoltaCsNew.Sharpness", "Exif.MinoltaCsOld.Sharpness",  "Exif.MinoltaCs7D.Sharpness",
@@ -327,10 +441,11 @@ ExifData::const_iterator sharpness(const ExifData& ed) {
       "Exif.Sony1.Sharpness",        "Exif.Sony2.Sharpness",         "Exif.Casio.Sharpness",
       "Exif.Casio2.Sharpness",       "Exif.Casio2.Sharpness2",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator contrast(const ExifData& ed) {
+ExifData::const_iterator findContrast(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.Contrast",        "Exif.CanonCs.Contrast",      "Exif.Fujifilm.Tone",
       "Exif.MinoltaCsNew.Contrast", "Exif.MinoltaCsOld.Contrast", "Exif.MinoltaCs7D.Contrast",
@@ -339,18 +454,20 @@ ExifData::const_iterator contrast(const ExifData& ed) {
       "Exif.Sony1.Contrast",        "Exif.Sony2.Contrast",        "Exif.Casio.Contrast",
       "Exif.Casio2.Contrast",       "Exif.Casio2.Contrast2",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator sceneCaptureType(const ExifData& ed) {
+ExifData::const_iterator findSceneCaptureType(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.SceneCaptureType",
       "Exif.Olympus.SpecialMode",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator meteringMode(const ExifData& ed) {
+ExifData::const_iterator findMeteringMode(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.MeteringMode",       "Exif.Image.MeteringMode",        "Exif.CanonCs.MeteringMode",
       "Exif.MinoltaCs5D.MeteringMode", "Exif.MinoltaCsOld.MeteringMode", "Exif.OlympusCs.MeteringMode",
@@ -358,18 +475,20 @@ ExifData::const_iterator meteringMode(const ExifData& ed) {
       "Exif.Sony1.MeteringMode2",      "Exif.Sony1Cs.MeteringMode",      "Exif.Sony1Cs2.MeteringMode",
       "Exif.Sony2.MeteringMode2",      "Exif.Sony2Cs.MeteringMode",      "Exif.Sony1MltCsA100.MeteringMode",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator make(const ExifData& ed) {
+ExifData::const_iterator findMake(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Image.Make",
       "Exif.PanasonicRaw.Make",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator model(const ExifData& ed) {
+ExifData::const_iterator findModel(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Image.Model",
       "Exif.MinoltaCsOld.MinoltaModel",
@@ -380,71 +499,79 @@ ExifData::const_iterator model(const ExifData& ed) {
       "Exif.Sony1.SonyModelID",
       "Exif.Sony2.SonyModelID",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator exposureTime(const ExifData& ed) {
+ExifData::const_iterator findExposureTime(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ExposureTime",     "Exif.Image.ExposureTime",    "Exif.Pentax.ExposureTime",
       "Exif.PentaxDng.ExposureTime", "Exif.Samsung2.ExposureTime",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator fNumber(const ExifData& ed) {
+ExifData::const_iterator findFNumber(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.FNumber",     "Exif.Image.FNumber",    "Exif.Pentax.FNumber",
       "Exif.PentaxDng.FNumber", "Exif.Samsung2.FNumber",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator shutterSpeedValue(const ExifData& ed) {
+ExifData::const_iterator findShutterSpeedValue(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ShutterSpeedValue",
       "Exif.Image.ShutterSpeedValue",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator apertureValue(const ExifData& ed) {
+ExifData::const_iterator findApertureValue(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ApertureValue",
       "Exif.Image.ApertureValue",
       "Exif.CanonSi.ApertureValue",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator brightnessValue(const ExifData& ed) {
+ExifData::const_iterator findBrightnessValue(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.BrightnessValue",
       "Exif.Image.BrightnessValue",
       "Exif.Sony1.Brightness",
       "Exif.Sony2.Brightness",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator exposureBiasValue(const ExifData& ed) {
+ExifData::const_iterator findExposureBiasValue(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ExposureBiasValue",     "Exif.Image.ExposureBiasValue",      "Exif.MinoltaCs5D.ExposureManualBias",
       "Exif.OlympusRd.ExposureBiasValue", "Exif.OlympusRd2.ExposureBiasValue",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator maxApertureValue(const ExifData& ed) {
+ExifData::const_iterator findMaxApertureValue(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.MaxApertureValue",
       "Exif.Image.MaxApertureValue",
       "Exif.CanonCs.MaxAperture",
       "Exif.NikonLd4.MaxAperture",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator subjectDistance(const ExifData& ed) {
+ExifData::const_iterator findSubjectDistance(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.SubjectDistance",      "Exif.Image.SubjectDistance",      "Exif.CanonSi.SubjectDistance",
       "Exif.CanonFi.FocusDistanceUpper", "Exif.CanonFi.FocusDistanceLower", "Exif.MinoltaCsNew.FocusDistance",
@@ -453,26 +580,29 @@ ExifData::const_iterator subjectDistance(const ExifData& ed) {
       "Exif.Olympus.FocusDistance",      "Exif.OlympusFi.FocusDistance",    "Exif.Casio.ObjectDistance",
       "Exif.Casio2.ObjectDistance",
   };
-  return findMetadatumSkip0inNikonLd4(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatumSkip0inNikonLd4(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator lightSource(const ExifData& ed) {
+ExifData::const_iterator findLightSource(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.LightSource",
       "Exif.Image.LightSource",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator flash(const ExifData& ed) {
+ExifData::const_iterator findFlash(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.Flash",     "Exif.Image.Flash",       "Exif.Pentax.Flash",
       "Exif.PentaxDng.Flash", "Exif.Sony1.FlashAction", "Exif.Sony2.FlashAction",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator serialNumber(const ExifData& ed) {
+ExifData::const_iterator findSerialNumber(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       // first check Exif.Canon.SerialNumber, because some Canon images contain a wrong value in
       // Exif.Photo.BodySerialNumber
@@ -482,52 +612,58 @@ ExifData::const_iterator serialNumber(const ExifData& ed) {
       "Exif.PentaxDng.SerialNumber", "Exif.Sigma.SerialNumber",       "Exif.Sony1.SerialNumber",
       "Exif.Sony2.SerialNumber",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator focalLength(const ExifData& ed) {
+ExifData::const_iterator findFocalLength(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.FocalLength",        "Exif.Image.FocalLength",    "Exif.Canon.FocalLength",
       "Exif.NikonLd2.FocalLength",     "Exif.NikonLd3.FocalLength", "Exif.NikonLd4.FocalLength2",
       "Exif.MinoltaCsNew.FocalLength", "Exif.Pentax.FocalLength",   "Exif.PentaxDng.FocalLength",
       "Exif.Casio2.FocalLength",
   };
-  return findMetadatumSkip0inNikonLd4(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatumSkip0inNikonLd4(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator subjectArea(const ExifData& ed) {
+ExifData::const_iterator findSubjectArea(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.SubjectArea",
       "Exif.Image.SubjectLocation",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator flashEnergy(const ExifData& ed) {
+ExifData::const_iterator findFlashEnergy(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.FlashEnergy",
       "Exif.Image.FlashEnergy",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator exposureIndex(const ExifData& ed) {
+ExifData::const_iterator findExposureIndex(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.ExposureIndex",
       "Exif.Image.ExposureIndex",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator sensingMethod(const ExifData& ed) {
+ExifData::const_iterator findSensingMethod(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.Photo.SensingMethod",
       "Exif.Image.SensingMethod",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
 }
 
-ExifData::const_iterator afPoint(const ExifData& ed) {
+ExifData::const_iterator findAfPoint(const KeyFinder& kf) {
   static constexpr const char* keys[] = {
       "Exif.CanonPi.AFPointsUsed",
       "Exif.CanonPi.AFPointsUsed20D",
@@ -554,7 +690,189 @@ ExifData::const_iterator afPoint(const ExifData& ed) {
       "Exif.Casio.AFPoint",
       "Exif.Casio2.AFPointPosition",
   };
-  return findMetadatum(ed, keys, std::size(keys));
+  static const auto handles = compileKeys(keys);
+  return findMetadatum(kf, handles.data(), handles.size());
+}
+}  // anonymous namespace
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2 {
+ExifData::const_iterator orientation(const ExifData& ed) {
+  return findOrientation(KeyFinder(ed));
+}
+
+ExifData::const_iterator isoSpeed(const ExifData& ed) {
+  return findIsoSpeed(KeyFinder(ed));
+}
+
+ExifData::const_iterator dateTimeOriginal(const ExifData& ed) {
+  return findDateTimeOriginal(KeyFinder(ed));
+}
+
+ExifData::const_iterator flashBias(const ExifData& ed) {
+  return findFlashBias(KeyFinder(ed));
+}
+
+ExifData::const_iterator exposureMode(const ExifData& ed) {
+  return findExposureMode(KeyFinder(ed));
+}
+
+ExifData::const_iterator sceneMode(const ExifData& ed) {
+  return findSceneMode(KeyFinder(ed));
+}
+
+ExifData::const_iterator macroMode(const ExifData& ed) {
+  return findMacroMode(KeyFinder(ed));
+}
+
+ExifData::const_iterator imageQuality(const ExifData& ed) {
+  return findImageQuality(KeyFinder(ed));
+}
+
+ExifData::const_iterator whiteBalance(const ExifData& ed) {
+  return findWhiteBalance(KeyFinder(ed));
+}
+
+ExifData::const_iterator lensName(const ExifData& ed) {
+  return findLensName(KeyFinder(ed));
+}
+
+ExifData::const_iterator saturation(const ExifData& ed) {
+  return findSaturation(KeyFinder(ed));
+}
+
+ExifData::const_iterator sharpness(const ExifData& ed) {
+  return findSharpness(KeyFinder(ed));
+}
+
+ExifData::const_iterator contrast(const ExifData& ed) {
+  return findContrast(KeyFinder(ed));
+}
+
+ExifData::const_iterator sceneCaptureType(const ExifData& ed) {
+  return findSceneCaptureType(KeyFinder(ed));
+}
+
+ExifData::const_iterator meteringMode(const ExifData& ed) {
+  return findMeteringMode(KeyFinder(ed));
+}
+
+ExifData::const_iterator make(const ExifData& ed) {
+  return findMake(KeyFinder(ed));
+}
+
+ExifData::const_iterator model(const ExifData& ed) {
+  return findModel(KeyFinder(ed));
+}
+
+ExifData::const_iterator exposureTime(const ExifData& ed) {
+  return findExposureTime(KeyFinder(ed));
+}
+
+ExifData::const_iterator fNumber(const ExifData& ed) {
+  return findFNumber(KeyFinder(ed));
+}
+
+ExifData::const_iterator shutterSpeedValue(const ExifData& ed) {
+  return findShutterSpeedValue(KeyFinder(ed));
+}
+
+ExifData::const_iterator apertureValue(const ExifData& ed) {
+  return findApertureValue(KeyFinder(ed));
+}
+
+ExifData::const_iterator brightnessValue(const ExifData& ed) {
+  return findBrightnessValue(KeyFinder(ed));
+}
+
+ExifData::const_iterator exposureBiasValue(const ExifData& ed) {
+  return findExposureBiasValue(KeyFinder(ed));
+}
+
+ExifData::const_iterator maxApertureValue(const ExifData& ed) {
+  return findMaxApertureValue(KeyFinder(ed));
+}
+
+ExifData::const_iterator subjectDistance(const ExifData& ed) {
+  return findSubjectDistance(KeyFinder(ed));
+}
+
+ExifData::const_iterator lightSource(const ExifData& ed) {
+  return findLightSource(KeyFinder(ed));
+}
+
+ExifData::const_iterator flash(const ExifData& ed) {
+  return findFlash(KeyFinder(ed));
+}
+
+ExifData::const_iterator serialNumber(const ExifData& ed) {
+  return findSerialNumber(KeyFinder(ed));
+}
+
+ExifData::const_iterator focalLength(const ExifData& ed) {
+  return findFocalLength(KeyFinder(ed));
+}
+
+ExifData::const_iterator subjectArea(const ExifData& ed) {
+  return findSubjectArea(KeyFinder(ed));
+}
+
+ExifData::const_iterator flashEnergy(const ExifData& ed) {
+  return findFlashEnergy(KeyFinder(ed));
+}
+
+ExifData::const_iterator exposureIndex(const ExifData& ed) {
+  return findExposureIndex(KeyFinder(ed));
+}
+
+ExifData::const_iterator sensingMethod(const ExifData& ed) {
+  return findSensingMethod(KeyFinder(ed));
+}
+
+ExifData::const_iterator afPoint(const ExifData& ed) {
+  return findAfPoint(KeyFinder(ed));
+}
+
+EasyAccessData easyAccess(const ExifData& ed) {
+  KeyFinder kf(ed);
+  kf.buildIndex();
+  EasyAccessData data;
+  data.orientation = findOrientation(kf);
+  data.isoSpeed = findIsoSpeed(kf);
+  data.dateTimeOriginal = findDateTimeOriginal(kf);
+  data.flashBias = findFlashBias(kf);
+  data.exposureMode = findExposureMode(kf);
+  data.sceneMode = findSceneMode(kf);
+  data.macroMode = findMacroMode(kf);
+  data.imageQuality = findImageQuality(kf);
+  data.whiteBalance = findWhiteBalance(kf);
+  data.lensName = findLensName(kf);
+  data.saturation = findSaturation(kf);
+  data.sharpness = findSharpness(kf);
+  data.contrast = findContrast(kf);
+  data.sceneCaptureType = findSceneCaptureType(kf);
+  data.meteringMode = findMeteringMode(kf);
+  data.make = findMake(kf);
+  data.model = findModel(kf);
+  data.exposureTime = findExposureTime(kf);
+  data.fNumber = findFNumber(kf);
+  data.shutterSpeedValue = findShutterSpeedValue(kf);
+  data.apertureValue = findApertureValue(kf);
+  data.brightnessValue = findBrightnessValue(kf);
+  data.exposureBiasValue = findExposureBiasValue(kf);
+  data.maxApertureValue = findMaxApertureValue(kf);
+  data.subjectDistance = findSubjectDistance(kf);
+  data.lightSource = findLightSource(kf);
+  data.flash = findFlash(kf);
+  data.serialNumber = findSerialNumber(kf);
+  data.focalLength = findFocalLength(kf);
+  data.subjectArea = findSubjectArea(kf);
+  data.flashEnergy = findFlashEnergy(kf);
+  data.exposureIndex = findExposureIndex(kf);
+  data.sensingMethod = findSensingMethod(kf);
+  data.afPoint = findAfPoint(kf);
+  return data;
 }
 
 }  // namespace Exiv2
@@ -28,6 +28,9 @@
 #include <array>
 #include <cstdio>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <set>
 #include <utility>
 
 // *****************************************************************************
@@ -36,20 +39,68 @@ namespace {
 class FindExifdatumByKey {
  public:
   //! Constructor, initializes the object with the key to look for
-  explicit FindExifdatumByKey(std::string key) : key_(std::move(key)) {
+  explicit FindExifdatumByKey(const Exiv2::ExifKey& key) : tag_(key.tag()), ifdId_(key.ifdId()) {
   }
   /*!
     @brief Returns true if the key of \em exifdatum is equal
-           to that of the object.
+           to that of the object. Keys are compared by their
+           (IfdId, tag) identity, the key strings are not built.
   */
   bool operator()(const Exiv2::Exifdatum& exifdatum) const {
-    return key_ == exifdatum.key();
+    return tag_ == exifdatum.tag() && ifdId_ == exifdatum.ifdId();
   }
 
  private:
-  std::string key_;
+  uint16_t tag_;
+  Exiv2::IfdId ifdId_;
 };  // class FindExifdatumByKey
 
+//! Return the value of \em exifdatum if it is a makernote which was not decoded yet, else nullptr
+const Exiv2::Internal::PendingMakerNote* pendingMakerNote(const Exiv2::Exifdatum& exifdatum) {
+  if (exifdatum.tag() != 0x927c || exifdatum.ifdId() != Exiv2::IfdId::exifId ||
+      exifdatum.typeId() != Exiv2::undefined)
+    return nullptr;
+  return dynamic_cast<const Exiv2::Internal::PendingMakerNote*>(&exifdatum.value());
+}
+
+//! Return true if \em exifdatum is a makernote which was not decoded yet
+bool isPendingMakerNote(const Exiv2::Exifdatum& exifdatum) {
+  return pendingMakerNote(exifdatum) != nullptr;
+}
+
+/*!
+  @brief Decode the pending makernote at \em mn and insert its tags after it.
+         Tags which are already in \em exifMetadata, because they were set
+         while the makernote was pending, are not replaced.
+ */
+void decodeMakerNote(Exiv2::ExifMetadata& exifMetadata, Exiv2::ExifMetadata::iterator mn) {
+  auto pending = pendingMakerNote(*mn);
+  const Exiv2::ExifData exifData = pending->decode();
+  // Replace the value with a plain one, also if the makernote could not be decoded
+  const Exiv2::DataValue value = *pending;
+  mn->setValue(&value);
+
+  std::set<std::pair<Exiv2::IfdId, uint16_t>> keys;
+  for (auto&& md : exifMetadata) {
+    if (Exiv2::Internal::isMakerIfd(md.ifdId()))
+      keys.emplace(md.ifdId(), md.tag());
+  }
+  auto pos = std::next(mn);
+  for (auto&& md : exifData) {
+    if (Exiv2::Internal::isMakerIfd(md.ifdId()) && !keys.contains({md.ifdId(), md.tag()}))
+      exifMetadata.insert(pos, md);
+  }
+}
+
+//! Decode a makernote which was read with MakerNotePolicy::lazy and is still pending, return true if there was one
+bool decodeLazyMakerNote(Exiv2::ExifMetadata& exifMetadata) {
+  auto mn = std::find_if(exifMetadata.begin(), exifMetadata.end(), isPendingMakerNote);
+  if (mn == exifMetadata.end() || !pendingMakerNote(*mn)->onAccess())
+    return false;
+  decodeMakerNote(exifMetadata, mn);
+  return true;
+}
+
 /*!
   @brief Exif %Thumbnail image. This abstract base class provides the
          interface for the thumbnail image that is optionally embedded in
@@ -408,6 +459,65 @@ const char* ExifThumbC::extension() const {
   return thumbnail->extension();
 }
 
+std::pair<size_t, size_t> ExifThumbC::findJpeg(const byte* pData, size_t size) {
+  // The checks follow those of TiffReader and TiffDataEntry::setStrips, so that
+  // a thumbnail is only found where decoding the data finds it
+  constexpr std::pair<size_t, size_t> notFound{0, 0};
+  if (!pData || size < 8)
+    return notFound;
+  ByteOrder byteOrder = invalidByteOrder;
+  if (pData[0] == 'I' && pData[1] == 'I')
+    byteOrder = littleEndian;
+  else if (pData[0] == 'M' && pData[1] == 'M')
+    byteOrder = bigEndian;
+  if (byteOrder == invalidByteOrder || getUShort(pData + 2, byteOrder) != 42)
+    return notFound;
+
+  // Skip the entries of IFD0 to its next pointer
+  const size_t ifd0 = getULong(pData + 4, byteOrder);
+  if (ifd0 > size - 2)
+    return notFound;
+  const size_t count0 = getUShort(pData + ifd0, byteOrder);
+  if (count0 > 256 || size - ifd0 - 2 < count0 * 12 + 4)
+    return notFound;
+  const size_t ifd1 = getULong(pData + ifd0 + 2 + count0 * 12, byteOrder);
+  if (ifd1 == 0 || ifd1 == ifd0 || ifd1 > size - 2)
+    return notFound;
+  const size_t count1 = getUShort(pData + ifd1, byteOrder);
+  if (count1 > 256)
+    return notFound;
+
+  std::optional<uint32_t> compression;
+  std::optional<uint32_t> offset;
+  std::optional<uint32_t> length;
+  const byte* entry = pData + ifd1 + 2;
+  for (size_t i = 0; i < count1 && static_cast<size_t>(entry - pData) + 12 <= size; ++i, entry += 12) {
+    std::optional<uint32_t>* value = nullptr;
+    switch (getUShort(entry, byteOrder)) {
+      case 0x0103:
+        value = &compression;
+        break;
+      case 0x0201:
+        value = &offset;
+        break;
+      case 0x0202:
+        value = &length;
+        break;
+      default:
+        continue;
+    }
+    // Leave duplicate tags, arrays and unusual types to the decoder
+    const uint16_t type = getUShort(entry + 2, byteOrder);
+    if (value->has_value() || getULong(entry + 4, byteOrder) != 1 || (type != unsignedShort && type != unsignedLong))
+      return notFound;
+    *value = type == unsignedShort ? getUShort(entry + 8, byteOrder) : getULong(entry + 8, byteOrder);
+  }
+
+  if ((compression && *compression != 6) || !offset || !length || *length > size || *offset > size - *length)
+    return notFound;
+  return {*offset, *length};
+}
+
 ExifThumb::ExifThumb(ExifData& exifData) : ExifThumbC(exifData), exifData_(exifData) {
 }
 
@@ -463,11 +573,27 @@ void ExifData::add(const Exifdatum& exifdatum) {
 }
 
 ExifData::const_iterator ExifData::findKey(const ExifKey& key) const {
-  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  auto pos = std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key));
+  if (pos != exifMetadata_.end() || !isMakerIfd(key.ifdId()) || !decodeLazyMakerNote(exifMetadata_))
+    return pos;
+  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key));
 }
 
 ExifData::iterator ExifData::findKey(const ExifKey& key) {
-  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  auto pos = std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key));
+  if (pos != exifMetadata_.end() || !isMakerIfd(key.ifdId()) || !decodeLazyMakerNote(exifMetadata_))
+    return pos;
+  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key));
+}
+
+void ExifData::decodeMakerNote() {
+  auto mn = std::find_if(exifMetadata_.begin(), exifMetadata_.end(), isPendingMakerNote);
+  if (mn != exifMetadata_.end())
+    ::decodeMakerNote(exifMetadata_, mn);
+}
+
+bool ExifData::makerNotePending() const {
+  return std::any_of(exifMetadata_.begin(), exifMetadata_.end(), isPendingMakerNote);
 }
 
 void ExifData::clear() {
@@ -490,10 +616,10 @@ ExifData::iterator ExifData::erase(ExifData::iterator pos) {
   return exifMetadata_.erase(pos);
 }
 
-ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size) {
+ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size, MakerNotePolicy mnPolicy) {
   IptcData iptcData;
   XmpData xmpData;
-  ByteOrder bo = TiffParser::decode(exifData, iptcData, xmpData, pData, size);
+  ByteOrder bo = TiffParser::decode(exifData, iptcData, xmpData, pData, size, mnPolicy);
 #ifndef SUPPRESS_WARNINGS
   if (!iptcData.empty()) {
     EXV_WARNING << "Ignoring IPTC information encoded in the Exif data.\n";
@@ -539,7 +665,8 @@ WriteMethod ExifParser::encode(Blob& blob, const byte* pData, size_t size, ByteO
       "Exif.Canon.AFFineRotation",
   };
   for (auto&& filteredIfd0Tag : filteredIfd0Tags) {
-    auto pos = exifData.findKey(ExifKey(filteredIfd0Tag));
+    // Not findKey(), which would decode a pending makernote for the Canon tags
+    auto pos = std::find_if(exifData.begin(), exifData.end(), FindExifdatumByKey(ExifKey(filteredIfd0Tag)));
     if (pos != exifData.end()) {
 #ifdef EXIV2_DEBUG_MESSAGES
       std::cerr << "Warning: Exif tag " << pos->key() << " not encoded\n";
@@ -575,7 +702,9 @@ WriteMethod ExifParser::encode(Blob& blob, const byte* pData, size_t size, ByteO
     return wm;
   }
 
-  // If it doesn't fit, remove additional tags
+  // If it doesn't fit, remove additional tags. The filters below must see the makernote tags, if they were not
+  // decoded yet
+  exifData.decodeMakerNote();
 
   // Delete preview tags if the preview is larger than 32kB.
   // Todo: Enhance preview classes to be able to write and delete previews and use that instead.
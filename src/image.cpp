@@ -11,6 +11,7 @@
 #include "image_int.hpp"
 #include "safe_op.hpp"
 #include "slice.hpp"
+#include "stats_int.hpp"
 
 #ifdef EXV_ENABLE_BMFF
 #include "bmffimage.hpp"
@@ -136,8 +137,19 @@ std::string pathOfFileUrl(const std::string& url) {
 // *****************************************************************************
 // class member definitions
 namespace Exiv2 {
+//! Internal Pimpl structure of class Image.
+class Image::Impl {
+ public:
+  // DATA
+  uint16_t readFilter_{mdExif | mdIptc | mdComment | mdXmp | mdIccProfile};  //!< Metadata decoded by readMetadata()
+  MakerNotePolicy makerNotePolicy_{MakerNotePolicy::full};                   //!< Makernote handling of readMetadata()
+  bool stopAtImageData_{false};                                              //!< readMetadata() stops at the image data
+  bool stoppedAtImageData_{false};                                           //!< The last read stopped at the image data
+  int compressionLevel_{-1};                                                 //!< Compression level of writeMetadata()
+};
+
 Image::Image(ImageType type, uint16_t supportedMetadata, BasicIo::UniquePtr io) :
-    io_(std::move(io)), imageType_(type), supportedMetadata_(supportedMetadata) {
+    io_(std::move(io)), imageType_(type), supportedMetadata_(supportedMetadata), p_(std::make_unique<Impl>()) {
 }
 
 Image::~Image() = default;
@@ -146,6 +158,24 @@ void Image::printStructure(std::ostream&, PrintStructureOption, size_t /*depth*/
   throw Error(ErrorCode::kerUnsupportedImageType, io_->path());
 }
 
+DataBuf Image::readExifThumbnail() {
+  // Dispatch on the type rather than through a virtual function, to keep the layout of the vtable
+  switch (imageType_) {
+    case ImageType::jpeg:
+    case ImageType::exv:
+      if (auto jpeg = dynamic_cast<JpegBase*>(this))
+        return jpeg->readExifThumbnail();
+      break;
+    case ImageType::tiff:
+      if (auto tiff = dynamic_cast<TiffImage*>(this))
+        return tiff->readExifThumbnail();
+      break;
+    default:
+      break;
+  }
+  return {};
+}
+
 bool Image::isStringType(uint16_t type) {
   return type == Exiv2::asciiString || type == Exiv2::unsignedByte || type == Exiv2::signedByte ||
          type == Exiv2::undefined;
@@ -715,6 +745,48 @@ bool Image::writeXmpFromPacket() const {
   return writeXmpFromPacket_;
 }
 
+void Image::setReadFilter(uint16_t metadataIds) {
+  p_->readFilter_ = metadataIds;
+}
+
+uint16_t Image::readFilter() const {
+  return p_->readFilter_;
+}
+
+void Image::setMakerNotePolicy(MakerNotePolicy mnPolicy) {
+  p_->makerNotePolicy_ = mnPolicy;
+}
+
+MakerNotePolicy Image::makerNotePolicy() const {
+  return p_->makerNotePolicy_;
+}
+
+void Image::setStopAtImageData(bool stop) {
+  p_->stopAtImageData_ = stop;
+}
+
+bool Image::stopAtImageData() const {
+  return p_->stopAtImageData_;
+}
+
+void Image::setCompressionLevel(int level) {
+  if (level < -1 || level > 9)
+    throw Error(ErrorCode::kerErrorMessage, "Invalid compression level " + std::to_string(level));
+  p_->compressionLevel_ = level;
+}
+
+int Image::compressionLevel() const {
+  return p_->compressionLevel_;
+}
+
+void Image::setStoppedAtImageData(bool stopped) {
+  p_->stoppedAtImageData_ = stopped;
+}
+
+bool Image::stoppedAtImageData() const {
+  return p_->stoppedAtImageData_;
+}
+
 const NativePreviewList& Image::nativePreviews() const {
   return nativePreviews_;
 }
@@ -795,6 +867,7 @@ ImageType ImageFactory::getType(const byte* data, size_t size) {
 }
 
 ImageType ImageFactory::getType(BasicIo& io) {
+  EXV_STATS_PHASE(typeDetection);
   if (io.open() != 0)
     return ImageType::none;
   IoCloser closer(io);
@@ -842,7 +915,14 @@ BasicIo::UniquePtr ImageFactory::createIo(const std::wstring& path) {
 #endif
 
 Image::UniquePtr ImageFactory::open(const std::string& path, bool useCurl) {
-  auto image = open(ImageFactory::createIo(path, useCurl));  // may throw
+  return open(path, useCurl, false);
+}
+
+Image::UniquePtr ImageFactory::open(const std::string& path, bool useCurl, bool traceIo) {
+  auto io = ImageFactory::createIo(path, useCurl);
+  if (traceIo)
+    io = std::make_unique<TracingIo>(std::move(io));
+  auto image = open(std::move(io));  // may throw
   if (!image)
     throw Error(ErrorCode::kerFileContainsUnknownImageType, path);
   return image;
@@ -871,6 +951,7 @@ Image::UniquePtr ImageFactory::open(BasicIo::UniquePtr io) {
   if (io->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io->path(), strError());
   }
+  EXV_STATS_PHASE(typeDetection);
   for (const auto& r : registry) {
     if (r.isThisType_(*io, false)) {
       return r.newInstance_(std::move(io), false);
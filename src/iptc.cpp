@@ -275,6 +275,10 @@ IptcData::iterator IptcData::erase(IptcData::iterator pos) {
   return iptcMetadata_.erase(pos);
 }
 
+size_t IptcData::eraseKey(const IptcKey& key) {
+  return std::erase_if(iptcMetadata_, FindIptcdatum(key.tag(), key.record()));
+}
+
 void IptcData::printStructure(std::ostream& out, const Slice<byte*>& bytes, size_t depth) {
   if (bytes.size() < 3) {
     return;
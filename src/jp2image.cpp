@@ -13,6 +13,7 @@
 #include "image_int.hpp"
 #include "jp2image_int.hpp"
 #include "safe_op.hpp"
+#include "stats_int.hpp"
 #include "tiffimage.hpp"
 #include "types.hpp"
 
@@ -132,6 +133,7 @@ void Jp2Image::setComment(const std::string&) {
 }
 
 void Jp2Image::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Exiv2::Jp2Image::readMetadata: Reading JPEG-2000 file " << io_->path() << '\n';
 #endif
@@ -273,9 +275,9 @@ void Jp2Image::readMetadata() {
         if (io_->read(reinterpret_cast<byte*>(&uuid), sizeof(uuid)) == sizeof(uuid)) {
           DataBuf rawData;
           size_t bufRead;
-          bool bIsExif = uuid.uuid == kJp2UuidExif;
-          bool bIsIPTC = uuid.uuid == kJp2UuidIptc;
-          bool bIsXMP = uuid.uuid == kJp2UuidXmp;
+          bool bIsExif = uuid.uuid == kJp2UuidExif && (readFilter() & mdExif);
+          bool bIsIPTC = uuid.uuid == kJp2UuidIptc && (readFilter() & mdIptc);
+          bool bIsXMP = uuid.uuid == kJp2UuidXmp && (readFilter() & mdXmp);
 
           if (bIsExif) {
 #ifdef EXIV2_DEBUG_MESSAGES
@@ -313,8 +315,8 @@ void Jp2Image::readMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
                 std::cout << "Exiv2::Jp2Image::readMetadata: Exif header found at position " << pos << '\n';
 #endif
-                ByteOrder bo =
-                    TiffParser::decode(exifData(), iptcData(), xmpData(), rawData.c_data(pos), rawData.size() - pos);
+                ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), rawData.c_data(pos),
+                                                  rawData.size() - pos, makerNotePolicy());
                 setByteOrder(bo);
               }
             } else {
@@ -586,6 +588,7 @@ void Jp2Image::writeMetadata() {
   }
   IoCloser closer(*io_);
   MemIo tempIo;
+  tempIo.reserve(io_->size());
 
   doWriteMetadata(tempIo);  // may throw
   io_->close();
@@ -11,6 +11,7 @@
 #include "i18n.h"  // NLS support.
 #include "image_int.hpp"
 #include "photoshop.hpp"
+#include "stats_int.hpp"
 #include "tags_int.hpp"
 
 #include <array>
@@ -148,6 +149,7 @@ byte JpegBase::advanceToMarker(ErrorCode err) const {
 }
 
 void JpegBase::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
   int rc = 0;  // Todo: this should be the return value
 
   if (io_->open() != 0)
@@ -190,23 +192,27 @@ void JpegBase::readMetadata() {
 
     if (!foundExifData && marker == app1_ && size >= 8  // prevent out-of-bounds read in memcmp on next line
         && buf.cmpBytes(2, exifId_.data(), 6) == 0) {
-      ByteOrder bo = ExifParser::decode(exifData_, buf.c_data(8), size - 8);
-      setByteOrder(bo);
-      if (size > 8 && byteOrder() == invalidByteOrder) {
+      if (readFilter() & mdExif) {
+        ByteOrder bo = ExifParser::decode(exifData_, buf.c_data(8), size - 8, makerNotePolicy());
+        setByteOrder(bo);
+        if (size > 8 && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
-        EXV_WARNING << "Failed to decode Exif metadata.\n";
+          EXV_WARNING << "Failed to decode Exif metadata.\n";
 #endif
-        exifData_.clear();
+          exifData_.clear();
+        }
       }
       --search;
       foundExifData = true;
     } else if (!foundXmpData && marker == app1_ && size >= 31  // prevent out-of-bounds read in memcmp on next line
                && buf.cmpBytes(2, xmpId_.data(), 29) == 0) {
-      xmpPacket_.assign(buf.c_str(31), size - 31);
-      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
+      if (readFilter() & mdXmp) {
+        xmpPacket_.assign(buf.c_str(31), size - 31);
+        if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
 #ifndef SUPPRESS_WARNINGS
-        EXV_WARNING << "Failed to decode XMP metadata.\n";
+          EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
+        }
       }
       --search;
       foundXmpData = true;
@@ -216,7 +222,7 @@ void JpegBase::readMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
       std::cerr << "Found app13 segment, size = " << size << "\n";
 #endif
-      if (buf.size() > 16) {  // Append to psBlob
+      if (buf.size() > 16 && (readFilter() & mdIptc)) {  // Append to psBlob
         append(psBlob, buf.c_data(16), size - 16);
       }
       // Check whether psBlob is complete
@@ -224,7 +230,7 @@ void JpegBase::readMetadata() {
         --search;
         foundCompletePsData = true;
       }
-    } else if (marker == com_ && comment_.empty()) {
+    } else if (marker == com_ && comment_.empty() && (readFilter() & mdComment)) {
       // JPEGs can have multiple comments, but for now only read
       // the first one (most jpegs only have one anyway). Comments
       // are simple single byte ISO-8859-1 strings.
@@ -262,7 +268,8 @@ void JpegBase::readMetadata() {
         icc_size = s;
       }
 
-      appendIccProfile(buf.c_data(2 + 14), icc_size, chunk == chunks);
+      if (readFilter() & mdIccProfile)
+        appendIccProfile(buf.c_data(2 + 14), icc_size, chunk == chunks);
     } else if (pixelHeight_ == 0 && inRange2(marker, sof0_, sof3_, sof5_, sof15_)) {
       // We hit a SOFn (start-of-frame) marker
       if (size < 8) {
@@ -316,6 +323,47 @@ void JpegBase::readMetadata() {
   }
 }  // JpegBase::readMetadata
 
+DataBuf JpegBase::readExifThumbnail() {
+  if (io_->open() != 0)
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isThisType(*io_, true)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAJpeg);
+  }
+
+  // Skip the segments up to the first Exif APP1 segment, only that one is read
+  byte marker = advanceToMarker(ErrorCode::kerNotAJpeg);
+  while (marker != sos_ && marker != eoi_) {
+    const auto [sizebuf, size] = readSegmentSize(marker, *io_);
+    if (marker == app1_ && size >= 8) {
+      std::array<byte, 6> id{};
+      io_->readOrThrow(id.data(), id.size(), ErrorCode::kerFailedToReadImageData);
+      if (id == exifId_) {
+        DataBuf buf(size - 8);
+        io_->readOrThrow(buf.data(), buf.size(), ErrorCode::kerFailedToReadImageData);
+        const auto [offset, sizeThumb] = ExifThumbC::findJpeg(buf.c_data(), buf.size());
+        if (sizeThumb == 0)
+          return {};
+        return {buf.c_data(offset), sizeThumb};
+      }
+      io_->seekOrThrow(size - 8, BasicIo::cur, ErrorCode::kerFailedToReadImageData);
+    } else if (size > 2) {
+      io_->seekOrThrow(size - 2, BasicIo::cur, ErrorCode::kerFailedToReadImageData);
+    }
+
+    // Read the beginning of the next segment
+    try {
+      marker = advanceToMarker(ErrorCode::kerFailedToReadImageData);
+    } catch (const Error&) {
+      break;
+    }
+  }
+  return {};
+}  // JpegBase::readExifThumbnail
+
 #define REPORT_MARKER                                 \
   if ((option == kpsBasic || option == kpsRecursive)) \
   out << stringFormat("{:8} | 0xff{:02x} {:<5}", io_->tell() - 2, marker, nm[marker].c_str())
@@ -578,6 +626,7 @@ void JpegBase::writeMetadata() {
   }
   IoCloser closer(*io_);
   MemIo tempIo;
+  tempIo.reserve(io_->size());
 
   doWriteMetadata(tempIo);  // may throw
   io_->close();
@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "metadatacache.hpp"
+#include "basicio.hpp"
+#include "error.hpp"
+#include "futils.hpp"
+#include "image.hpp"
+#include "serializer.hpp"
+#include "types.hpp"
+
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// *****************************************************************************
+namespace {
+using namespace Exiv2;
+
+//! Start of a cache file: signature and format version
+constexpr std::array<byte, 12> fileHeader{'E', 'x', 'i', 'v', '2', 'M', 'D', 'C', 0, 0, 0, 1};
+//! Size of the signature at the start of \em fileHeader
+constexpr size_t signatureSize = 8;
+//! Signature of an entry
+constexpr std::array<byte, 4> entryMagic{'M', 'D', 'C', 'E'};
+//! Size of the fixed part of an entry: magic, path size, payload size, identity and checksum
+constexpr size_t entryHeaderSize = 56;
+
+//! Identity of a file, an entry is valid while it matches
+struct FileIdentity {
+  uint64_t device_{0};  //!< Device of the file
+  uint64_t inode_{0};   //!< Inode of the file
+  uint64_t size_{0};    //!< Size of the file
+  uint64_t mtime_{0};   //!< Modification time of the file
+
+  bool operator==(const FileIdentity&) const = default;
+};
+
+//! Get the identity of the file \em path, return false if it cannot be determined
+bool fileIdentity(const std::string& path, FileIdentity& identity) {
+  std::error_code ec;
+  const auto size = fs::file_size(path, ec);
+  if (ec)
+    return false;
+  const auto mtime = fs::last_write_time(path, ec);
+  if (ec)
+    return false;
+  identity.size_ = size;
+  identity.mtime_ = static_cast<uint64_t>(mtime.time_since_epoch().count());
+#ifndef _WIN32
+  struct stat st {};
+  if (::stat(path.c_str(), &st) != 0)
+    return false;
+  identity.device_ = static_cast<uint64_t>(st.st_dev);
+  identity.inode_ = static_cast<uint64_t>(st.st_ino);
+#endif
+  return true;
+}
+
+//! 64-bit FNV-1a hash of \em size bytes at \em data, continuing from \em hash
+uint64_t fnv1a(const byte* data, size_t size, uint64_t hash = 0xcbf29ce484222325) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+//! Append the size of \em s and \em s to \em blob
+void appendString(Blob& blob, const std::string& s) {
+  byte buf[4];
+  ul2Data(buf, static_cast<uint32_t>(s.size()), littleEndian);
+  append(blob, buf, sizeof(buf));
+  append(blob, reinterpret_cast<const byte*>(s.data()), s.size());
+}
+
+//! Encode the metadata of \em image: comment, XMP packet and the serialized metadata containers
+void encodeMetadata(Blob& blob, const Image& image) {
+  appendString(blob, image.comment());
+  appendString(blob, image.xmpPacket());
+  MetadataSerializer::encode(blob, image.exifData(), image.iptcData(), image.xmpData(), image.byteOrder());
+}
+
+//! Read a string appended by appendString() from \em pData, \em size at \em pos
+std::string readString(const byte* pData, size_t size, size_t& pos) {
+  if (size - pos < 4)
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  const size_t n = getULong(pData + pos, littleEndian);
+  pos += 4;
+  if (size - pos < n)
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  std::string ret(reinterpret_cast<const char*>(pData + pos), n);
+  pos += n;
+  return ret;
+}
+
+//! Decode the metadata encoded by encodeMetadata() into \em image
+void decodeMetadata(const byte* pData, size_t size, Image& image) {
+  size_t pos = 0;
+  std::string comment = readString(pData, size, pos);
+  // Images without comments, such as TIFF and RAW images, refuse to set one
+  if (image.checkMode(mdComment) & amWrite)
+    image.setComment(comment);
+  image.xmpPacket() = readString(pData, size, pos);
+  const ByteOrder byteOrder = MetadataSerializer::decode(image.exifData(), image.iptcData(), image.xmpData(),
+                                                         pData + pos, size - pos);
+  if (!image.exifData().empty())
+    image.setByteOrder(byteOrder);
+}
+}  // namespace
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2 {
+//! Internal Pimpl structure of class MetadataCache.
+class MetadataCache::Impl {
+ public:
+  //! Constructor
+  explicit Impl(std::string path) : path_(std::move(path)), file_(path_) {
+  }
+
+  //! Location of the latest entry of a file
+  struct Entry {
+    size_t offset_;          //!< Offset of the entry in the cache file
+    FileIdentity identity_;  //!< Identity of the file when the entry was written
+  };
+
+  // DATA
+  std::string path_;                              //!< Path of the cache file
+  FileIo file_;                                   //!< The cache file, memory-mapped for reading
+  const byte* data_{nullptr};                     //!< Start of the mapped cache file
+  size_t mapped_{0};                              //!< Size of the mapped part of the cache file
+  size_t scanned_{0};                             //!< Offset up to which the entries are indexed
+  std::unordered_map<std::string, Entry> index_;  //!< Latest entry of each path
+  mutable std::mutex mutex_;                      //!< Protects the members above
+
+  // METHODS
+  //! Index the entries appended since the last call
+  void refresh();
+};
+
+void MetadataCache::Impl::refresh() {
+  const size_t size = file_.size();
+  if (size == std::numeric_limits<size_t>::max() || size <= mapped_)
+    return;
+  file_.munmap();
+  data_ = file_.mmap(false);
+  mapped_ = size;
+
+  while (scanned_ + entryHeaderSize <= mapped_) {
+    const byte* p = data_ + scanned_;
+    if (std::memcmp(p, entryMagic.data(), entryMagic.size()) != 0)
+      break;
+    const size_t pathSize = getULong(p + 4, littleEndian);
+    const uint64_t payloadSize = getULongLong(p + 8, littleEndian);
+    if (pathSize > mapped_ || payloadSize > mapped_ || mapped_ - scanned_ - entryHeaderSize < pathSize + payloadSize)
+      break;  // Incomplete, the entry is being written
+    const size_t entrySize = entryHeaderSize + pathSize + payloadSize;
+    const uint64_t checksum = fnv1a(p + 4, 44);
+    if (fnv1a(p + entryHeaderSize, pathSize + payloadSize, checksum) == getULongLong(p + 48, littleEndian)) {
+      FileIdentity identity;
+      identity.device_ = getULongLong(p + 16, littleEndian);
+      identity.inode_ = getULongLong(p + 24, littleEndian);
+      identity.size_ = getULongLong(p + 32, littleEndian);
+      identity.mtime_ = getULongLong(p + 40, littleEndian);
+      std::string path(reinterpret_cast<const char*>(p + entryHeaderSize), pathSize);
+      index_.insert_or_assign(std::move(path), Entry{scanned_, identity});
+    }
+    scanned_ += entrySize;
+  }
+}
+
+MetadataCache::MetadataCache(const std::string& path) : p_(std::make_unique<Impl>(path)) {
+  bool valid = false;
+  if (p_->file_.open("rb") == 0) {
+    std::array<byte, fileHeader.size()> header{};
+    const size_t n = p_->file_.read(header.data(), header.size());
+    p_->file_.close();
+    // Do not replace a file which is not a cache
+    if (n != 0 && (n < signatureSize || std::memcmp(header.data(), fileHeader.data(), signatureSize) != 0))
+      throw Error(ErrorCode::kerErrorMessage, path + ": Not a metadata cache");
+    valid = header == fileHeader;
+  }
+  if (!valid) {
+    if (p_->file_.open("wb") != 0)
+      throw Error(ErrorCode::kerFileOpenFailed, path, "wb", strError());
+    const bool written = p_->file_.write(fileHeader.data(), fileHeader.size()) == fileHeader.size();
+    p_->file_.close();
+    if (!written)
+      throw Error(ErrorCode::kerImageWriteFailed);
+  }
+  if (p_->file_.open("rb") != 0)
+    throw Error(ErrorCode::kerFileOpenFailed, path, "rb", strError());
+  p_->scanned_ = fileHeader.size();
+  p_->refresh();
+}
+
+MetadataCache::~MetadataCache() = default;
+
+bool MetadataCache::read(Image& image) {
+  const std::string& path = image.io().path();
+  FileIdentity identity;
+  if (fileProtocol(path) != pFile || !fileIdentity(path, identity))
+    return false;
+
+  DataBuf payload;
+  {
+    std::scoped_lock lock(p_->mutex_);
+    auto pos = p_->index_.find(path);
+    if (pos == p_->index_.end() || pos->second.identity_ != identity) {
+      // Another process may have appended an entry
+      p_->refresh();
+      pos = p_->index_.find(path);
+      if (pos == p_->index_.end() || pos->second.identity_ != identity)
+        return false;
+    }
+    const byte* p = p_->data_ + pos->second.offset_;
+    const size_t pathSize = getULong(p + 4, littleEndian);
+    const size_t payloadSize = getULongLong(p + 8, littleEndian);
+    payload = DataBuf(p + entryHeaderSize + pathSize, payloadSize);
+  }
+  try {
+    decodeMetadata(payload.c_data(), payload.size(), image);
+  } catch (const Error&) {
+    image.clearMetadata();
+    return false;
+  }
+  return true;
+}
+
+void MetadataCache::write(const Image& image) {
+  const std::string& path = image.io().path();
+  FileIdentity identity;
+  if (fileProtocol(path) != pFile || !fileIdentity(path, identity))
+    return;
+  Blob entry(entryHeaderSize);
+  append(entry, reinterpret_cast<const byte*>(path.data()), path.size());
+  try {
+    encodeMetadata(entry, image);
+  } catch (const std::exception&) {
+    // The file is read again the next time
+    return;
+  }
+
+  byte* p = entry.data();
+  std::memcpy(p, entryMagic.data(), entryMagic.size());
+  ul2Data(p + 4, static_cast<uint32_t>(path.size()), littleEndian);
+  ull2Data(p + 8, entry.size() - entryHeaderSize - path.size(), littleEndian);
+  ull2Data(p + 16, identity.device_, littleEndian);
+  ull2Data(p + 24, identity.inode_, littleEndian);
+  ull2Data(p + 32, identity.size_, littleEndian);
+  ull2Data(p + 40, identity.mtime_, littleEndian);
+  ull2Data(p + 48, fnv1a(p + entryHeaderSize, entry.size() - entryHeaderSize, fnv1a(p + 4, 44)), littleEndian);
+
+  std::scoped_lock lock(p_->mutex_);
+  FileIo out(p_->path_);
+  if (out.open("ab") != 0)
+    throw Error(ErrorCode::kerFileOpenFailed, p_->path_, "ab", strError());
+  if (out.write(entry.data(), entry.size()) != entry.size() || out.close() != 0)
+    throw Error(ErrorCode::kerImageWriteFailed);
+  p_->refresh();
+}
+
+const std::string& MetadataCache::path() const {
+  return p_->path_;
+}
+
+size_t MetadataCache::size() const {
+  std::scoped_lock lock(p_->mutex_);
+  return p_->index_.size();
+}
+
+}  // namespace Exiv2
+#endif  // EXV_ENABLE_FILESYSTEM
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "metadatum.hpp"
+#include "utils.hpp"
 
 #include <sstream>
 
@@ -15,8 +16,8 @@ Key::UniquePtr Key::clone() const {
 Metadatum::~Metadatum() = default;
 
 std::string Metadatum::print(const ExifData* pMetadata) const {
-  std::ostringstream os;
-  write(os, pMetadata);
+  Internal::ScopedStringStream os;
+  write(os.stream(), pMetadata);
   return os.str();
 }
 
@@ -962,8 +962,8 @@ constexpr TagDetailsBitmask nikonFlashAdaptors[] = {
 
 static std::ostream& printFlashCompensationValue(std::ostream& os, const unsigned char value, const bool manualScale) {
   std::ios::fmtflags f(os.flags());
-  std::ostringstream oss;
-  oss.copyfmt(os);
+  const auto prec = os.precision();
+  const auto fill = os.fill();
 
   if (manualScale) {
     /*
@@ -1038,7 +1038,8 @@ static std::ostream& printFlashCompensationValue(std::ostream& os, const unsigne
       os << std::showpos;
     os << std::fixed << (output / 6) << " EV";
   }
-  os.copyfmt(os);
+  os.precision(prec);
+  os.fill(fill);
   os.flags(f);
   return os;
 }
@@ -86,6 +86,30 @@ void OrfImage::readMetadata() {
   setByteOrder(bo);
 }
 
+namespace {
+/*!
+  @brief Encode as OrfParser::encode() does. With \em spliceInPlace, \em pData
+         must be the mapped content of \em io, see TiffParserWorker::encode().
+ */
+WriteMethod encodeOrf(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
+                      const IptcData& iptcData, const XmpData& xmpData, bool spliceInPlace) {
+  // Delete IFDs which do not occur in TIFF images
+  static constexpr auto filteredIfds = {
+      IfdId::panaRawId,
+  };
+  for (auto&& filteredIfd : filteredIfds) {
+#ifdef EXIV2_DEBUG_MESSAGES
+    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
+#endif
+    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), FindExifdatum(filteredIfd)), exifData.end());
+  }
+
+  OrfHeader header(byteOrder);
+  return TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Tag::root, TiffMapping::findEncoder,
+                                  &header, nullptr, spliceInPlace);
+}
+}  // namespace
+
 void OrfImage::writeMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing ORF file " << io_->path() << "\n";
@@ -107,7 +131,8 @@ void OrfImage::writeMetadata() {
     bo = littleEndian;
   }
   setByteOrder(bo);
-  OrfParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
+  // pData is the mapped file, so the image data can be spliced into it in place
+  encodeOrf(*io_, pData, size, bo, exifData_, iptcData_, xmpData_, pData != nullptr);  // may throw
 }  // OrfImage::writeMetadata
 
 ByteOrder OrfParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
@@ -118,20 +143,7 @@ ByteOrder OrfParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmp
 
 WriteMethod OrfParser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
                               const IptcData& iptcData, const XmpData& xmpData) {
-  // Delete IFDs which do not occur in TIFF images
-  static constexpr auto filteredIfds = {
-      IfdId::panaRawId,
-  };
-  for (auto&& filteredIfd : filteredIfds) {
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
-#endif
-    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), FindExifdatum(filteredIfd)), exifData.end());
-  }
-
-  OrfHeader header(byteOrder);
-  return TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Tag::root, TiffMapping::findEncoder,
-                                  &header, nullptr);
+  return encodeOrf(io, pData, size, byteOrder, exifData, iptcData, xmpData, false);
 }
 
 // *************************************************************************
@@ -17,6 +17,7 @@
 #include "photoshop.hpp"
 #include "safe_op.hpp"
 #include "tiffimage.hpp"
+#include "utils.hpp"
 
 // standard includes
 #include <algorithm>
@@ -24,6 +25,7 @@
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
 
 /*
@@ -104,7 +106,7 @@ DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkTyp
       const byte* compressedText = data.c_data(keysize + nullSeparators);
       enforce(compressedTextSize < data.size(), ErrorCode::kerCorruptedMetadata);
 
-      zlibUncompress(compressedText, static_cast<uint32_t>(compressedTextSize), arr);
+      zlibUncompress(compressedText, compressedTextSize, arr);
     }
   } else if (type == tEXt_Chunk) {
     enforce(data.size() >= Safe::add(keysize, std::size_t{1}), ErrorCode::kerCorruptedMetadata);
@@ -182,7 +184,8 @@ DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkTyp
 void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize, const DataBuf& arr) {
   // We look if an ImageMagick EXIF raw profile exist.
 
-  if (keySize >= 21 &&
+  const uint16_t readFilter = pImage->readFilter();
+  if ((readFilter & mdExif) && keySize >= 21 &&
       (memcmp("Raw profile type exif", key, 21) == 0 || memcmp("Raw profile type APP1", key, 21) == 0) &&
       pImage->exifData().empty()) {
     DataBuf exifData = readRawProfile(arr, false);
@@ -211,7 +214,7 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
         std::cout << "Exiv2::PngChunk::parseChunkContent: TIFF header found at position " << pos << "\n";
 #endif
         ByteOrder bo = TiffParser::decode(pImage->exifData(), pImage->iptcData(), pImage->xmpData(),
-                                          exifData.c_data(pos), length - pos);
+                                          exifData.c_data(pos), length - pos, pImage->makerNotePolicy());
         pImage->setByteOrder(bo);
       } else {
 #ifndef SUPPRESS_WARNINGS
@@ -224,7 +227,8 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
 
   // We look if an ImageMagick IPTC raw profile exist.
 
-  if (keySize >= 21 && memcmp("Raw profile type iptc", key, 21) == 0 && pImage->iptcData().empty()) {
+  if ((readFilter & mdIptc) && keySize >= 21 && memcmp("Raw profile type iptc", key, 21) == 0 &&
+      pImage->iptcData().empty()) {
     DataBuf psData = readRawProfile(arr, false);
     if (!psData.empty()) {
       Blob iptcBlob;
@@ -262,7 +266,8 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
 
   // We look if an ImageMagick XMP raw profile exist.
 
-  if (keySize >= 20 && memcmp("Raw profile type xmp", key, 20) == 0 && pImage->xmpData().empty()) {
+  if ((readFilter & mdXmp) && keySize >= 20 && memcmp("Raw profile type xmp", key, 20) == 0 &&
+      pImage->xmpData().empty()) {
     DataBuf xmpBuf = readRawProfile(arr, false);
     size_t length = xmpBuf.size();
 
@@ -285,7 +290,8 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
 
   // We look if an Adobe XMP string exist.
 
-  if (keySize >= 17 && memcmp("XML:com.adobe.xmp", key, 17) == 0 && pImage->xmpData().empty() && !arr.empty()) {
+  if ((readFilter & mdXmp) && keySize >= 17 && memcmp("XML:com.adobe.xmp", key, 17) == 0 &&
+      pImage->xmpData().empty() && !arr.empty()) {
     std::string& xmpPacket = pImage->xmpPacket();
     xmpPacket.assign(arr.c_str(), arr.size());
     if (auto idx = xmpPacket.find_first_of('<'); idx != std::string::npos && idx > 0) {
@@ -305,23 +311,24 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
   // We look if a comments string exist. Note than we use only 'Description' keyword which
   // is dedicated to store long comments. 'Comment' keyword is ignored.
 
-  if (keySize >= 11 && memcmp("Description", key, 11) == 0 && pImage->comment().empty()) {
+  if ((readFilter & mdComment) && keySize >= 11 && memcmp("Description", key, 11) == 0 &&
+      pImage->comment().empty()) {
     pImage->setComment(std::string(arr.c_str(), arr.size()));
   }
 
 }  // PngChunk::parseChunkContent
 
-std::string PngChunk::makeMetadataChunk(std::string_view metadata, MetadataId type) {
+std::string PngChunk::makeMetadataChunk(std::string_view metadata, MetadataId type, int level) {
   std::string rawProfile;
 
   switch (type) {
     case mdComment:
-      return makeUtf8TxtChunk("Description", metadata, true);
+      return makeUtf8TxtChunk("Description", metadata, true, level);
     case mdIptc:
       rawProfile = writeRawProfile(metadata, "iptc");
-      return makeAsciiTxtChunk("Raw profile type iptc", rawProfile, true);
+      return makeAsciiTxtChunk("Raw profile type iptc", rawProfile, true, level);
     case mdXmp:
-      return makeUtf8TxtChunk("XML:com.adobe.xmp", metadata, false);
+      return makeUtf8TxtChunk("XML:com.adobe.xmp", metadata, false, level);
     case mdExif:
     case mdIccProfile:
     case mdNone:
@@ -332,71 +339,81 @@ std::string PngChunk::makeMetadataChunk(std::string_view metadata, MetadataId ty
 
 }  // PngChunk::makeMetadataChunk
 
-void PngChunk::zlibUncompress(const byte* compressedText, unsigned int compressedTextSize, DataBuf& arr) {
-  uLongf uncompressedLen = compressedTextSize * 2;  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
-  int dos = 0;
-
-  while (zlibResult == Z_BUF_ERROR) {
-    arr.alloc(uncompressedLen);
-    zlibResult = uncompress(arr.data(), &uncompressedLen, compressedText, compressedTextSize);
-    if (zlibResult == Z_OK) {
-      arr.resize(uncompressedLen);
-    } else if (zlibResult == Z_BUF_ERROR) {
-      // the uncompressedArray needs to be larger
-      uncompressedLen *= 2;
-      // DoS protection. can't be bigger than 64k
-      if (uncompressedLen > 131072) {
-        if (++dos > 1)
-          break;
-        uncompressedLen = 131072;
-      }
-    } else {
-      // something bad happened
-      throw Error(ErrorCode::kerFailedToReadImageData);
-    }
-  }
-
-  if (zlibResult != Z_OK) {
+void PngChunk::zlibUncompress(const byte* compressedText, size_t compressedTextSize, DataBuf& arr) {
+  // DoS protection: text chunks are not inflated to more than 128 KiB
+  if (!zlibInflate(compressedText, compressedTextSize, arr, 131072)) {
     throw Error(ErrorCode::kerFailedToReadImageData);
   }
 }  // PngChunk::zlibUncompress
 
-std::string PngChunk::zlibCompress(std::string_view text) {
-  auto compressedLen = static_cast<uLongf>(text.size() * 2);  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
-
+std::string PngChunk::zlibCompress(std::string_view text, int level) {
   DataBuf arr;
-  while (zlibResult == Z_BUF_ERROR) {
-    arr.resize(compressedLen);
-    zlibResult = compress2(arr.data(), &compressedLen, reinterpret_cast<const Bytef*>(text.data()),
-                           static_cast<uLong>(text.size()), Z_BEST_COMPRESSION);
-
-    switch (zlibResult) {
-      case Z_OK:
-        arr.resize(compressedLen);
-        break;
-      case Z_BUF_ERROR:
-        // The compressed array needs to be larger
-#ifdef EXIV2_DEBUG_MESSAGES
-        std::cout << "Exiv2::PngChunk::parsePngChunk: doubling size for compression.\n";
-#endif
-        compressedLen *= 2;
-        // DoS protection. Cap max compressed size
-        if (compressedLen > 131072)
-          throw Error(ErrorCode::kerFailedToReadImageData);
-        break;
-      default:
-        // Something bad happened
-        throw Error(ErrorCode::kerFailedToReadImageData);
-    }
+  if (!zlibDeflate(reinterpret_cast<const byte*>(text.data()), text.size(), arr, level)) {
+    throw Error(ErrorCode::kerFailedToReadImageData);
   }
-
   return {arr.c_str(), arr.size()};
 
 }  // PngChunk::zlibCompress
 
-std::string PngChunk::makeAsciiTxtChunk(std::string_view keyword, std::string_view text, bool compress) {
+bool PngChunk::zlibInflate(const byte* compressed, size_t size, DataBuf& arr, size_t maxSize) {
+  z_stream stream{};
+  if (size > std::numeric_limits<uInt>::max() || maxSize >= std::numeric_limits<uInt>::max() ||
+      inflateInit(&stream) != Z_OK) {
+    arr.reset();
+    return false;
+  }
+  stream.next_in = const_cast<Bytef*>(compressed);
+  stream.avail_in = static_cast<uInt>(size);
+
+  // Text usually compresses to less than a quarter; the buffer grows by doubling otherwise.
+  // One byte more than maxSize is allowed to detect oversized streams.
+  arr.alloc(std::min(std::max<size_t>(size * 4, 1024), maxSize + 1));
+  int zlibResult = Z_OK;
+  while (zlibResult == Z_OK) {
+    if (stream.total_out == arr.size()) {
+      if (arr.size() > maxSize)
+        break;
+      arr.resize(std::min(arr.size() * 2, maxSize + 1));
+    }
+    stream.next_out = arr.data(stream.total_out);
+    stream.avail_out = static_cast<uInt>(arr.size() - stream.total_out);
+    zlibResult = inflate(&stream, Z_NO_FLUSH);
+  }
+  const bool ok = zlibResult == Z_STREAM_END && stream.total_out <= maxSize;
+  if (ok) {
+    arr.resize(stream.total_out);
+  } else {
+    arr.reset();
+  }
+  inflateEnd(&stream);
+  return ok;
+}  // PngChunk::zlibInflate
+
+bool PngChunk::zlibDeflate(const byte* data, size_t size, DataBuf& arr, int level) {
+  z_stream stream{};
+  if (size > std::numeric_limits<uInt>::max() || deflateInit(&stream, level) != Z_OK) {
+    arr.reset();
+    return false;
+  }
+  stream.next_in = const_cast<Bytef*>(data);
+  stream.avail_in = static_cast<uInt>(size);
+
+  // deflateBound() is an upper bound of the compressed size: a single call compresses everything
+  arr.alloc(deflateBound(&stream, static_cast<uLong>(size)));
+  stream.next_out = arr.data();
+  stream.avail_out = static_cast<uInt>(arr.size());
+  const bool ok = deflate(&stream, Z_FINISH) == Z_STREAM_END;
+  if (ok) {
+    arr.resize(stream.total_out);
+  } else {
+    arr.reset();
+  }
+  deflateEnd(&stream);
+  return ok;
+}  // PngChunk::zlibDeflate
+
+std::string PngChunk::makeAsciiTxtChunk(std::string_view keyword, std::string_view text, bool compress,
+                                        int level) {
   // Chunk structure: length (4 bytes) + chunk type + chunk data + CRC (4 bytes)
   // Length is the size of the chunk data
   // CRC is calculated on chunk type + chunk data
@@ -411,7 +428,7 @@ std::string PngChunk::makeAsciiTxtChunk(std::string_view keyword, std::string_vi
   auto chunkData = std::string(keyword) + '\0';
   std::string chunkType;
   if (compress) {
-    chunkData += '\0' + zlibCompress(text);
+    chunkData += '\0' + zlibCompress(text, level);
     chunkType = "zTXt";
   } else {
     chunkData += text;
@@ -432,7 +449,7 @@ std::string PngChunk::makeAsciiTxtChunk(std::string_view keyword, std::string_vi
 
 }  // PngChunk::makeAsciiTxtChunk
 
-std::string PngChunk::makeUtf8TxtChunk(std::string_view keyword, std::string_view text, bool compress) {
+std::string PngChunk::makeUtf8TxtChunk(std::string_view keyword, std::string_view text, bool compress, int level) {
   // Chunk structure: length (4 bytes) + chunk type + chunk data + CRC (4 bytes)
   // Length is the size of the chunk data
   // CRC is calculated on chunk type + chunk data
@@ -445,7 +462,7 @@ std::string PngChunk::makeUtf8TxtChunk(std::string_view keyword, std::string_vie
   auto chunkData = std::string(keyword);
   if (compress) {
     static const char flags[] = {0x00, 0x01, 0x00, 0x00, 0x00};
-    chunkData += std::string(flags, 5) + zlibCompress(text);
+    chunkData += std::string(flags, 5) + zlibCompress(text, level);
   } else {
     static const char flags[] = {0x00, 0x00, 0x00, 0x00, 0x00};
     chunkData += std::string(flags, 5) + text.data();
@@ -472,12 +489,6 @@ DataBuf PngChunk::readRawProfile(const DataBuf& text, bool iTXt) {
     return info;
   }
 
-  const unsigned char unhex[103] = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0,  0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0,  0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15,
-  };
-
   if (iTXt) {
     info.alloc(text.size());
     std::copy(text.begin(), text.end(), info.begin());
@@ -547,27 +558,13 @@ DataBuf PngChunk::readRawProfile(const DataBuf& text, bool iTXt) {
     return info;
 
   // Copy profile, skipping white space and column 1 "=" signs
-  unsigned char* dp = info.data();  // decode pointer
-  size_t nibbles = length * 2;
-
-  for (size_t i = 0; i < nibbles; i++) {
-    enforce(sp < eot, Exiv2::ErrorCode::kerCorruptedMetadata);
-    while (*sp < '0' || (*sp > '9' && *sp < 'a') || *sp > 'f') {
-      if (*sp == '\0') {
+  if (!hexDecode(info.data(), length, sp, eot)) {
+    // The text either ends with a NUL character or is truncated
+    enforce(std::find(sp, eot, '\0') != eot, Exiv2::ErrorCode::kerCorruptedMetadata);
 #ifdef EXIV2_DEBUG_MESSAGES
-        std::cerr << "Exiv2::PngChunk::readRawProfile: Unable To Copy Raw Profile: ran out of data\n";
+    std::cerr << "Exiv2::PngChunk::readRawProfile: Unable To Copy Raw Profile: ran out of data\n";
 #endif
-        return {};
-      }
-
-      sp++;
-      enforce(sp < eot, Exiv2::ErrorCode::kerCorruptedMetadata);
-    }
-
-    if (i % 2 == 0)
-      *dp = static_cast<unsigned char>(16 * unhex[static_cast<size_t>(*sp++)]);
-    else
-      (*dp++) += unhex[static_cast<size_t>(*sp++)];
+    return {};
   }
 
   return info;
@@ -575,16 +572,8 @@ DataBuf PngChunk::readRawProfile(const DataBuf& text, bool iTXt) {
 }  // PngChunk::readRawProfile
 
 std::string PngChunk::writeRawProfile(std::string_view profileData, const char* profileType) {
-  static const byte hex[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-
   auto ss = stringFormat("\n{}\n{:08}", profileType, profileData.size());
-  auto sp = reinterpret_cast<const byte*>(profileData.data());
-  for (std::string::size_type i = 0; i < profileData.size(); ++i) {
-    if (i % 36 == 0)
-      ss += '\n';
-    ss += hex[*sp >> 4 & 0x0fU];
-    ss += hex[*sp++ & 0x0fU];
-  }
+  hexEncode(ss, reinterpret_cast<const byte*>(profileData.data()), profileData.size(), 36);
   ss += '\n';
   return ss;
 
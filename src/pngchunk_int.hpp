@@ -77,8 +77,27 @@ class PngChunk {
 
     @param metadata    metadata buffer.
     @param type        metadata type.
+    @param level       zlib compression level of compressed chunks.
   */
-  static std::string makeMetadataChunk(std::string_view metadata, MetadataId type);
+  static std::string makeMetadataChunk(std::string_view metadata, MetadataId type, int level);
+
+  /*!
+    @brief Inflate the zlib stream \em compressed of \em size bytes into
+           \em arr in one pass, growing \em arr as needed.
+
+    @return true if successful; false, with \em arr empty, if the stream
+            is corrupted, truncated or inflates to more than \em maxSize
+            bytes.
+  */
+  static bool zlibInflate(const byte* compressed, size_t size, DataBuf& arr, size_t maxSize);
+
+  /*!
+    @brief Deflate \em size bytes at \em data into a zlib stream in \em arr
+           with compression \em level (0 to 9, or -1 for the zlib default).
+
+    @return true if successful; false, with \em arr empty, on error.
+  */
+  static bool zlibDeflate(const byte* data, size_t size, DataBuf& arr, int level);
 
  private:
   /*!
@@ -105,10 +124,11 @@ class PngChunk {
     @param keyword  Keyword for the PNG text chunk
     @param text     Text to be recorded in the PNG chunk.
     @param compress Flag indicating whether to compress the PNG chunk data.
+    @param level    zlib compression level used if \em compress is true.
 
     @return String containing the PNG chunk
   */
-  static std::string makeAsciiTxtChunk(std::string_view keyword, std::string_view text, bool compress);
+  static std::string makeAsciiTxtChunk(std::string_view keyword, std::string_view text, bool compress, int level);
 
   /*!
     @brief Return a compressed or uncompressed (iTXt) PNG international text chunk
@@ -117,18 +137,19 @@ class PngChunk {
     @param keyword  Keyword for the PNG international text chunk
     @param text     Text to be recorded in the PNG chunk.
     @param compress Flag indicating whether to compress the PNG chunk data.
+    @param level    zlib compression level used if \em compress is true.
   */
-  static std::string makeUtf8TxtChunk(std::string_view keyword, std::string_view text, bool compress);
+  static std::string makeUtf8TxtChunk(std::string_view keyword, std::string_view text, bool compress, int level);
 
   /*!
     @brief Wrapper around zlib to uncompress a PNG chunk content.
    */
-  static void zlibUncompress(const byte* compressedText, unsigned int compressedTextSize, DataBuf& arr);
+  static void zlibUncompress(const byte* compressedText, size_t compressedTextSize, DataBuf& arr);
 
   /*!
     @brief Wrapper around zlib to compress a PNG chunk content.
    */
-  static std::string zlibCompress(std::string_view text);
+  static std::string zlibCompress(std::string_view text, int level);
 
   /*!
     @brief Decode from ImageMagick raw text profile which host encoded Exif/Iptc/Xmp metadata byte array.
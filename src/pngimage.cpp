@@ -15,10 +15,12 @@
 #include "photoshop.hpp"
 #include "pngchunk_int.hpp"
 #include "pngimage.hpp"
+#include "stats_int.hpp"
 #include "tiffimage.hpp"
 #include "types.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <iostream>
@@ -29,6 +31,9 @@ constexpr std::array<unsigned char, 8> pngSignature{
     0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A,
 };
 
+//! Sanity limit of the size of inflated iCCP chunks and of zTXt chunks printed by printStructure()
+constexpr size_t maxInflatedSize = 16 * 1024 * 1024;
+
 constexpr unsigned char pngBlank[] = {
     0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
     0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x02, 0x00, 0x00, 0x00, 0x90, 0x77, 0x53, 0xde, 0x00, 0x00, 0x00,
@@ -45,6 +50,97 @@ bool compare(std::string_view str, const Exiv2::DataBuf& buf) {
   const auto minlen = std::min<size_t>(str.size(), buf.size());
   return buf.cmpBytes(0, str.data(), minlen) == 0;
 }
+
+//! Size of the blocks read by ChunkScanner
+constexpr size_t chunkScanBlockSize = 64 * 1024;
+
+/*!
+  @brief Sequential reader of the chunks of a PNG image. The IO is read in
+         blocks, so a run of small chunks, e.g., the many IDAT chunks
+         written by some encoders, is walked without a seek and a read per
+         chunk.
+ */
+class ChunkScanner {
+ public:
+  //! Start scanning at the current position of \em io
+  explicit ChunkScanner(Exiv2::BasicIo& io) : io_(io), size_(io.size()), pos_(io.tell()) {
+  }
+
+  /*!
+    @brief Read the header of the next chunk into \em type and return the
+           length of its data. The IO must contain the chunk data.
+   */
+  uint32_t next(std::array<char, 4>& type) {
+    const Exiv2::byte* header = fetch(pos_, 8);
+    length_ = Exiv2::getULong(header, Exiv2::bigEndian);
+    if (length_ > size_ - pos_ - 8) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerFailedToReadImageData);
+    }
+    std::copy_n(header + 4, 4, type.begin());
+    return length_;
+  }
+
+  //! Read the data of the current chunk into \em data, which must have the size of the data
+  void read(Exiv2::DataBuf& data) {
+    if (length_ <= chunkScanBlockSize) {
+      std::copy_n(fetch(pos_ + 8, length_), length_, data.begin());
+      return;
+    }
+    // Use the part of the data which is already in the block and read the rest
+    const size_t start = pos_ + 8;
+    const size_t blockEnd = blockStart_ + blockSize_;
+    size_t buffered = 0;
+    if (start >= blockStart_ && start <= blockEnd && io_.tell() == blockEnd) {
+      buffered = std::min<size_t>(blockEnd - start, length_);
+      std::copy_n(block_.c_data(start - blockStart_), buffered, data.begin());
+    } else if (io_.seek(start, Exiv2::BasicIo::beg) != 0) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerFailedToReadImageData);
+    }
+    const size_t rest = length_ - buffered;
+    if (io_.read(data.data() + buffered, rest) != rest || io_.error()) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerFailedToReadImageData);
+    }
+  }
+
+  //! Move to the next chunk: chunk header, data and CRC
+  void skip() {
+    pos_ += 8 + length_ + 4;
+  }
+
+ private:
+  //! Return \em count bytes of the IO at offset \em offset, reading a new block if needed
+  const Exiv2::byte* fetch(size_t offset, size_t count) {
+    if (offset >= blockStart_ && offset + count <= blockStart_ + blockSize_) {
+      return block_.c_data(offset - blockStart_);
+    }
+    if (offset > size_ || count > size_ - offset) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerInputDataReadFailed);
+    }
+    if (block_.empty()) {
+      block_.alloc(std::min(chunkScanBlockSize, size_));
+    }
+    if (io_.seek(offset, Exiv2::BasicIo::beg) != 0) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerFailedToReadImageData);
+    }
+    blockStart_ = offset;
+    blockSize_ = io_.read(block_.data(), std::min(block_.size(), size_ - offset));
+    if (io_.error()) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerFailedToReadImageData);
+    }
+    if (blockSize_ < count) {
+      throw Exiv2::Error(Exiv2::ErrorCode::kerInputDataReadFailed);
+    }
+    return block_.c_data();
+  }
+
+  Exiv2::BasicIo& io_;    //!< IO to read from
+  const size_t size_;     //!< Size of the IO
+  size_t pos_;            //!< Offset of the current chunk
+  uint32_t length_{0};    //!< Data length of the current chunk
+  Exiv2::DataBuf block_;  //!< Block read from the IO
+  size_t blockStart_{0};  //!< Offset of the block in the IO
+  size_t blockSize_{0};   //!< Number of bytes read into the block
+};
 }  // namespace
 
 // *****************************************************************************
@@ -71,56 +167,6 @@ std::string PngImage::mimeType() const {
   return "image/png";
 }
 
-static bool zlibToDataBuf(const byte* bytes, uLongf length, DataBuf& result) {
-  uLongf uncompressedLen = length;  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
-
-  while (zlibResult == Z_BUF_ERROR) {
-    result.alloc(uncompressedLen);
-    zlibResult = uncompress(result.data(), &uncompressedLen, bytes, length);
-    // if result buffer is large than necessary, redo to fit perfectly.
-    if (zlibResult == Z_OK && uncompressedLen < result.size()) {
-      result.reset();
-
-      result.alloc(uncompressedLen);
-      zlibResult = uncompress(result.data(), &uncompressedLen, bytes, length);
-    }
-    if (zlibResult == Z_BUF_ERROR) {
-      // the uncompressed buffer needs to be larger
-      result.reset();
-
-      // Sanity - never bigger than 16mb
-      if (uncompressedLen > 16 * 1024 * 1024)
-        zlibResult = Z_DATA_ERROR;
-      else
-        uncompressedLen *= 2;
-    }
-  }
-
-  return zlibResult == Z_OK;
-}
-
-static bool zlibToCompressed(const byte* bytes, uLongf length, DataBuf& result) {
-  uLongf compressedLen = length;  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
-
-  while (zlibResult == Z_BUF_ERROR) {
-    result.alloc(compressedLen);
-    zlibResult = compress(result.data(), &compressedLen, bytes, length);
-    if (zlibResult == Z_BUF_ERROR) {
-      // the compressedArray needs to be larger
-      result.reset();
-      compressedLen *= 2;
-    } else {
-      result.reset();
-      result.alloc(compressedLen);
-      zlibResult = compress(result.data(), &compressedLen, bytes, length);
-    }
-  }
-
-  return zlibResult == Z_OK;
-}
-
 static bool tEXtToDataBuf(const byte* bytes, size_t length, DataBuf& result) {
   static std::array<int, 256> value;
   static bool bFirst = true;
@@ -295,9 +341,8 @@ void PngImage::printStructure(std::ostream& out, PrintStructureOption option, si
           bGood = tEXtToDataBuf(data.c_data(name_l), dataOffset - name_l, dataBuf);
         }
         if (zTXt || iCCP) {
-          enforce(dataOffset - name_l - 1 <= std::numeric_limits<uLongf>::max(), ErrorCode::kerCorruptedMetadata);
-          bGood = zlibToDataBuf(data.c_data(name_l + 1), static_cast<uLongf>(dataOffset - name_l - 1),
-                                dataBuf);  // +1 = 'compressed' flag
+          bGood = PngChunk::zlibInflate(data.c_data(name_l + 1), dataOffset - name_l - 1, dataBuf,
+                                        maxInflatedSize);  // +1 = 'compressed' flag
         }
         if (iTXt) {
           bGood = (3 <= dataOffset) && (start < dataOffset - 3);  // good if not a nul chunk
@@ -376,20 +421,8 @@ void PngImage::printStructure(std::ostream& out, PrintStructureOption option, si
   }
 }
 
-static void readChunk(DataBuf& buffer, BasicIo& io) {
-#ifdef EXIV2_DEBUG_MESSAGES
-  std::cout << "Exiv2::PngImage::readMetadata: Position: " << io.tell() << '\n';
-#endif
-  const size_t bufRead = io.read(buffer.data(), buffer.size());
-  if (io.error()) {
-    throw Error(ErrorCode::kerFailedToReadImageData);
-  }
-  if (bufRead != buffer.size()) {
-    throw Error(ErrorCode::kerInputDataReadFailed);
-  }
-}
-
 void PngImage::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Exiv2::PngImage::readMetadata: Reading PNG file " << io_->path() << '\n';
 #endif
@@ -401,36 +434,34 @@ void PngImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "PNG");
   }
   clearMetadata();
+  setStoppedAtImageData(false);
 
-  const size_t imgSize = io_->size();
-  DataBuf cheaderBuf(8);  // Chunk header: 4 bytes (data size) + 4 bytes (chunk type).
-
-  while (!io_->eof()) {
-    readChunk(cheaderBuf, *io_);  // Read chunk header.
-
-    // Decode chunk data length.
-    uint32_t chunkLength = cheaderBuf.read_uint32(0, Exiv2::bigEndian);
-    if (chunkLength > imgSize - io_->tell()) {
-      throw Exiv2::Error(ErrorCode::kerFailedToReadImageData);
-    }
-
-    std::string chunkType(cheaderBuf.c_str(4), 4);
+  ChunkScanner scanner(*io_);
+  std::array<char, 4> type;
+  while (true) {
+    const uint32_t chunkLength = scanner.next(type);
+    const std::string_view chunkType(type.data(), type.size());
 #ifdef EXIV2_DEBUG_MESSAGES
     std::cout << "Exiv2::PngImage::readMetadata: chunk type: " << chunkType << " length: " << chunkLength << '\n';
 #endif
 
+    if (chunkType == "IEND") {
+      return;  // Last chunk found: we stop parsing.
+    }
+    if (chunkType == "IDAT" && stopAtImageData()) {
+      setStoppedAtImageData(true);
+      return;
+    }
+
     /// \todo analyse remaining chunks of the standard
     // Perform a chunk triage for item that we need.
-    if (chunkType == "IEND" || chunkType == "IHDR" || chunkType == "tEXt" || chunkType == "zTXt" ||
-        chunkType == "eXIf" || chunkType == "iTXt" || chunkType == "iCCP") {
+    if (chunkType == "IHDR" || chunkType == "tEXt" || chunkType == "zTXt" || chunkType == "eXIf" ||
+        chunkType == "iTXt" || chunkType == "iCCP") {
       DataBuf chunkData(chunkLength);
       if (chunkLength > 0) {
-        readChunk(chunkData, *io_);  // Extract chunk data.
+        scanner.read(chunkData);  // Extract chunk data.
       }
 
-      if (chunkType == "IEND") {
-        return;  // Last chunk found: we stop parsing.
-      }
       if (chunkType == "IHDR" && chunkData.size() >= 8) {
         PngChunk::decodeIHDRChunk(chunkData, &pixelWidth_, &pixelHeight_);
       } else if (chunkType == "tEXt") {
@@ -439,10 +470,11 @@ void PngImage::readMetadata() {
         PngChunk::decodeTXTChunk(this, chunkData, PngChunk::zTXt_Chunk);
       } else if (chunkType == "iTXt") {
         PngChunk::decodeTXTChunk(this, chunkData, PngChunk::iTXt_Chunk);
-      } else if (chunkType == "eXIf") {
-        ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size());
+      } else if (chunkType == "eXIf" && (readFilter() & mdExif)) {
+        ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size(),
+                                          makerNotePolicy());
         setByteOrder(bo);
-      } else if (chunkType == "iCCP") {
+      } else if (chunkType == "iCCP" && (readFilter() & mdIccProfile)) {
         // The ICC profile name can vary from 1-79 characters.
         uint32_t iccOffset = 0;
         do {
@@ -453,35 +485,28 @@ void PngImage::readMetadata() {
         ++iccOffset;  // +1 = 'compressed' flag
         enforce(iccOffset <= chunkLength, Exiv2::ErrorCode::kerCorruptedMetadata);
 
-        zlibToDataBuf(chunkData.c_data(iccOffset), static_cast<uLongf>(chunkLength - iccOffset), iccProfile_);
+        PngChunk::zlibInflate(chunkData.c_data(iccOffset), chunkLength - iccOffset, iccProfile_, maxInflatedSize);
 #ifdef EXIV2_DEBUG_MESSAGES
         std::cout << "Exiv2::PngImage::readMetadata: profile name: " << profileName_ << '\n';
         std::cout << "Exiv2::PngImage::readMetadata: iccProfile.size_ (uncompressed) : " << iccProfile_.size() << '\n';
 #endif
       }
-
-      // Set chunkLength to 0 in case we have read a supported chunk type. Otherwise, we need to seek the
-      // file to the next chunk position.
-      chunkLength = 0;
     }
 
-    // Move to the next chunk: chunk data size + 4 CRC bytes.
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cout << "Exiv2::PngImage::readMetadata: Seek to offset: " << chunkLength + 4 << '\n';
-#endif
-    io_->seek(chunkLength + 4, BasicIo::cur);
-    if (io_->error() || io_->eof()) {
-      throw Error(ErrorCode::kerFailedToReadImageData);
-    }
+    scanner.skip();
   }
 }  // PngImage::readMetadata
 
 void PngImage::writeMetadata() {
+  // The chunks after the image data would be replaced by metadata which does not include them
+  if (stoppedAtImageData())
+    throw Error(ErrorCode::kerErrorMessage, io_->path() + ": Metadata after the image data was not read");
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
   IoCloser closer(*io_);
   MemIo tempIo;
+  tempIo.reserve(io_->size());
 
   doWriteMetadata(tempIo);  // may throw
   io_->close();
@@ -508,6 +533,9 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
   if (outIo.write(pngSignature.data(), 8) != 8)
     throw Error(ErrorCode::kerImageWriteFailed);
 
+  // Text chunks are compressed best unless the caller chose a level, the ICC profile with the zlib default
+  const int textLevel = compressionLevel() < 0 ? Z_BEST_COMPRESSION : compressionLevel();
+
   DataBuf cheaderBuf(8);  // Chunk header : 4 bytes (data size) + 4 bytes (chunk type).
 
   while (!io_->eof()) {
@@ -562,7 +590,7 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
       // Write all updated metadata here, just after IHDR.
       if (!comment_.empty()) {
         // Update Comment data to a new PNG chunk
-        std::string chunk = PngChunk::makeMetadataChunk(comment_, mdComment);
+        std::string chunk = PngChunk::makeMetadataChunk(comment_, mdComment, textLevel);
         if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
           throw Error(ErrorCode::kerImageWriteFailed);
         }
@@ -599,7 +627,7 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
         DataBuf newPsData = Photoshop::setIptcIrb(nullptr, 0, iptcData_);
         if (!newPsData.empty()) {
           std::string rawIptc(newPsData.c_str(), newPsData.size());
-          std::string chunk = PngChunk::makeMetadataChunk(rawIptc, mdIptc);
+          std::string chunk = PngChunk::makeMetadataChunk(rawIptc, mdIptc, textLevel);
           if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
             throw Error(ErrorCode::kerImageWriteFailed);
           }
@@ -608,8 +636,7 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
 
       if (iccProfileDefined()) {
         DataBuf compressed;
-        enforce(iccProfile_.size() <= std::numeric_limits<uLongf>::max(), ErrorCode::kerCorruptedMetadata);
-        if (zlibToCompressed(iccProfile_.c_data(), static_cast<uLongf>(iccProfile_.size()), compressed)) {
+        if (PngChunk::zlibDeflate(iccProfile_.c_data(), iccProfile_.size(), compressed, compressionLevel())) {
           const auto nameLength = static_cast<uint32_t>(profileName_.size());
           const uint32_t chunkLength = nameLength + 2 + static_cast<uint32_t>(compressed.size());
           byte length[4];
@@ -644,7 +671,7 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
       }
       if (!xmpPacket_.empty()) {
         // Update XMP data to a new PNG chunk
-        std::string chunk = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp);
+        std::string chunk = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp, textLevel);
         if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
           throw Error(ErrorCode::kerImageWriteFailed);
         }
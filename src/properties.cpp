@@ -12,7 +12,11 @@
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
 
+#include <atomic>
 #include <iostream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 namespace {
 //! Struct used in the lookup table for pretty print functions
@@ -4948,6 +4952,109 @@ bool XmpPropertyInfo::operator==(const std::string& name) const {
   return name_ == name;
 }
 
+namespace {
+//! Hash index over the built-in schemas and their properties
+class BuiltinXmpIndex {
+ public:
+  BuiltinXmpIndex() {
+    // Like the linear searches it replaces, the index returns the first match
+    for (const auto& xn : xmpNsInfo) {
+      byPrefix_.try_emplace(xn.prefix_, &xn);
+      byNs_.try_emplace(xn.ns_, &xn);
+      for (auto pl = xn.xmpPropertyInfo_; pl && pl->name_; ++pl) {
+        properties_.try_emplace(PropertyKey{xn.xmpPropertyInfo_, pl->name_}, pl);
+      }
+    }
+  }
+
+  //! Return the built-in schema with prefix \em prefix or nullptr
+  [[nodiscard]] const XmpNsInfo* nsInfo(std::string_view prefix) const {
+    auto i = byPrefix_.find(prefix);
+    return i == byPrefix_.end() ? nullptr : i->second;
+  }
+
+  //! Return the built-in schema with namespace \em ns or nullptr
+  [[nodiscard]] const XmpNsInfo* nsInfoByNs(std::string_view ns) const {
+    auto i = byNs_.find(ns);
+    return i == byNs_.end() ? nullptr : i->second;
+  }
+
+  //! Return the property \em name of the property list \em pl or nullptr
+  [[nodiscard]] const XmpPropertyInfo* propertyInfo(const XmpPropertyInfo* pl, std::string_view name) const {
+    auto i = properties_.find(PropertyKey{pl, name});
+    return i == properties_.end() ? nullptr : i->second;
+  }
+
+ private:
+  struct PropertyKey {
+    const XmpPropertyInfo* pl_;
+    std::string_view name_;
+    bool operator==(const PropertyKey& rhs) const {
+      return pl_ == rhs.pl_ && name_ == rhs.name_;
+    }
+  };
+  struct PropertyKeyHash {
+    size_t operator()(const PropertyKey& key) const {
+      return std::hash<std::string_view>{}(key.name_) ^ (std::hash<const void*>{}(key.pl_) << 1);
+    }
+  };
+
+  std::unordered_map<std::string_view, const XmpNsInfo*> byPrefix_;
+  std::unordered_map<std::string_view, const XmpNsInfo*> byNs_;
+  std::unordered_map<PropertyKey, const XmpPropertyInfo*, PropertyKeyHash> properties_;
+};
+
+//! Return the index, which is built on first use and never changes afterwards
+const BuiltinXmpIndex& builtinIndex() {
+  static const BuiltinXmpIndex index;
+  return index;
+}
+
+/*!
+  @brief Number of namespaces in XmpProperties::nsRegistry_. Only changed with
+         the XMP lock held. While it is zero, lookups use the built-in index
+         only and need no lock.
+ */
+std::atomic<size_t> customNamespaces{0};
+
+bool hasCustomNamespaces() {
+  return customNamespaces.load(std::memory_order_acquire) != 0;
+}
+
+const XmpNsInfo* builtinNsInfo(const std::string& prefix) {
+  auto xn = builtinIndex().nsInfo(prefix);
+  if (!xn)
+    throw Error(ErrorCode::kerNoNamespaceInfoForXmpPrefix, prefix);
+  return xn;
+}
+
+/*!
+  @brief Find the property info of \em key, using \em nsInfo to look up the
+         schema of a prefix. \em nsInfo throws if the prefix is unknown.
+ */
+template <typename NsInfoFct>
+const XmpPropertyInfo* findPropertyInfo(const XmpKey& key, NsInfoFct&& nsInfo) {
+  std::string prefix = key.groupName();
+  std::string property = key.tagName();
+  // If property is a path for a nested property, determines the innermost element
+  if (auto i = property.find_last_of('/'); i != std::string::npos) {
+    i = std::distance(property.begin(), std::find_if(property.begin() + i, property.end(), isalpha));
+    property = property.substr(i);
+    i = property.find_first_of(':');
+    if (i != std::string::npos) {
+      prefix = property.substr(0, i);
+      property = property.substr(i + 1);
+    }
+#ifdef EXIV2_DEBUG_MESSAGES
+    std::cout << "Nested key: " << key.key() << ", prefix: " << prefix << ", property: " << property << "\n";
+#endif
+  }
+  if (auto pl = nsInfo(prefix)->xmpPropertyInfo_)
+    return builtinIndex().propertyInfo(pl, property);
+  return nullptr;
+}
+}  // namespace
+
 XmpProperties::NsRegistry XmpProperties::nsRegistry_;
 std::mutex& XmpProperties::getMutex() {
   static std::mutex m;
@@ -5011,6 +5118,7 @@ void XmpProperties::registerNsUnlocked(const std::string& ns, const std::string&
   xn.xmpPropertyInfo_ = nullptr;
   xn.desc_ = "";
   nsRegistry_[ns2] = xn;
+  customNamespaces.store(nsRegistry_.size(), std::memory_order_release);
 }
 
 void XmpProperties::unregisterNs(const std::string& ns) {
@@ -5028,6 +5136,7 @@ void XmpProperties::unregisterNsNoLock(const std::string& ns, LifetimeKey) {
     delete[] i->second.prefix_;
     delete[] i->second.ns_;
     nsRegistry_.erase(i);
+    customNamespaces.store(nsRegistry_.size(), std::memory_order_release);
   }
 }
 
@@ -5049,6 +5158,13 @@ void XmpProperties::unregisterAllNsNoLock(LifetimeKey) {
 }
 
 std::string XmpProperties::prefix(const std::string& ns) {
+  if (!hasCustomNamespaces()) {
+    std::string ns2 = ns;
+    if (ns2.back() != '/' && ns2.back() != '#')
+      ns2 += '/';
+    auto xn = builtinIndex().nsInfoByNs(ns2);
+    return xn ? xn->prefix_ : "";
+  }
   XmpLock lock;
   return prefixUnlocked(ns, lock);
 }
@@ -5062,12 +5178,14 @@ std::string XmpProperties::prefixUnlocked(const std::string& ns, const XmpLock&)
   std::string p;
   if (i != nsRegistry_.end())
     p = i->second.prefix_;
-  else if (auto xn = Exiv2::find(xmpNsInfo, XmpNsInfo::Ns{std::move(ns2)}))
+  else if (auto xn = builtinIndex().nsInfoByNs(ns2))
     p = std::string(xn->prefix_);
   return p;
 }
 
 std::string XmpProperties::ns(const std::string& prefix) {
+  if (!hasCustomNamespaces())
+    return builtinNsInfo(prefix)->ns_;
   XmpLock lock;
   return nsUnlocked(prefix, lock);
 }
@@ -5079,6 +5197,10 @@ std::string XmpProperties::nsUnlocked(const std::string& prefix, const XmpLock&
 }
 
 const char* XmpProperties::propertyTitle(const XmpKey& key) {
+  if (!hasCustomNamespaces()) {
+    const XmpPropertyInfo* pi = findPropertyInfo(key, builtinNsInfo);
+    return pi ? pi->title_ : nullptr;
+  }
   XmpLock lock;
   return propertyTitleUnlocked(key, lock);
 }
@@ -5089,6 +5211,10 @@ const char* XmpProperties::propertyTitleUnlocked(const XmpKey& key, const XmpLoc
 }
 
 const char* XmpProperties::propertyDesc(const XmpKey& key) {
+  if (!hasCustomNamespaces()) {
+    const XmpPropertyInfo* pi = findPropertyInfo(key, builtinNsInfo);
+    return pi ? pi->desc_ : nullptr;
+  }
   XmpLock lock;
   return propertyDescUnlocked(key, lock);
 }
@@ -5099,6 +5225,10 @@ const char* XmpProperties::propertyDescUnlocked(const XmpKey& key, const XmpLock
 }
 
 TypeId XmpProperties::propertyType(const XmpKey& key) {
+  if (!hasCustomNamespaces()) {
+    const XmpPropertyInfo* pi = findPropertyInfo(key, builtinNsInfo);
+    return pi ? pi->typeId_ : xmpText;
+  }
   XmpLock lock;
   return propertyTypeUnlocked(key, lock);
 }
@@ -5109,38 +5239,20 @@ TypeId XmpProperties::propertyTypeUnlocked(const XmpKey& key, const XmpLock& loc
 }
 
 const XmpPropertyInfo* XmpProperties::propertyInfo(const XmpKey& key) {
+  if (!hasCustomNamespaces())
+    return findPropertyInfo(key, builtinNsInfo);
   XmpLock lock;
   return propertyInfoUnlocked(key, lock);
 }
 
 const XmpPropertyInfo* XmpProperties::propertyInfoUnlocked(const XmpKey& key, const XmpLock& lock) {
-  std::string prefix = key.groupName();
-  std::string property = key.tagName();
-  // If property is a path for a nested property, determines the innermost element
-  if (auto i = property.find_last_of('/'); i != std::string::npos) {
-    i = std::distance(property.begin(), std::find_if(property.begin() + i, property.end(), isalpha));
-    property = property.substr(i);
-    i = property.find_first_of(':');
-    if (i != std::string::npos) {
-      prefix = property.substr(0, i);
-      property = property.substr(i + 1);
-    }
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cout << "Nested key: " << key.key() << ", prefix: " << prefix << ", property: " << property << "\n";
-#endif
-  }
-  if (auto pl = propertyListUnlocked(prefix, lock)) {
-    for (size_t j = 0; pl[j].name_; ++j) {
-      if (property == pl[j].name_) {
-        return pl + j;
-      }
-    }
-  }
-  return nullptr;
+  return findPropertyInfo(key, [&lock](const std::string& prefix) { return nsInfoUnlocked(prefix, lock); });
 }
 
 /// \todo not used internally. At least we should test it
 const char* XmpProperties::nsDesc(const std::string& prefix) {
+  if (!hasCustomNamespaces())
+    return builtinNsInfo(prefix)->desc_;
   XmpLock lock;
   return nsDescUnlocked(prefix, lock);
 }
@@ -5150,6 +5262,8 @@ const char* XmpProperties::nsDescUnlocked(const std::string& prefix, const XmpLo
 }
 
 const XmpPropertyInfo* XmpProperties::propertyList(const std::string& prefix) {
+  if (!hasCustomNamespaces())
+    return builtinNsInfo(prefix)->xmpPropertyInfo_;
   XmpLock lock;
   return propertyListUnlocked(prefix, lock);
 }
@@ -5159,18 +5273,16 @@ const XmpPropertyInfo* XmpProperties::propertyListUnlocked(const std::string& pr
 }
 
 const XmpNsInfo* XmpProperties::nsInfo(const std::string& prefix) {
+  if (!hasCustomNamespaces())
+    return builtinNsInfo(prefix);
   XmpLock lock;
   return nsInfoUnlocked(prefix, lock);
 }
 
 const XmpNsInfo* XmpProperties::nsInfoUnlocked(const std::string& prefix, const XmpLock& lock) {
-  const auto pf = XmpNsInfo::Prefix{prefix};
-  const XmpNsInfo* xn = lookupNsRegistryUnlocked(pf, lock);
-  if (!xn)
-    xn = Exiv2::find(xmpNsInfo, pf);
-  if (!xn)
-    throw Error(ErrorCode::kerNoNamespaceInfoForXmpPrefix, prefix);
-  return xn;
+  if (auto xn = lookupNsRegistryUnlocked(XmpNsInfo::Prefix{prefix}, lock))
+    return xn;
+  return builtinNsInfo(prefix);
 }
 
 void XmpProperties::registeredNamespaces(Exiv2::Dictionary& nsDict) {
@@ -5229,6 +5341,8 @@ struct XmpKey::Impl {
   */
   void decomposeKey(const std::string& key);  //!< Mysterious magic
   void decomposeKeyUnlocked(const std::string& key, const XmpProperties::XmpLock&);
+  //! Split \em key into its prefix and property name
+  static std::pair<std::string, std::string> splitKey(const std::string& key);
 
   // DATA
   static constexpr auto familyName_ = "Xmp";  //!< "Xmp"
@@ -5238,8 +5352,15 @@ struct XmpKey::Impl {
 };
 
 //! @brief Constructor for Internal Pimpl structure XmpKey::Impl::Impl
-XmpKey::Impl::Impl(const std::string& prefix, const std::string& property) :
-    Impl(prefix, property, XmpProperties::XmpLock()) {
+XmpKey::Impl::Impl(const std::string& prefix, const std::string& property) {
+  if (hasCustomNamespaces()) {
+    *this = Impl(prefix, property, XmpProperties::XmpLock());
+    return;
+  }
+  // Only built-in namespaces, the prefix is validated without the lock
+  builtinNsInfo(prefix);
+  property_ = property;
+  prefix_ = prefix;
 }
 
 XmpKey::Impl::Impl(const std::string& prefix, const std::string& property, const XmpProperties::XmpLock& lock) {
@@ -5303,16 +5424,14 @@ std::string XmpKey::tagName() const {
 }
 
 std::string XmpKey::tagLabel() const {
-  XmpProperties::XmpLock lock;
-  const char* pt = XmpProperties::propertyTitleUnlocked(*this, lock);
+  const char* pt = XmpProperties::propertyTitle(*this);
   if (!pt)
     return tagName();
   return pt;
 }
 
 std::string XmpKey::tagDesc() const {
-  XmpProperties::XmpLock lock;
-  const char* pt = XmpProperties::propertyDescUnlocked(*this, lock);
+  const char* pt = XmpProperties::propertyDesc(*this);
   if (!pt)
     return "";
   return pt;
@@ -5323,17 +5442,35 @@ uint16_t XmpKey::tag() const {
 }
 
 std::string XmpKey::ns() const {
-  XmpProperties::XmpLock lock;
-  return XmpProperties::nsUnlocked(p_->prefix_, lock);
+  return XmpProperties::ns(p_->prefix_);
 }
 
 //! @cond IGNORE
 void XmpKey::Impl::decomposeKey(const std::string& key) {
-  XmpProperties::XmpLock lock;
-  decomposeKeyUnlocked(key, lock);
+  if (hasCustomNamespaces()) {
+    XmpProperties::XmpLock lock;
+    decomposeKeyUnlocked(key, lock);
+    return;
+  }
+  auto [prefix, property] = splitKey(key);
+  // Only built-in namespaces, the prefix is validated without the lock
+  builtinNsInfo(prefix);
+  property_ = std::move(property);
+  prefix_ = std::move(prefix);
 }  // XmpKey::Impl::decomposeKey
 
 void XmpKey::Impl::decomposeKeyUnlocked(const std::string& key, const XmpProperties::XmpLock& lock) {
+  auto [prefix, property] = splitKey(key);
+
+  // Validate prefix unlocked (must hold lock)
+  if (XmpProperties::nsUnlocked(prefix, lock).empty())
+    throw Error(ErrorCode::kerNoNamespaceForPrefix, prefix);
+
+  property_ = std::move(property);
+  prefix_ = std::move(prefix);
+}  // XmpKey::Impl::decomposeKeyUnlocked
+
+std::pair<std::string, std::string> XmpKey::Impl::splitKey(const std::string& key) {
   // Get the family name, prefix and property name parts of the key
   if (!key.starts_with(familyName_))
     throw Error(ErrorCode::kerInvalidKey, key);
@@ -5348,14 +5485,8 @@ void XmpKey::Impl::decomposeKeyUnlocked(const std::string& key, const XmpPropert
   std::string property = key.substr(pos1 + 1);
   if (property.empty())
     throw Error(ErrorCode::kerInvalidKey, key);
-
-  // Validate prefix unlocked (must hold lock)
-  if (XmpProperties::nsUnlocked(prefix, lock).empty())
-    throw Error(ErrorCode::kerNoNamespaceForPrefix, prefix);
-
-  property_ = std::move(property);
-  prefix_ = std::move(prefix);
-}  // XmpKey::Impl::decomposeKeyUnlocked
+  return {std::move(prefix), std::move(property)};
+}  // XmpKey::Impl::splitKey
 
 // *************************************************************************
 // free functions
@@ -10,6 +10,7 @@
 #include "futils.hpp"
 #include "image.hpp"
 #include "photoshop.hpp"
+#include "stats_int.hpp"
 
 #ifdef EXIV2_DEBUG_MESSAGES
 #include <iostream>
@@ -110,6 +111,7 @@ void PsdImage::setComment(const std::string&) {
 }
 
 void PsdImage::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Exiv2::PsdImage::readMetadata: Reading Photoshop file " << io_->path() << "\n";
 #endif
@@ -210,6 +212,8 @@ void PsdImage::readMetadata() {
 void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
   switch (resourceId) {
     case kPhotoshopResourceID::IPTC_NAA: {
+      if (!(readFilter() & mdIptc))
+        break;
       DataBuf rawIPTC(resourceSize);
       io_->read(rawIPTC.data(), rawIPTC.size());
       if (io_->error() || io_->eof())
@@ -224,11 +228,13 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
     }
 
     case kPhotoshopResourceID::ExifInfo: {
+      if (!(readFilter() & mdExif))
+        break;
       DataBuf rawExif(resourceSize);
       io_->read(rawExif.data(), rawExif.size());
       if (io_->error() || io_->eof())
         throw Error(ErrorCode::kerFailedToReadImageData);
-      ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size());
+      ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size(), makerNotePolicy());
       setByteOrder(bo);
       if (!rawExif.empty() && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
@@ -240,6 +246,8 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
     }
 
     case kPhotoshopResourceID::XMPPacket: {
+      if (!(readFilter() & mdXmp))
+        break;
       DataBuf xmpPacket(resourceSize);
       io_->read(xmpPacket.data(), xmpPacket.size());
       if (io_->error() || io_->eof())
@@ -313,6 +321,7 @@ void PsdImage::writeMetadata() {
   }
   IoCloser closer(*io_);
   MemIo tempIo;
+  tempIo.reserve(io_->size());
 
   doWriteMetadata(tempIo);  // may throw
   io_->close();
@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "scanner.hpp"
+#include "basicio.hpp"
+#include "config.h"
+#include "futils.hpp"
+#include "metadatacache.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// *****************************************************************************
+namespace {
+using namespace Exiv2;
+
+//! A file taken from the source
+struct ScanItem {
+  size_t index_{0};        //!< Position of the file in the input
+  std::string path_;       //!< Path of the file
+  BasicIo::UniquePtr io_;  //!< IO with the prefetched start of the file, nullptr to open the path
+};
+
+/*!
+  @brief Return an IO with the first \em size bytes of the local file \em path in memory. Return nullptr
+      for other paths and if the default FileIo backend cannot prefetch.
+ */
+BasicIo::UniquePtr prefetchFile(const std::string& path, size_t size) {
+#ifdef EXV_ENABLE_FILESYSTEM
+  if (FileIo::defaultBackend() == FileIo::Backend::positional && fileProtocol(path) == pFile) {
+    auto io = std::make_unique<FileIo>(path);
+    // A failure shows when the image is opened
+    io->prefetch(size);
+    return io;
+  }
+#endif
+  return nullptr;
+}
+
+//! Open, read and optionally modify and write the file of \em item, using \em options
+ScanResult scanFile(ScanItem item, const MetadataScanner::Modifier& modifier, const ScanOptions& options) {
+  ScanResult result;
+  result.index_ = item.index_;
+  result.path_ = std::move(item.path_);
+  try {
+    Image::UniquePtr image;
+    if (item.io_) {
+      image = ImageFactory::open(std::move(item.io_));
+      if (!image)
+        throw Error(ErrorCode::kerFileContainsUnknownImageType, result.path_);
+    } else {
+      image = ImageFactory::open(result.path_);
+    }
+    image->setMakerNotePolicy(options.makerNotePolicy_);
+#ifdef EXV_ENABLE_FILESYSTEM
+    // A modifier gets the metadata as read from the file, as the image is written from it
+    MetadataCache* cache = options.makerNotePolicy_ == MakerNotePolicy::none || modifier ? nullptr : options.cache_;
+    if (!cache || !cache->read(*image)) {
+      image->readMetadata();
+      if (cache)
+        cache->write(*image);
+    }
+#else
+    image->readMetadata();
+#endif
+    result.image_ = std::move(image);
+    if (modifier) {
+      modifier(*result.image_);
+      result.image_->writeMetadata();
+    }
+  } catch (const Error& e) {
+    result.errorCode_ = e.code();
+    result.error_ = e.what();
+  } catch (const std::exception& e) {
+    result.errorCode_ = ErrorCode::kerErrorMessage;
+    result.error_ = e.what();
+  } catch (...) {
+    result.errorCode_ = ErrorCode::kerErrorMessage;
+    result.error_ = "Unknown exception";
+  }
+  return result;
+}
+
+/*!
+  @brief State shared by the workers, the I/O threads and the calling thread
+      of one scan.
+
+  Workers take the next path from the source when there is room for another
+  pending file, so a fast worker keeps pulling work while a slow one is busy
+  with a large file. With prefetching, the I/O threads take the paths instead
+  and queue the files they read ahead for the workers. Finished results are
+  handed to the calling thread, which passes them to the callback and makes
+  room for the next file.
+ */
+class ScanBatch {
+ public:
+  ScanBatch(const MetadataScanner::Source& next, ScanOrder order, size_t maxPending, size_t prefetchSize) :
+      next_(next), order_(order), maxPending_(maxPending), prefetchSize_(prefetchSize) {
+  }
+
+  //! Process files until the input is exhausted or the batch is stopped
+  void work(const MetadataScanner::Modifier& modifier, const ScanOptions& options) {
+    ScanItem item;
+    while (prefetchSize_ == 0 ? claim(item) : dequeue(item)) {
+      const size_t index = item.index_;
+      auto result = scanFile(std::move(item), modifier, options);
+      std::scoped_lock lock(mutex_);
+      ready_.try_emplace(index, std::move(result));
+      resultCv_.notify_one();
+    }
+    MemIo::releasePool();
+    std::scoped_lock lock(mutex_);
+    --running_;
+    resultCv_.notify_one();
+  }
+
+  //! Read ahead files for the workers until the input is exhausted or the batch is stopped
+  void prefetch() {
+    ScanItem item;
+    while (claim(item)) {
+      item.io_ = prefetchFile(item.path_, prefetchSize_);
+      std::scoped_lock lock(mutex_);
+      --fetching_;
+      queue_.push_back(std::move(item));
+      queueCv_.notify_all();
+    }
+  }
+
+  //! Pass the results to \em callback until all workers are done, return the number of failed files
+  size_t deliver(const MetadataScanner::Callback& callback) {
+    size_t failed = 0;
+    std::unique_lock lock(mutex_);
+    while (true) {
+      resultCv_.wait(lock, [this] { return stop_ || hasReady() || running_ == 0; });
+      if (stop_ || !hasReady())
+        break;
+      auto node = ready_.extract(ready_.begin());
+      lock.unlock();
+      if (!node.mapped().ok())
+        ++failed;
+      callback(node.mapped());
+      // Release the image before making room for the next file
+      node = {};
+      lock.lock();
+      ++delivered_;
+      roomCv_.notify_one();
+    }
+    return failed;
+  }
+
+  //! Register a worker thread
+  void addWorker() {
+    std::scoped_lock lock(mutex_);
+    ++running_;
+  }
+
+  //! Let the workers and I/O threads finish their current file and exit
+  void stop() {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+    roomCv_.notify_all();
+    queueCv_.notify_all();
+  }
+
+  //! Return the exception thrown by the source, if any
+  [[nodiscard]] std::exception_ptr error() const {
+    std::scoped_lock lock(mutex_);
+    return error_;
+  }
+
+ private:
+  //! Wait for room and take the next path from the source, return false if there is none
+  bool claim(ScanItem& item) {
+    std::unique_lock lock(mutex_);
+    roomCv_.wait(lock, [this] { return stop_ || exhausted_ || claimed_ - delivered_ < maxPending_; });
+    if (stop_ || exhausted_)
+      return false;
+    try {
+      if (!next_(item.path_)) {
+        exhausted_ = true;
+        roomCv_.notify_all();
+        queueCv_.notify_all();
+        return false;
+      }
+    } catch (...) {
+      error_ = std::current_exception();
+      stop_ = true;
+      roomCv_.notify_all();
+      queueCv_.notify_all();
+      resultCv_.notify_one();
+      return false;
+    }
+    item.index_ = claimed_++;
+    // Counted under the same lock, so that the workers do not miss the file at the end of the input
+    if (prefetchSize_ != 0)
+      ++fetching_;
+    return true;
+  }
+
+  //! Wait for a file read ahead by an I/O thread, return false if there will be none
+  bool dequeue(ScanItem& item) {
+    std::unique_lock lock(mutex_);
+    queueCv_.wait(lock, [this] { return stop_ || !queue_.empty() || (exhausted_ && fetching_ == 0); });
+    if (stop_ || queue_.empty())
+      return false;
+    item = std::move(queue_.front());
+    queue_.pop_front();
+    return true;
+  }
+
+  //! Return true if a result can be passed to the callback
+  [[nodiscard]] bool hasReady() const {
+    if (ready_.empty())
+      return false;
+    return order_ == ScanOrder::completion || ready_.begin()->first == delivered_;
+  }
+
+  // DATA
+  const MetadataScanner::Source& next_;  //!< Source of the paths
+  const ScanOrder order_;                //!< Order of the results
+  const size_t maxPending_;              //!< Maximum number of files claimed but not delivered
+  const size_t prefetchSize_;            //!< Number of bytes read ahead per file, 0 for none
+
+  mutable std::mutex mutex_;            //!< Protects all members below
+  std::condition_variable roomCv_;      //!< Signals room for another file to the workers or I/O threads
+  std::condition_variable queueCv_;     //!< Signals a file read ahead or the end of the input to the workers
+  std::condition_variable resultCv_;    //!< Signals a result or a finished worker to the calling thread
+  std::deque<ScanItem> queue_;          //!< Files read ahead, waiting for a worker
+  std::map<size_t, ScanResult> ready_;  //!< Results waiting for the callback, by index
+  size_t claimed_{0};                   //!< Number of paths taken from the source
+  size_t delivered_{0};                 //!< Number of results passed to the callback
+  size_t fetching_{0};                  //!< Number of files being read ahead
+  size_t running_{0};                   //!< Number of workers which have not exited
+  bool exhausted_{false};               //!< Set when the source has no more paths
+  bool stop_{false};                    //!< Set when the batch is aborted
+  std::exception_ptr error_;            //!< Exception thrown by the source
+};
+}  // namespace
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2 {
+MetadataScanner::MetadataScanner(const ScanOptions& options) : options_(options) {
+}
+
+void MetadataScanner::setModifier(Modifier modifier) {
+  modifier_ = std::move(modifier);
+}
+
+size_t MetadataScanner::scan(const std::vector<std::string>& paths, const Callback& callback) const {
+  auto pos = paths.begin();
+  return scan(
+      [&](std::string& path) {
+        if (pos == paths.end())
+          return false;
+        path = *pos++;
+        return true;
+      },
+      callback);
+}
+
+size_t MetadataScanner::scan(const Source& next, const Callback& callback) const {
+  size_t threads = options_.threads_;
+  if (threads == 0)
+    threads = std::max(std::thread::hardware_concurrency(), 1U);
+  const size_t maxPending = std::max(options_.maxPending_ == 0 ? 2 * threads : options_.maxPending_, threads);
+
+  ScanBatch batch(next, options_.order_, maxPending, options_.prefetchSize_);
+  std::vector<std::thread> workers;
+  workers.reserve(options_.prefetchSize_ == 0 ? threads : 2 * threads);
+  size_t failed = 0;
+  std::exception_ptr error;
+  try {
+    for (size_t i = 0; i < threads; ++i) {
+      batch.addWorker();
+      workers.emplace_back(&ScanBatch::work, &batch, std::cref(modifier_), std::cref(options_));
+      if (options_.prefetchSize_ != 0)
+        workers.emplace_back(&ScanBatch::prefetch, &batch);
+    }
+    failed = batch.deliver(callback);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  batch.stop();
+  for (auto& worker : workers)
+    worker.join();
+  // The images delivered to the callback gave their blocks to the pool of this thread
+  MemIo::releasePool();
+  if (!error)
+    error = batch.error();
+  if (error)
+    std::rethrow_exception(error);
+  return failed;
+}
+
+}  // namespace Exiv2
@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "serializer.hpp"
+#include "error.hpp"
+#include "image.hpp"
+#include "properties.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+/*
+  Layout of the serialized metadata. All numbers are unsigned and little
+  endian, strings are preceded by their size (u32).
+
+  Header    "Exiv2MDB", u16 format version, u16 byte order of the Exif values ("II" or "MM")
+  Exif      u32 count, then per metadatum:
+            u16 IFD id, u16 tag, u32 type id, u32 index, u32 value size, u32 data area size, value, data area
+  IPTC      u32 count, then per dataset:
+            u16 record, u16 dataset, u32 type id, u32 value size, value (big endian)
+  XMP       u32 number of namespaces, then per namespace: prefix, URI
+            u32 count, then per property:
+            u32 namespace index, property path, u32 type id, u8 array type, u8 struct indicator,
+            u32 number of items, u32 size of the items, items
+            Each item is a string, for language alternatives a language and a text.
+ */
+
+// *****************************************************************************
+namespace {
+using namespace Exiv2;
+
+//! Signature and format version at the start of serialized metadata
+constexpr std::array<byte, 10> header{'E', 'x', 'i', 'v', '2', 'M', 'D', 'B', 1, 0};
+
+//! Sequential reader of serialized metadata, throws if the data ends prematurely
+class Reader {
+ public:
+  Reader(const byte* pData, size_t size) : pData_(pData), size_(size) {
+  }
+
+  //! Return the next \em n bytes
+  const byte* take(size_t n) {
+    if (n > size_ - pos_)
+      throw Error(ErrorCode::kerCorruptedMetadata);
+    const byte* p = pData_ + pos_;
+    pos_ += n;
+    return p;
+  }
+  uint8_t u8() {
+    return *take(1);
+  }
+  uint16_t u16() {
+    return getUShort(take(2), littleEndian);
+  }
+  uint32_t u32() {
+    return getULong(take(4), littleEndian);
+  }
+  std::string_view string() {
+    const size_t n = u32();
+    return {reinterpret_cast<const char*>(take(n)), n};
+  }
+  //! Return true if all data was read
+  [[nodiscard]] bool atEnd() const {
+    return pos_ == size_;
+  }
+
+ private:
+  const byte* pData_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+void appendU16(Blob& blob, uint16_t v) {
+  byte buf[2];
+  us2Data(buf, v, littleEndian);
+  append(blob, buf, sizeof(buf));
+}
+
+void appendU32(Blob& blob, uint32_t v) {
+  byte buf[4];
+  ul2Data(buf, v, littleEndian);
+  append(blob, buf, sizeof(buf));
+}
+
+void appendString(Blob& blob, const std::string& s) {
+  appendU32(blob, static_cast<uint32_t>(s.size()));
+  append(blob, reinterpret_cast<const byte*>(s.data()), s.size());
+}
+
+//! Append the value of \em md as written by copy() to \em blob, return its size
+template <typename Metadatum>
+size_t appendValue(Blob& blob, const Metadatum& md, ByteOrder byteOrder) {
+  const size_t size = md.size();
+  const size_t pos = blob.size();
+  blob.resize(pos + size);
+  if (size != 0 && md.copy(blob.data() + pos, byteOrder) != size)
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  return size;
+}
+
+//! Append the items of the XMP value \em value, return their number
+uint32_t appendXmpItems(Blob& blob, const Xmpdatum& xmp) {
+  const Value& value = xmp.value();
+  if (xmp.typeId() == langAlt) {
+    const auto la = dynamic_cast<const LangAltValue*>(&value);
+    if (!la)
+      throw Error(ErrorCode::kerEncodeLangAltPropertyFailed, xmp.key());
+    for (const auto& [lang, text] : la->value_) {
+      appendString(blob, lang);
+      appendString(blob, text);
+    }
+    return static_cast<uint32_t>(la->value_.size());
+  }
+  if (!dynamic_cast<const XmpValue*>(&value))
+    throw Error(ErrorCode::kerInvalidKeyXmpValue, xmp.key(), xmp.typeName());
+  if (xmp.typeId() == xmpBag || xmp.typeId() == xmpSeq || xmp.typeId() == xmpAlt) {
+    for (size_t i = 0; i < value.count(); ++i)
+      appendString(blob, value.toString(i));
+    return static_cast<uint32_t>(value.count());
+  }
+  if (xmp.typeId() == xmpText) {
+    appendString(blob, dynamic_cast<const XmpTextValue&>(value).value_);
+    return 1;
+  }
+  throw Error(ErrorCode::kerUnhandledXmpdatum, xmp.tagName(), xmp.typeName());
+}
+
+//! Return true if \em typeId is the type id of an XMP value
+bool isXmpType(TypeId typeId) {
+  return typeId == xmpText || typeId == xmpAlt || typeId == xmpBag || typeId == xmpSeq || typeId == langAlt;
+}
+
+//! Return the prefix of the namespace \em ns, register it with \em prefix if it is not known
+std::string registeredPrefix(std::string_view prefix, std::string_view ns) {
+  const std::string uri(ns);
+  auto ret = XmpProperties::prefix(uri);
+  if (ret.empty()) {
+    ret = prefix;
+    XmpProperties::registerNs(uri, ret);
+  }
+  return ret;
+}
+}  // namespace
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2 {
+ExifKey MetadataView::ExifEntry::key() const {
+  ExifKey key(tag_, ifdId_);
+  key.setIdx(idx_);
+  return key;
+}
+
+Value::UniquePtr MetadataView::ExifEntry::value() const {
+  if (typeId_ == invalidTypeId)
+    return nullptr;
+  auto value = Value::create(typeId_);
+  value->read(data_, size_, byteOrder_);
+  if (sizeDataArea_ != 0)
+    value->setDataArea(dataArea_, sizeDataArea_);
+  return value;
+}
+
+IptcKey MetadataView::IptcEntry::key() const {
+  return IptcKey(dataset_, record_);
+}
+
+Value::UniquePtr MetadataView::IptcEntry::value() const {
+  if (typeId_ == invalidTypeId)
+    return nullptr;
+  auto value = Value::create(typeId_);
+  value->read(data_, size_, bigEndian);
+  return value;
+}
+
+XmpKey MetadataView::XmpEntry::key() const {
+  return XmpKey(registeredPrefix(prefix_, ns_), std::string(property_));
+}
+
+Value::UniquePtr MetadataView::XmpEntry::value() const {
+  if (typeId_ == invalidTypeId)
+    return nullptr;
+  auto value = Value::create(typeId_);
+  auto& xmpValue = dynamic_cast<XmpValue&>(*value);
+  xmpValue.setXmpArrayType(arrayType_);
+  xmpValue.setXmpStruct(struct_);
+  Reader items(data_, size_);
+  for (size_t i = 0; i < count_; ++i) {
+    if (typeId_ == langAlt) {
+      const auto lang = items.string();
+      dynamic_cast<LangAltValue&>(*value).value_[std::string(lang)] = items.string();
+    } else if (typeId_ == xmpText) {
+      dynamic_cast<XmpTextValue&>(*value).value_ = items.string();
+    } else {
+      value->read(std::string(items.string()));
+    }
+  }
+  return value;
+}
+
+MetadataView::MetadataView(const byte* pData, size_t size) {
+  Reader reader(pData, size);
+  if (std::memcmp(reader.take(header.size()), header.data(), header.size()) != 0)
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  const uint16_t order = reader.u16();
+  if (order == 0x4949) {
+    byteOrder_ = littleEndian;
+  } else if (order == 0x4d4d) {
+    byteOrder_ = bigEndian;
+  } else {
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  }
+
+  // Each entry takes at least a few bytes, this bounds the reservations below
+  uint32_t count = reader.u32();
+  exifData_.reserve(std::min<size_t>(count, size / 20));
+  for (uint32_t i = 0; i < count; ++i) {
+    ExifEntry& entry = exifData_.emplace_back();
+    const uint16_t ifdId = reader.u16();
+    if (ifdId == static_cast<uint16_t>(IfdId::ifdIdNotSet) || ifdId >= static_cast<uint16_t>(IfdId::lastId))
+      throw Error(ErrorCode::kerCorruptedMetadata);
+    entry.ifdId_ = static_cast<IfdId>(ifdId);
+    entry.tag_ = reader.u16();
+    entry.typeId_ = static_cast<TypeId>(reader.u32());
+    entry.idx_ = static_cast<int>(reader.u32());
+    entry.byteOrder_ = byteOrder_;
+    entry.size_ = reader.u32();
+    entry.sizeDataArea_ = reader.u32();
+    entry.data_ = reader.take(entry.size_);
+    entry.dataArea_ = reader.take(entry.sizeDataArea_);
+  }
+
+  count = reader.u32();
+  iptcData_.reserve(std::min<size_t>(count, size / 12));
+  for (uint32_t i = 0; i < count; ++i) {
+    IptcEntry& entry = iptcData_.emplace_back();
+    entry.record_ = reader.u16();
+    entry.dataset_ = reader.u16();
+    entry.typeId_ = static_cast<TypeId>(reader.u32());
+    entry.size_ = reader.u32();
+    entry.data_ = reader.take(entry.size_);
+  }
+
+  count = reader.u32();
+  std::vector<std::pair<std::string_view, std::string_view>> namespaces;
+  namespaces.reserve(std::min<size_t>(count, size / 8));
+  for (uint32_t i = 0; i < count; ++i) {
+    const auto prefix = reader.string();
+    const auto ns = reader.string();
+    // Empty names cannot be registered
+    if (prefix.empty() || ns.empty())
+      throw Error(ErrorCode::kerCorruptedMetadata);
+    namespaces.emplace_back(prefix, ns);
+  }
+  count = reader.u32();
+  xmpData_.reserve(std::min<size_t>(count, size / 22));
+  for (uint32_t i = 0; i < count; ++i) {
+    XmpEntry& entry = xmpData_.emplace_back();
+    const uint32_t ns = reader.u32();
+    if (ns >= namespaces.size())
+      throw Error(ErrorCode::kerCorruptedMetadata);
+    entry.prefix_ = namespaces[ns].first;
+    entry.ns_ = namespaces[ns].second;
+    entry.property_ = reader.string();
+    entry.typeId_ = static_cast<TypeId>(reader.u32());
+    entry.arrayType_ = static_cast<XmpValue::XmpArrayType>(reader.u8());
+    entry.struct_ = static_cast<XmpValue::XmpStruct>(reader.u8());
+    entry.count_ = reader.u32();
+    entry.size_ = reader.u32();
+    entry.data_ = reader.take(entry.size_);
+    if ((entry.typeId_ != invalidTypeId && !isXmpType(entry.typeId_)) || entry.arrayType_ > XmpValue::xaSeq ||
+        entry.struct_ > XmpValue::xsStruct)
+      throw Error(ErrorCode::kerCorruptedMetadata);
+    // Check the items, so that value() cannot fail
+    Reader items(entry.data_, entry.size_);
+    for (size_t j = 0; j < entry.count_; ++j) {
+      items.string();
+      if (entry.typeId_ == langAlt)
+        items.string();
+    }
+    if (!items.atEnd())
+      throw Error(ErrorCode::kerCorruptedMetadata);
+  }
+  if (!reader.atEnd())
+    throw Error(ErrorCode::kerCorruptedMetadata);
+}
+
+void MetadataSerializer::encode(Blob& blob, const ExifData& exifData, const IptcData& iptcData,
+                                const XmpData& xmpData, ByteOrder byteOrder) {
+  if (exifData.makerNotePending()) {
+    // The makernote tags are part of the metadata, whether they were decoded yet or not
+    ExifData decoded = exifData;
+    decoded.decodeMakerNote();
+    encode(blob, decoded, iptcData, xmpData, byteOrder);
+    return;
+  }
+  append(blob, header.data(), header.size());
+  appendU16(blob, byteOrder == bigEndian ? 0x4d4d : 0x4949);
+  if (byteOrder != bigEndian)
+    byteOrder = littleEndian;
+
+  appendU32(blob, static_cast<uint32_t>(exifData.count()));
+  for (const auto& md : exifData) {
+    appendU16(blob, static_cast<uint16_t>(md.ifdId()));
+    appendU16(blob, md.tag());
+    // A comment value reports its type as undefined, but has to be created as a comment
+    const bool isComment = md.typeId() == undefined && dynamic_cast<const CommentValue*>(&md.value());
+    appendU32(blob, isComment ? comment : md.typeId());
+    appendU32(blob, static_cast<uint32_t>(md.idx()));
+    const size_t sizePos = blob.size();
+    appendU32(blob, 0);
+    const DataBuf dataArea = md.typeId() == invalidTypeId ? DataBuf() : md.dataArea();
+    appendU32(blob, static_cast<uint32_t>(dataArea.size()));
+    ul2Data(blob.data() + sizePos, static_cast<uint32_t>(appendValue(blob, md, byteOrder)), littleEndian);
+    if (!dataArea.empty())
+      append(blob, dataArea.c_data(), dataArea.size());
+  }
+
+  appendU32(blob, static_cast<uint32_t>(iptcData.count()));
+  for (const auto& md : iptcData) {
+    appendU16(blob, md.record());
+    appendU16(blob, md.tag());
+    appendU32(blob, md.typeId());
+    const size_t sizePos = blob.size();
+    appendU32(blob, 0);
+    ul2Data(blob.data() + sizePos, static_cast<uint32_t>(appendValue(blob, md, bigEndian)), littleEndian);
+  }
+
+  // Intern the namespaces
+  std::unordered_map<std::string, uint32_t> namespaces;
+  Blob table;
+  for (const auto& xmp : xmpData) {
+    const auto prefix = xmp.groupName();
+    if (namespaces.try_emplace(prefix, static_cast<uint32_t>(namespaces.size())).second) {
+      appendString(table, prefix);
+      appendString(table, XmpProperties::ns(prefix));
+    }
+  }
+  appendU32(blob, static_cast<uint32_t>(namespaces.size()));
+  append(blob, table.data(), table.size());
+  appendU32(blob, static_cast<uint32_t>(xmpData.count()));
+  for (const auto& xmp : xmpData) {
+    appendU32(blob, namespaces.at(xmp.groupName()));
+    appendString(blob, xmp.tagName());
+    appendU32(blob, xmp.typeId());
+    uint8_t arrayType = XmpValue::xaNone;
+    uint8_t xmpStruct = XmpValue::xsNone;
+    if (auto val = xmp.typeId() == invalidTypeId ? nullptr : dynamic_cast<const XmpValue*>(&xmp.value())) {
+      arrayType = val->xmpArrayType();
+      xmpStruct = val->xmpStruct();
+    }
+    blob.push_back(arrayType);
+    blob.push_back(xmpStruct);
+    const size_t countPos = blob.size();
+    appendU32(blob, 0);
+    appendU32(blob, 0);
+    if (xmp.typeId() != invalidTypeId) {
+      ul2Data(blob.data() + countPos, appendXmpItems(blob, xmp), littleEndian);
+      ul2Data(blob.data() + countPos + 4, static_cast<uint32_t>(blob.size() - countPos - 8), littleEndian);
+    }
+  }
+}
+
+ByteOrder MetadataSerializer::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData,
+                                     size_t size) {
+  const MetadataView view(pData, size);
+  exifData.clear();
+  for (auto&& entry : view.exifData()) {
+    const auto value = entry.value();
+    exifData.add(entry.key(), value.get());
+  }
+  iptcData.clear();
+  for (auto&& entry : view.iptcData()) {
+    const auto value = entry.value();
+    iptcData.add(entry.key(), value.get());
+  }
+  xmpData.clear();
+  // Resolve each namespace once
+  std::unordered_map<std::string_view, std::string> prefixes;
+  for (auto&& entry : view.xmpData()) {
+    auto pos = prefixes.find(entry.ns_);
+    if (pos == prefixes.end())
+      pos = prefixes.try_emplace(entry.ns_, registeredPrefix(entry.prefix_, entry.ns_)).first;
+    const auto value = entry.value();
+    xmpData.add(XmpKey(pos->second, std::string(entry.property_)), value.get());
+  }
+  return view.byteOrder();
+}
+
+}  // namespace Exiv2
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "stats.hpp"
+#include "config.h"
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2 {
+void Stats::reset() {
+  *this = Stats();
+}
+
+bool statsEnabled() {
+#ifdef EXV_ENABLE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+Stats& threadStats() {
+  thread_local Stats stats;
+  return stats;
+}
+
+const char* statsPhaseName(StatsPhase phase) {
+  static constexpr std::array<const char*, statsPhaseCount> names{
+      "typeDetection", "segmentScan", "tiffParse", "makerNoteDecode", "xmpParse", "encode", "transfer",
+  };
+  return names.at(static_cast<size_t>(phase));
+}
+}  // namespace Exiv2
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "stats_int.hpp"
+
+#include <array>
+
+// *****************************************************************************
+// class member definitions
+namespace Exiv2::Internal {
+PhaseTimer::PhaseTimer(StatsPhase phase) : phase_(phase) {
+  thread_local std::array<int, statsPhaseCount> depth{};
+  depth_ = &depth.at(static_cast<size_t>(phase));
+  if ((*depth_)++ == 0)
+    start_ = std::chrono::steady_clock::now();
+}
+
+PhaseTimer::~PhaseTimer() {
+  if (--*depth_ != 0)
+    return;
+  auto& ps = threadStats().phase(phase_);
+  ++ps.calls_;
+  ps.time_ += std::chrono::steady_clock::now() - start_;
+}
+}  // namespace Exiv2::Internal
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef STATS_INT_HPP_
+#define STATS_INT_HPP_
+
+// *****************************************************************************
+// included header files
+#include "config.h"
+#include "stats.hpp"
+
+#include <chrono>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2::Internal {
+/*!
+  @brief Add the time from construction to destruction to the counters of
+         a phase of the calling thread. Only the outermost timer of a phase
+         counts if timers of the same phase nest.
+ */
+class PhaseTimer {
+ public:
+  //! Start timing \em phase
+  explicit PhaseTimer(StatsPhase phase);
+  //! Stop timing and update the counters
+  ~PhaseTimer();
+  PhaseTimer(const PhaseTimer&) = delete;
+  PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+ private:
+  StatsPhase phase_;
+  int* depth_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace Exiv2::Internal
+
+/*!
+  @brief Instrumentation macros. They compile to nothing unless the library is
+         built with EXIV2_ENABLE_STATS.
+
+  EXV_STATS_PHASE(phase) times the rest of the enclosing scope as \em phase,
+  EXV_STATS_ADD(counter, n) adds \em n to the Stats member \em counter.
+ */
+#ifdef EXV_ENABLE_STATS
+#define EXV_STATS_PHASE(phase) const Exiv2::Internal::PhaseTimer exvPhaseTimer(Exiv2::StatsPhase::phase)
+#define EXV_STATS_ADD(counter, n) (Exiv2::threadStats().counter += (n))
+#else
+#define EXV_STATS_PHASE(phase) static_cast<void>(0)
+#define EXV_STATS_ADD(counter, n) static_cast<void>(0)
+#endif
+
+#endif  // STATS_INT_HPP_
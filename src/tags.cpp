@@ -9,6 +9,7 @@
 #include "tags_int.hpp"
 #include "types.hpp"
 
+#include <cstring>
 #include <memory>
 
 // *****************************************************************************
@@ -143,10 +144,10 @@ struct ExifKey::Impl {
   //! @name Manipulators
   //@{
   /*!
-    @brief Set the key corresponding to the \em tag, \em ifdId and \em tagInfo.
-           The key is of the form '<b>Exif</b>.groupName.tagName'.
+    @brief Set the identity of the key to \em tag, \em ifdId and \em tagInfo.
+           The key string is only formatted when it is requested.
    */
-  void makeKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo);
+  void setKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo);
   /*!
     @brief Parse and convert the key string into tag and IFD Id.
            Updates data members if the string can be decomposed,
@@ -161,6 +162,8 @@ struct ExifKey::Impl {
   //@{
   //! Return the name of the tag
   [[nodiscard]] std::string tagName() const;
+  //! Return the key of the form '<b>Exif</b>.groupName.tagName'
+  [[nodiscard]] std::string key() const;
   //@}
 
   // DATA
@@ -170,8 +173,7 @@ struct ExifKey::Impl {
   uint16_t tag_{0};                  //!< Tag value
   IfdId ifdId_{IfdId::ifdIdNotSet};  //!< The IFD associated with this tag
   int idx_{0};                       //!< Unique id of the Exif key in the image
-  std::string groupName_;            //!< The group name
-  std::string key_;                  //!< %Key
+  const char* groupName_{""};        //!< The group name, owned by the group table
 };
 
 std::string ExifKey::Impl::tagName() const {
@@ -181,6 +183,17 @@ std::string ExifKey::Impl::tagName() const {
   return stringFormat("0x{:04x}", tag_);
 }
 
+std::string ExifKey::Impl::key() const {
+  // Unknown tags are named by their hex value (0xabcd)
+  const bool known = tagInfo_ && tagInfo_->tag_ != 0xffff;
+  const std::string hexName = known ? std::string() : tagName();
+  const std::string_view name = known ? std::string_view(tagInfo_->name_) : std::string_view(hexName);
+  std::string key;
+  key.reserve(std::strlen(familyName_) + std::strlen(groupName_) + name.size() + 2);
+  key.append(familyName_).append(1, '.').append(groupName_).append(1, '.').append(name);
+  return key;
+}
+
 void ExifKey::Impl::decomposeKey(const std::string& key) {
   // Get the family name, IFD name and tag name parts of the key
   std::string::size_type pos1 = key.find('.');
@@ -214,29 +227,27 @@ void ExifKey::Impl::decomposeKey(const std::string& key) {
   if (!tagInfo_)
     throw Error(ErrorCode::kerInvalidKey, key);
 
-  tag_ = tag;
-  ifdId_ = ifdId;
-  groupName_ = groupName;
-  // tagName() translates hex tag name (0xabcd) to a real tag name if there is one
-  key_ = familyName + "." + groupName + "." + tagName();
+  // key() translates hex tag name (0xabcd) to a real tag name if there is one
+  setKey(tag, ifdId, tagInfo_);
 }
 
-void ExifKey::Impl::makeKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo) {
+void ExifKey::Impl::setKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo) {
   tagInfo_ = tagInfo;
   tag_ = tag;
   ifdId_ = ifdId;
-  key_ = std::string(familyName_) + "." + groupName_ + "." + tagName();
+  groupName_ = Internal::groupName(ifdId);
 }
 
-ExifKey::ExifKey(uint16_t tag, const std::string& groupName) : p_(std::make_unique<Impl>()) {
-  IfdId ifdId = groupId(groupName);
+ExifKey::ExifKey(uint16_t tag, const std::string& groupName) : ExifKey(tag, groupId(groupName)) {
+}
+
+ExifKey::ExifKey(uint16_t tag, IfdId ifdId) : p_(std::make_unique<Impl>()) {
   // Todo: Test if this condition can be removed
   if (!Internal::isExifIfd(ifdId) && !Internal::isMakerIfd(ifdId)) {
     throw Error(ErrorCode::kerInvalidIfdId, ifdId);
   }
   if (auto ti = tagInfo(tag, ifdId)) {
-    p_->groupName_ = groupName;
-    p_->makeKey(tag, ifdId, ti);
+    p_->setKey(tag, ifdId, ti);
     return;
   }
   throw Error(ErrorCode::kerInvalidIfdId, ifdId);
@@ -247,8 +258,7 @@ ExifKey::ExifKey(const TagInfo& ti) : p_(std::make_unique<Impl>()) {
   if (!Internal::isExifIfd(ifdId) && !Internal::isMakerIfd(ifdId)) {
     throw Error(ErrorCode::kerInvalidIfdId, ifdId);
   }
-  p_->groupName_ = Exiv2::groupName(ifdId);
-  p_->makeKey(ti.tag_, ifdId, &ti);
+  p_->setKey(ti.tag_, ifdId, &ti);
 }
 
 ExifKey::ExifKey(const std::string& key) : p_(std::make_unique<Impl>()) {
@@ -272,7 +282,7 @@ void ExifKey::setIdx(int idx) const {
 }
 
 std::string ExifKey::key() const {
-  return p_->key_;
+  return p_->key();
 }
 
 const char* ExifKey::familyName() const {
@@ -328,6 +338,10 @@ int ExifKey::idx() const {
 // *************************************************************************
 // free functions
 
+bool operator==(const ExifKey& lhs, const ExifKey& rhs) {
+  return lhs.tag() == rhs.tag() && lhs.ifdId() == rhs.ifdId();
+}
+
 std::ostream& operator<<(std::ostream& os, const TagInfo& ti) {
   ExifKey exifKey(ti);
   // CSV encoded I am \"dead\" beat" => "I am ""dead"" beat"
@@ -2670,10 +2670,11 @@ std::ostream& printDegrees(std::ostream& os, const Value& value, const ExifData*
     const float ss = static_cast<float>(sec.first) / sec.second;
     os << dd << " deg ";
     os << mm << "' ";
-    std::ostringstream oss;
-    oss.copyfmt(os);
+    const auto prec = os.precision();
+    const auto fill = os.fill();
     os << std::fixed << std::setprecision(sec.second > 1 ? 2 : 0) << ss << "\"";
-    os.copyfmt(oss);
+    os.precision(prec);
+    os.fill(fill);
   } else {
     os << "(" << value << ")";
   }
@@ -2760,8 +2761,8 @@ std::ostream& printLensSpecification(std::ostream& os, const Value& value, const
       os << "-" << std::setprecision(5) << focalLength2;
   }
   os << "mm";
-  std::ostringstream oss;
-  oss.copyfmt(os);
+  const auto prec = os.precision();
+  const auto fill = os.fill();
 
   if (std::isgreater(fNumber1, 0.0f) || std::isgreater(fNumber2, 0.0f)) {
     os << " F";
@@ -2776,7 +2777,8 @@ std::ostream& printLensSpecification(std::ostream& os, const Value& value, const
         os << "-" << std::setprecision(2) << fNumber2;
     }
   }
-  os.copyfmt(oss);
+  os.precision(prec);
+  os.fill(fill);
   os.flags(f);
   return os;
 }
@@ -2801,14 +2803,15 @@ std::ostream& print0x0005(std::ostream& os, const Value& value, const ExifData*
 
 std::ostream& print0x0006(std::ostream& os, const Value& value, const ExifData*) {
   std::ios::fmtflags f(os.flags());
-  std::ostringstream oss;
-  oss.copyfmt(os);
+  const auto prec = os.precision();
+  const auto fill = os.fill();
   const int32_t d = value.toRational().second;
   if (d == 0)
     return os << "(" << value << ")";
   const int p = d > 1 ? 1 : 0;
   os << std::fixed << std::setprecision(p) << value.toFloat() << " m";
-  os.copyfmt(oss);
+  os.precision(prec);
+  os.fill(fill);
 
   os.flags(f);
   return os;
@@ -2822,8 +2825,8 @@ std::ostream& print0x0007(std::ostream& os, const Value& value, const ExifData*)
         return os << "(" << value << ")";
       }
     }
-    std::ostringstream oss;
-    oss.copyfmt(os);
+    const auto prec = os.precision();
+    const auto fill = os.fill();
     const double t = (3600.0 * value.toInt64(0)) + (60.0 * value.toInt64(1)) + value.toFloat(2);
     enforce<std::overflow_error>(std::isfinite(t), "Non-finite time value");
     int p = 0;
@@ -2840,7 +2843,8 @@ std::ostream& print0x0007(std::ostream& os, const Value& value, const ExifData*)
        << std::right << mm << ":" << std::setw(2 + (p * 2)) << std::setfill('0') << std::right << std::fixed
        << std::setprecision(p) << ss;
 
-    os.copyfmt(oss);
+    os.precision(prec);
+    os.fill(fill);
   } else {
     os << value;
   }
@@ -10,6 +10,8 @@
 
 #include "i18n.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
@@ -99,6 +101,43 @@ struct TagVocabulary {
   bool operator==(std::string_view key) const;
 };  // struct TagDetails
 
+//! Lookup tables with up to this many entries are searched linearly
+inline constexpr size_t linearLookupLimit = 16;
+
+/*!
+  @brief Indices of the entries of a TagDetails or StringTagDetails lookup
+         table, sorted by value and, for equal values, by position. Computed
+         at compile time for each table used with the print templates below.
+ */
+template <const auto& array>
+inline constexpr auto lookupIndex = [] {
+  static_assert(std::size(array) <= UINT16_MAX, "Lookup table too large for a 16 bit index");
+  std::array<uint16_t, std::size(array)> index{};
+  for (size_t i = 0; i < index.size(); ++i)
+    index[i] = static_cast<uint16_t>(i);
+  std::sort(index.begin(), index.end(), [](uint16_t a, uint16_t b) {
+    return array[a].val_ < array[b].val_ || (array[a].val_ == array[b].val_ && a < b);
+  });
+  return index;
+}();
+
+/*!
+  @brief Return the first entry of the lookup table \em array with value
+         \em key, like Exiv2::find(), or nullptr if there is none. Larger
+         tables are searched with a binary search in their lookupIndex.
+ */
+template <const auto& array, typename K>
+auto findDetails(const K& key) {
+  if constexpr (std::size(array) <= linearLookupLimit) {
+    return Exiv2::find(array, key);
+  } else {
+    const auto& index = lookupIndex<array>;
+    auto pos =
+        std::lower_bound(index.begin(), index.end(), key, [](uint16_t i, const K& k) { return array[i].val_ < k; });
+    return pos != index.end() && array[*pos] == key ? &array[*pos] : nullptr;
+  }
+}
+
 /*!
   @brief Generic pretty-print function to translate a full string value to a description
          by looking up a reference table.
@@ -107,11 +146,11 @@ template <size_t N, const StringTagDetails (&array)[N], typename T>
 std::ostream& printTagString(std::ostream& os, const T& value, const ExifData*) {
   static_assert(N > 0, "Passed zero length printTagString");
   if constexpr (std::is_same_v<T, Value>) {
-    if (auto td = Exiv2::find(array, value.toString(0)))
+    if (auto td = findDetails<array>(std::string_view(value.toString(0))))
       return os << _(td->label_);
     return os << "(" << value << ")";
   } else {
-    if (auto td = Exiv2::find(array, value))
+    if (auto td = findDetails<array>(std::string_view(value)))
       return os << _(td->label_);
     return os << "(" << value << ")";
   }
@@ -160,11 +199,11 @@ template <size_t N, const TagDetails (&array)[N], typename T>
 std::ostream& printTagNoError(std::ostream& os, const T& value, const ExifData*) {
   static_assert(N > 0, "Passed zero length printTagNoError");
   if constexpr (std::is_same_v<T, Value>) {
-    if (auto td = Exiv2::find(array, value.toInt64()))
+    if (auto td = findDetails<array>(value.toInt64()))
       return os << _(td->label_);
     return os << value;
   } else {
-    if (auto td = Exiv2::find(array, value))
+    if (auto td = findDetails<array>(static_cast<int64_t>(value)))
       return os << _(td->label_);
     return os << value;
   }
@@ -180,7 +219,7 @@ std::ostream& printTagNoError(std::ostream& os, const T& value, const ExifData*)
 template <size_t N, const TagDetails (&array)[N]>
 std::ostream& printTag(std::ostream& os, int64_t value, const ExifData*) {
   static_assert(N > 0, "Passed zero length printTag");
-  if (auto td = Exiv2::find(array, value))
+  if (auto td = findDetails<array>(value))
     return os << _(td->label_);
   return os << "(" << value << ")";
 }
@@ -9,6 +9,7 @@
 #include "makernote_int.hpp"
 #include "safe_op.hpp"
 #include "sonymn_int.hpp"
+#include "stats_int.hpp"
 #include "tags.hpp"
 #include "tags_int.hpp"
 #include "tiffimage_int.hpp"
@@ -17,6 +18,7 @@
 #include "value.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
@@ -33,6 +35,16 @@
 namespace {
 //! Add \em tobe - \em curr 0x00 filler bytes if necessary
 size_t fillGap(Exiv2::Internal::IoWrapper& ioWrapper, size_t curr, size_t tobe);
+
+//! Source of unique layout pass ids, shared by all threads
+std::atomic<uint64_t> lastLayoutEpoch{0};
+//! Id of the layout pass active on this thread, 0 if there is none
+thread_local uint64_t currentLayoutEpoch = 0;
+
+//! Bits of TiffComponent::LayoutCache::valid_
+constexpr uint8_t layoutSizeBit = 0x01;
+constexpr uint8_t layoutSizeDataBit = 0x02;
+constexpr uint8_t layoutSizeImageBit = 0x04;
 }  // namespace
 
 // *****************************************************************************
@@ -50,19 +62,47 @@ IoWrapper::IoWrapper(BasicIo& io, const byte* pHeader, size_t size, OffsetWriter
 }
 
 size_t IoWrapper::write(const byte* pData, size_t wcount) {
-  if (!wroteHeader_ && wcount > 0) {
-    io_.write(pHeader_, size_);
-    wroteHeader_ = true;
-  }
+  if (wcount > 0)
+    writeHeader();
   return io_.write(pData, wcount);
 }
 
 int IoWrapper::putb(byte data) {
+  writeHeader();
+  return io_.putb(data);
+}
+
+size_t IoWrapper::writeImage(const byte* pData, size_t wcount) {
+  if (!pSplices_ || wcount == 0 || pData < pSource_ || wcount > sourceSize_ ||
+      static_cast<size_t>(pData - pSource_) > sourceSize_ - wcount) {
+    return write(pData, wcount);
+  }
+  writeHeader();
+  const auto pos = io_.tell();
+  const auto offset = static_cast<size_t>(pData - pSource_);
+  // Extend the previous range if the data continues it, in the source and the output
+  if (!pSplices_->empty()) {
+    auto& last = pSplices_->back();
+    if (last.pos_ == pos && last.offset_ + last.size_ == offset) {
+      last.size_ += wcount;
+      return wcount;
+    }
+  }
+  pSplices_->push_back({pos, offset, wcount});
+  return wcount;
+}
+
+void IoWrapper::setSource(const byte* pSource, size_t size, Splices* pSplices) {
+  pSource_ = pSource;
+  sourceSize_ = size;
+  pSplices_ = pSource ? pSplices : nullptr;
+}
+
+void IoWrapper::writeHeader() {
   if (!wroteHeader_) {
     io_.write(pHeader_, size_);
     wroteHeader_ = true;
   }
-  return io_.putb(data);
 }
 
 void IoWrapper::setTarget(int id, size_t target) {
@@ -687,6 +727,7 @@ void TiffMnEntry::doAccept(TiffVisitor& visitor) {
 }  // TiffMnEntry::doAccept
 
 void TiffIfdMakernote::doAccept(TiffVisitor& visitor) {
+  EXV_STATS_PHASE(makerNoteDecode);
   if (visitor.go(TiffVisitor::geTraverse))
     visitor.visitIfdMakernote(this);
   if (visitor.go(TiffVisitor::geKnownMakernote))
@@ -1263,7 +1304,7 @@ size_t TiffImageEntry::doWriteImage(IoWrapper& ioWrapper, ByteOrder /*byteOrder*
 #endif
     len = 0;
     for (auto&& [f, s] : strips_) {
-      ioWrapper.write(f, s);
+      ioWrapper.writeImage(f, s);
       len += s;
       size_t align = s & 1;  // Align strip data to word boundary
       if (align)
@@ -1278,7 +1319,7 @@ size_t TiffImageEntry::doWriteImage(IoWrapper& ioWrapper, ByteOrder /*byteOrder*
 }  // TiffImageEntry::doWriteImage
 
 size_t TiffComponent::size() const {
-  return doSize();
+  return layoutSize(layoutSizeBit, &LayoutCache::size_, &TiffComponent::doSize);
 }
 
 size_t TiffDirectory::doSize() const {
@@ -1367,7 +1408,7 @@ size_t TiffBinaryElement::doSize() const {
 }
 
 size_t TiffComponent::sizeData() const {
-  return doSizeData();
+  return layoutSize(layoutSizeDataBit, &LayoutCache::sizeData_, &TiffComponent::doSizeData);
 }
 
 size_t TiffDirectory::doSizeData() const {
@@ -1402,7 +1443,38 @@ size_t TiffIfdMakernote::doSizeData() const {
 }
 
 size_t TiffComponent::sizeImage() const {
-  return doSizeImage();
+  return layoutSize(layoutSizeImageBit, &LayoutCache::sizeImage_, &TiffComponent::doSizeImage);
+}
+
+size_t TiffComponent::layoutSize(uint8_t bit, size_t LayoutCache::*value, size_t (TiffComponent::*fct)() const) const {
+  const uint64_t epoch = currentLayoutEpoch;
+  if (epoch == 0)
+    return (this->*fct)();
+  if (layout_.epoch_ != epoch) {
+    layout_.epoch_ = epoch;
+    layout_.valid_ = 0;
+  }
+  if (!(layout_.valid_ & bit)) {
+    layout_.*value = (this->*fct)();
+    layout_.valid_ |= bit;
+  }
+  return layout_.*value;
+}
+
+TiffLayout::TiffLayout(const TiffComponent& root) : prevEpoch_(currentLayoutEpoch) {
+  currentLayoutEpoch = ++lastLayoutEpoch;
+  // The size of the root visits every value and data area, its image size
+  // every image entry, so that writing only reads from the cache
+  [[maybe_unused]] auto size = root.size();
+  [[maybe_unused]] auto sizeImage = root.sizeImage();
+}
+
+TiffLayout::~TiffLayout() {
+  currentLayoutEpoch = prevEpoch_;
+}
+
+uint64_t TiffLayout::epoch() {
+  return currentLayoutEpoch;
 }
 
 size_t TiffDirectory::doSizeImage() const {
@@ -108,6 +108,15 @@ class TiffPathItem {
  */
 class IoWrapper {
  public:
+  //! A range of the source image which is spliced unchanged into the output
+  struct Splice {
+    size_t pos_;     //!< Position in the generated output at which the range is inserted
+    size_t offset_;  //!< Offset of the range in the source image
+    size_t size_;    //!< Size of the range in bytes
+  };
+  //! Source ranges in the order of their positions in the output
+  using Splices = std::vector<Splice>;
+
   //! @name Creators
   //@{
   /*!
@@ -135,17 +144,36 @@ class IoWrapper {
     by the data passed in the argument.
    */
   int putb(byte data);
+  /*!
+    @brief Write image data. If the data lies within the source set with
+           setSource(), only its range is recorded and the data is not
+           copied to the IO; the caller splices it into the output later.
+           Otherwise the same as write().
+   */
+  size_t writeImage(const byte* pData, size_t wcount);
+  /*!
+    @brief Let writeImage() record ranges of \em pSource in \em pSplices
+           instead of writing them. Positions are relative to the start of
+           the IO, including the header.
+   */
+  void setSource(const byte* pSource, size_t size, Splices* pSplices);
   //! Wrapper for OffsetWriter::setTarget(), using an int instead of the enum to reduce include deps
   void setTarget(int id, size_t target);
   //@}
 
  private:
+  //! Write the header to the IO, if it hasn't been written yet
+  void writeHeader();
+
   // DATA
   BasicIo& io_;              //! Reference for the IO instance.
   const byte* pHeader_;      //! Pointer to the header data.
   size_t size_;              //! Size of the header data.
   bool wroteHeader_{false};  //! Indicates if the header has been written.
   OffsetWriter* pow_;        //! Pointer to an offset-writer, if any, or 0
+  const byte* pSource_{};    //! Source of spliced image data, if any
+  size_t sourceSize_{};      //! Size of the source
+  Splices* pSplices_{};      //! Ranges of the source spliced into the output
 };
 
 /*!
@@ -333,6 +361,18 @@ class TiffComponent {
   //@}
 
  private:
+  //! Sizes of the component memoized during a layout pass, see TiffLayout
+  struct LayoutCache {
+    uint64_t epoch_{};    //!< Layout pass the cached sizes belong to
+    uint8_t valid_{};     //!< Bit mask of the sizes computed in that pass
+    size_t size_{};       //!< Cached result of doSize()
+    size_t sizeData_{};   //!< Cached result of doSizeData()
+    size_t sizeImage_{};  //!< Cached result of doSizeImage()
+  };
+
+  //! Return the result of \em fct, computed at most once per layout pass
+  size_t layoutSize(uint8_t bit, size_t LayoutCache::*value, size_t (TiffComponent::*fct)() const) const;
+
   // DATA
   uint16_t tag_;  //!< Tag that identifies the component
   IfdId group_;   //!< Group id for this component
@@ -341,6 +381,35 @@ class TiffComponent {
     a memory buffer. The buffer is allocated and freed outside of this class.
    */
   byte* pStart_{};
+  mutable LayoutCache layout_;  //!< Sizes memoized by the active layout pass
+};
+
+/*!
+  @brief Layout pass over a TIFF composite tree. While an instance is in
+         scope, size(), sizeData() and sizeImage() of every component are
+         computed once on the current thread and then served from a cache,
+         so that writing the tree no longer recomputes the sizes of the same
+         subtrees at every directory level. The constructor computes the
+         layout of the whole tree; the tree must not be modified until the
+         instance goes out of scope.
+ */
+class TiffLayout {
+ public:
+  //! @name Creators
+  //@{
+  //! Constructor, starts a layout pass and computes the sizes of \em root
+  explicit TiffLayout(const TiffComponent& root);
+  //! Destructor, ends the layout pass
+  ~TiffLayout();
+  TiffLayout(const TiffLayout&) = delete;
+  TiffLayout& operator=(const TiffLayout&) = delete;
+  //@}
+
+  //! Return the id of the layout pass active on this thread, 0 if there is none
+  static uint64_t epoch();
+
+ private:
+  uint64_t prevEpoch_;  //!< Layout pass active when this one started
 };
 
 //! TIFF mapping table for functions to decode special cases
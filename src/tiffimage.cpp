@@ -16,6 +16,7 @@
 
 #include <array>
 #include <iostream>
+#include <typeinfo>
 
 /* --------------------------------------------------------------------------
 
@@ -147,13 +148,18 @@ void TiffImage::readMetadata() {
   }
   clearMetadata();
 
-  ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size());
+  // Same as TiffParser::decode() for a standalone TIFF image, but honouring the read filter. A makernote which
+  // is not decoded now is decoded from the file later rather than from a copy of it
+  const BasicIo& io = *io_;
+  const auto path = typeid(io) == typeid(FileIo) ? io.path() : std::string();
+  ByteOrder bo = TiffParserWorker::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), Tag::root,
+                                          TiffMapping::findDecoder, nullptr, readFilter(), makerNotePolicy(), path);
   setByteOrder(bo);
 
   // read profile from the metadata
   Exiv2::ExifKey key("Exif.Image.InterColorProfile");
   auto pos = exifData_.findKey(key);
-  if (pos != exifData_.end()) {
+  if (pos != exifData_.end() && (readFilter() & mdIccProfile)) {
     size_t size = pos->count() * pos->typeSize();
     if (size == 0) {
       throw Error(ErrorCode::kerFailedToReadImageData);
@@ -163,6 +169,51 @@ void TiffImage::readMetadata() {
   }
 }
 
+DataBuf TiffImage::readExifThumbnail() {
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isTiffType(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "TIFF");
+  }
+
+  // Only the pages of the mapped file with IFD0, IFD1 and the thumbnail are read
+  const byte* pData = io_->mmap();
+  const auto [offset, size] = ExifThumbC::findJpeg(pData, io_->size());
+  if (size == 0)
+    return {};
+  return {pData + offset, size};
+}
+
+namespace {
+/*!
+  @brief Encode as TiffParser::encode() does. With \em spliceInPlace, \em pData
+         must be the mapped content of \em io, see TiffParserWorker::encode().
+ */
+WriteMethod encodeTiff(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
+                       const IptcData& iptcData, const XmpData& xmpData, bool spliceInPlace) {
+  // Delete IFDs which do not occur in TIFF images
+  static constexpr auto filteredIfds = std::array{
+      IfdId::panaRawId,
+  };
+  for (auto filteredIfd : filteredIfds) {
+#ifdef EXIV2_DEBUG_MESSAGES
+    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
+#endif
+    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), FindExifdatum(filteredIfd)), exifData.end());
+  }
+
+  TiffHeader header(byteOrder);
+  return TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Tag::root, TiffMapping::findEncoder,
+                                  &header, nullptr, spliceInPlace);
+}
+}  // namespace
+
 void TiffImage::writeMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing TIFF file " << io_->path() << "\n";
@@ -185,6 +236,15 @@ void TiffImage::writeMetadata() {
   }
   setByteOrder(bo);
 
+  // A makernote which is decoded from the file later must not see the file change
+  auto mn = exifData_.findKey(ExifKey(0x927c, IfdId::exifId));
+  if (auto pending = mn != exifData_.end() ? dynamic_cast<const PendingMakerNote*>(&mn->value()) : nullptr;
+      pending && pData && !pending->path().empty() && pending->path() == io_->path()) {
+    PendingMakerNote value(*pending);
+    value.copyTiffData(pData, size);
+    mn->setValue(&value);
+  }
+
   // fixup ICC profile
   Exiv2::ExifKey key("Exif.Image.InterColorProfile");
   auto pos = exifData_.findKey(key);
@@ -203,10 +263,12 @@ void TiffImage::writeMetadata() {
   // set usePacket to influence TiffEncoder::encodeXmp() called by TiffVisitor.encode()
   xmpData().usePacket(writeXmpFromPacket());
 
-  TiffParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
+  // pData is the mapped file, so the image data can be spliced into it in place
+  encodeTiff(*io_, pData, size, bo, exifData_, iptcData_, xmpData_, pData != nullptr);  // may throw
 }  // TiffImage::writeMetadata
 
-ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
+ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                             MakerNotePolicy mnPolicy) {
   uint32_t root = Tag::root;
 
   // #1402  Fujifilm RAF. Change root when parsing embedded tiff
@@ -215,25 +277,13 @@ ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xm
     root = Tag::fuji;
   }
 
-  return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, root, TiffMapping::findDecoder);
+  return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, root, TiffMapping::findDecoder, nullptr,
+                                  mdExif | mdIptc | mdXmp, mnPolicy);
 }  // TiffParser::decode
 
 WriteMethod TiffParser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
                                const IptcData& iptcData, const XmpData& xmpData) {
-  // Delete IFDs which do not occur in TIFF images
-  static constexpr auto filteredIfds = std::array{
-      IfdId::panaRawId,
-  };
-  for (auto filteredIfd : filteredIfds) {
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
-#endif
-    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), FindExifdatum(filteredIfd)), exifData.end());
-  }
-
-  TiffHeader header(byteOrder);
-  return TiffParserWorker::encode(io, pData, size, exifData, iptcData, xmpData, Tag::root, TiffMapping::findEncoder,
-                                  &header, nullptr);
+  return encodeTiff(io, pData, size, byteOrder, exifData, iptcData, xmpData, false);
 }  // TiffParser::encode
 
 // *************************************************************************
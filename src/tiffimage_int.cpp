@@ -6,25 +6,31 @@
 #include "error.hpp"
 #include "i18n.h"  // NLS support.
 #include "image_int.hpp"
+#include "iptc.hpp"
 #include "makernote_int.hpp"
 #include "sonymn_int.hpp"
+#include "stats_int.hpp"
 #include "tags.hpp"
+#include "tags_int.hpp"
 #include "tiffcomposite_int.hpp"
 #include "tiffvisitor_int.hpp"
 #include "value.hpp"
+#include "xmp_exiv2.hpp"
 
-#ifdef EXIV2_DEBUG_MESSAGES
-#include "tags_int.hpp"
-#endif
-
+#include <algorithm>
 #include <array>
+#include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string>
 
 // Shortcuts for the newTiffBinaryArray templates.
 #define EXV_BINARY_ARRAY(arrayCfg, arrayDef) &newTiffBinaryArray0<arrayCfg, std::size(arrayDef), arrayDef>
 #define EXV_SIMPLE_BINARY_ARRAY(arrayCfg) &newTiffBinaryArray1<arrayCfg>
 #define EXV_COMPLEX_BINARY_ARRAY(arraySet, cfgSelFct) &newTiffBinaryArray2<std::size(arraySet), arraySet, cfgSelFct>
 
+namespace fs = std::filesystem;
+
 namespace Exiv2::Internal {
 bool FindExifdatum::operator()(const Exiv2::Exifdatum& md) const {
   return ifdId_ == md.ifdId();
@@ -2043,7 +2049,9 @@ TiffPath TiffCreator::getPath(uint32_t extendedTag, IfdId group, uint32_t root)
 }
 
 ByteOrder TiffParserWorker::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData,
-                                   size_t size, uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader) {
+                                   size_t size, uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader,
+                                   uint16_t metadataIds, MakerNotePolicy mnPolicy, const std::string& path) {
+  EXV_STATS_PHASE(tiffParse);
   // Create standard TIFF header if necessary
   std::unique_ptr<TiffHeaderBase> ph;
   if (!pHeader) {
@@ -2051,18 +2059,138 @@ ByteOrder TiffParserWorker::decode(ExifData& exifData, IptcData& iptcData, XmpDa
     pHeader = ph.get();
   }
 
-  if (auto rootDir = parse(pData, size, root, pHeader)) {
-    auto decoder = TiffDecoder(exifData, iptcData, xmpData, rootDir.get(), findDecoderFct);
+  if (auto rootDir = parse(pData, size, root, pHeader, mnPolicy)) {
+    auto decoder = TiffDecoder(exifData, iptcData, xmpData, rootDir.get(), findDecoderFct, metadataIds);
     rootDir->accept(decoder);
+
+    // Keep what is needed to decode a skipped makernote on demand with the makernote tag
+    if (mnPolicy == MakerNotePolicy::rawBlob || mnPolicy == MakerNotePolicy::lazy) {
+      TiffFinder finder(0x927c, IfdId::exifId);
+      rootDir->accept(finder);
+      auto mn = dynamic_cast<const TiffMnEntry*>(finder.result());
+      auto pos = exifData.findKey(ExifKey(0x927c, IfdId::exifId));
+      if (mn && mn->pValue() && pos != exifData.end() && mn->pData() >= pData && mn->pData() < pData + size) {
+        auto tiffData = path.empty() ? std::make_shared<const DataBuf>(pData, size) : nullptr;
+        const PendingMakerNote value(mn->pData(), mn->pValue()->size(), mn->pData() - pData, root,
+                                     std::move(tiffData), path, mnPolicy == MakerNotePolicy::lazy);
+        pos->setValue(&value);
+      }
+    }
   }
   return pHeader->byteOrder();
 
 }  // TiffParserWorker::decode
 
+namespace {
+//! Largest amount of image data copied at once when splicing
+constexpr size_t spliceChunkSize = 1024 * 1024;
+
+//! A range of the source and its position in the output
+struct SpliceExtent {
+  size_t out_;   //!< Position in the output
+  size_t src_;   //!< Offset in the source
+  size_t size_;  //!< Size in bytes
+};
+
+/*!
+  @brief Write the result of an intrusive write to the file \em io in place.
+         The result consists of the bytes in \em generated with the ranges
+         \em splices of the source \em pData inserted. \em pData must be the
+         mapped content of \em io.
+
+  Ranges which are already at their final position are not written at all.
+  Ranges which move are copied within the file, like memmove(), in an order
+  which reads each range before it is overwritten. Only ranges which would
+  be overwritten anyway are buffered in memory first.
+ */
+void writeSpliced(FileIo& io, MemIo& generated, const byte* pData, const IoWrapper::Splices& splices,
+                  const OffsetWriter* pOffsetWriter) {
+  EXV_STATS_PHASE(transfer);
+  std::vector<SpliceExtent> extents;
+  size_t shift = 0;
+  size_t maxSize = 0;
+  for (auto&& splice : splices) {
+    extents.push_back({splice.pos_ + shift, splice.offset_, splice.size_});
+    shift += splice.size_;
+    maxSize = std::max(maxSize, splice.size_);
+  }
+  const size_t outSize = generated.size() + shift;
+
+  // Ranges moving towards the end of the file are copied first, last to first
+  std::vector<const SpliceExtent*> backward;
+  std::vector<const SpliceExtent*> forward;
+  std::vector<std::pair<const SpliceExtent*, DataBuf>> buffered;
+  for (auto&& extent : extents) {
+    if (extent.out_ > extent.src_)
+      backward.push_back(&extent);
+  }
+  // Ranges moving towards the start follow, first to last, unless one of the
+  // former overwrites them
+  for (auto&& extent : extents) {
+    if (extent.out_ >= extent.src_)
+      continue;
+    auto pos = std::partition_point(backward.begin(), backward.end(),
+                                    [&](const SpliceExtent* b) { return b->out_ + b->size_ <= extent.src_; });
+    if (pos != backward.end() && (*pos)->out_ < extent.src_ + extent.size_) {
+      buffered.emplace_back(&extent, DataBuf(pData + extent.src_, extent.size_));
+    } else {
+      forward.push_back(&extent);
+    }
+  }
+
+  auto writeAt = [&io](size_t pos, const byte* buf, size_t wcount) {
+    if (wcount == 0)
+      return;
+    if (io.seek(static_cast<int64_t>(pos), BasicIo::beg) != 0 || io.write(buf, wcount) != wcount)
+      throw Error(ErrorCode::kerImageWriteFailed);
+  };
+  DataBuf chunk(std::min(maxSize, spliceChunkSize));
+  auto move = [&](const SpliceExtent& extent, bool lastToFirst) {
+    const size_t distance = lastToFirst ? extent.out_ - extent.src_ : extent.src_ - extent.out_;
+    for (size_t done = 0; done < extent.size_;) {
+      const size_t count = std::min(chunk.size(), extent.size_ - done);
+      const size_t idx = lastToFirst ? extent.size_ - done - count : done;
+      const byte* buf = pData + extent.src_ + idx;
+      // The source of the write must not be changed by the write itself
+      if (distance < count) {
+        std::copy_n(buf, count, chunk.begin());
+        buf = chunk.c_data();
+      }
+      writeAt(extent.out_ + idx, buf, count);
+      done += count;
+    }
+  };
+  std::for_each(backward.rbegin(), backward.rend(), [&](const SpliceExtent* extent) { move(*extent, true); });
+  for (auto&& extent : forward)
+    move(*extent, false);
+  for (auto&& [extent, buf] : buffered)
+    writeAt(extent->out_, buf.c_data(), buf.size());
+
+  // The generated TIFF structure fills the gaps between the ranges
+  const byte* pGenerated = generated.mmap();
+  size_t pos = 0;
+  shift = 0;
+  for (auto&& splice : splices) {
+    writeAt(pos + shift, pGenerated + pos, splice.pos_ - pos);
+    pos = splice.pos_;
+    shift += splice.size_;
+  }
+  writeAt(pos + shift, pGenerated + pos, generated.size() - pos);
+
+  if (pOffsetWriter)
+    pOffsetWriter->writeOffsets(io);
+  if (io.size() > outSize) {
+    io.munmap();
+    fs::resize_file(io.path(), outSize);
+  }
+}
+}  // namespace
+
 WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size, const ExifData& exifData,
                                      const IptcData& iptcData, const XmpData& xmpData, uint32_t root,
                                      FindEncoderFct findEncoderFct, TiffHeaderBase* pHeader,
-                                     OffsetWriter* pOffsetWriter) {
+                                     OffsetWriter* pOffsetWriter, bool spliceInPlace) {
+  EXV_STATS_PHASE(encode);
   /*
      1) parse the binary image, if one is provided, and
      2) attempt updating the parsed tree in-place ("non-intrusive writing")
@@ -2070,17 +2198,38 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
         writing"). If there is a parsed tree, it is only used to access the
         image data in this case.
    */
+  // A makernote which was not decoded is compared with the makernote in the parsed tree as a binary tag and
+  // written unchanged, unless makernote tags were set while it was pending
+  const bool pending = exifData.makerNotePending();
+  std::optional<ExifData> decoded;
+  auto decodePending = [&decoded, &exifData]() {
+    decoded = exifData;
+    decoded->decodeMakerNote();
+  };
+  if (pending &&
+      std::any_of(exifData.begin(), exifData.end(), [](const Exifdatum& md) { return isMakerIfd(md.ifdId()); }))
+    decodePending();
+
   WriteMethod writeMethod = wmIntrusive;
-  auto parsedTree = parse(pData, size, root, pHeader);
+  auto parsedTree =
+      parse(pData, size, root, pHeader, pending && !decoded ? MakerNotePolicy::rawBlob : MakerNotePolicy::full);
   auto primaryGroups = findPrimaryGroups(parsedTree);
   if (parsedTree) {
     // Attempt to update existing TIFF components based on metadata entries
-    TiffEncoder encoder(exifData, iptcData, xmpData, parsedTree.get(), false, primaryGroups, pHeader, findEncoderFct);
+    TiffEncoder encoder(decoded ? *decoded : exifData, iptcData, xmpData, parsedTree.get(), false, primaryGroups,
+                        pHeader, findEncoderFct);
     parsedTree->accept(encoder);
     if (!encoder.dirty())
       writeMethod = wmNonIntrusive;
   }
   if (writeMethod == wmIntrusive) {
+    // The offsets in a makernote change when it moves, so a pending one is written from its decoded tags
+    if (pending && !decoded) {
+      decodePending();
+      parsedTree = parse(pData, size, root, pHeader);
+      primaryGroups = findPrimaryGroups(parsedTree);
+    }
+    const ExifData& ed = decoded ? *decoded : exifData;
     auto createdTree = TiffCreator::create(root, IfdId::ifdIdNotSet);
     if (parsedTree) {
       // Copy image tags from the original image to the composite
@@ -2088,18 +2237,31 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
       parsedTree->accept(copier);
     }
     // Add entries from metadata to composite
-    TiffEncoder encoder(exifData, iptcData, xmpData, createdTree.get(), !parsedTree, std::move(primaryGroups), pHeader,
+    TiffEncoder encoder(ed, iptcData, xmpData, createdTree.get(), !parsedTree, std::move(primaryGroups), pHeader,
                         findEncoderFct);
     encoder.add(createdTree.get(), std::move(parsedTree), root);
     // Write binary representation from the composite tree
     DataBuf header = pHeader->write();
     auto tempIo = MemIo();
     IoWrapper ioWrapper(tempIo, header.c_data(), header.size(), pOffsetWriter);
+    // The image data of a file is spliced into it in place, if the caller
+    // asks for it, else the new TIFF structure contains the image data
+    IoWrapper::Splices splices;
+    auto fileIo = spliceInPlace ? dynamic_cast<FileIo*>(&io) : nullptr;
+    if (fileIo)
+      ioWrapper.setSource(pData, size, &splices);
+    else
+      tempIo.reserve(size);
     auto imageIdx(std::string::npos);
+    TiffLayout layout(*createdTree);
     createdTree->write(ioWrapper, pHeader->byteOrder(), header.size(), std::string::npos, std::string::npos, imageIdx);
-    if (pOffsetWriter)
-      pOffsetWriter->writeOffsets(tempIo);
-    io.transfer(tempIo);  // may throw
+    if (!splices.empty()) {
+      writeSpliced(*fileIo, tempIo, pData, splices, pOffsetWriter);  // may throw
+    } else {
+      if (pOffsetWriter)
+        pOffsetWriter->writeOffsets(tempIo);
+      io.transfer(tempIo);  // may throw
+    }
 #ifndef SUPPRESS_WARNINGS
     EXV_INFO << "Write strategy: Intrusive\n";
 #endif
@@ -2113,7 +2275,7 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
 }  // TiffParserWorker::encode
 
 TiffComponent::UniquePtr TiffParserWorker::parse(const byte* pData, size_t size, uint32_t root,
-                                                 TiffHeaderBase* pHeader) {
+                                                 TiffHeaderBase* pHeader, MakerNotePolicy mnPolicy) {
   TiffComponent::UniquePtr rootDir;
   if (!pData || size == 0)
     return rootDir;
@@ -2124,7 +2286,7 @@ TiffComponent::UniquePtr TiffParserWorker::parse(const byte* pData, size_t size,
   if (rootDir) {
     rootDir->setStart(pData + pHeader->offset());
     auto state = TiffRwState{pHeader->byteOrder(), 0};
-    auto reader = TiffReader{pData, size, rootDir.get(), state};
+    auto reader = TiffReader{pData, size, rootDir.get(), state, mnPolicy};
     rootDir->accept(reader);
     reader.postProcess();
   }
@@ -2325,7 +2487,7 @@ bool isTiffImageTag(uint16_t tag, IfdId group) {
   const bool result = isTiffImageTagLookup(tag, group);
 #ifdef EXIV2_DEBUG_MESSAGES
   if (result) {
-    ExifKey key(tag, groupName(group));
+    ExifKey key(tag, group);
     std::cerr << "Image tag: " << key << " (3)\n";
   } else {
     std::cerr << "Not an image tag: " << tag << " (4)\n";
@@ -2346,7 +2508,7 @@ bool TiffHeader::isImageTag(uint16_t tag, IfdId group, const PrimaryGroups& pPri
     return false;
   }
 #ifdef EXIV2_DEBUG_MESSAGES
-  ExifKey key(tag, groupName(group));
+  ExifKey key(tag, group);
 #endif
   // If there are primary groups and none matches group, we're done
   if (!pPrimaryGroups.empty() &&
@@ -2360,7 +2522,7 @@ bool TiffHeader::isImageTag(uint16_t tag, IfdId group, const PrimaryGroups& pPri
   // image tags. That should take care of NEFs until we know better.
   if (!pPrimaryGroups.empty() && group != IfdId::ifd0Id) {
 #ifdef EXIV2_DEBUG_MESSAGES
-    ExifKey key(tag, groupName(group));
+    ExifKey key(tag, group);
     std::cerr << "Image tag: " << key << " (2)\n";
 #endif
     return true;
@@ -2388,4 +2550,51 @@ void OffsetWriter::writeOffsets(BasicIo& io) const {
   }
 }
 
+PendingMakerNote::PendingMakerNote(const byte* pData, size_t size, size_t offset, uint32_t root,
+                                   std::shared_ptr<const DataBuf> tiffData, std::string path, bool onAccess) :
+    DataValue(pData, size),
+    offset_(offset),
+    root_(root),
+    tiffData_(std::move(tiffData)),
+    path_(std::move(path)),
+    onAccess_(onAccess) {
+}
+
+void PendingMakerNote::copyTiffData(const byte* pData, size_t size) {
+  tiffData_ = std::make_shared<const DataBuf>(pData, size);
+  path_.clear();
+}
+
+PendingMakerNote* PendingMakerNote::clone_() const {
+  return new PendingMakerNote(*this);
+}
+
+ExifData PendingMakerNote::decode() const {
+  ExifData exifData;
+  FileIo file(path_);
+  IoCloser closer(file);
+  const byte* pData = nullptr;
+  size_t size = 0;
+  if (tiffData_) {
+    pData = tiffData_->c_data();
+    size = tiffData_->size();
+  } else if (file.open() == 0) {
+    pData = file.mmap();
+    size = file.size();
+  }
+  // The file may have changed since the makernote was read from it
+  DataBuf mn(this->size());
+  copy(mn.data(), invalidByteOrder);
+  if (!pData || offset_ > size || size - offset_ < mn.size() || mn.cmpBytes(0, pData + offset_, mn.size()) != 0) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_WARNING << path_ << ": The makernote cannot be decoded, the file has changed since it was read\n";
+#endif
+    return exifData;
+  }
+  IptcData iptcData;
+  XmpData xmpData;
+  TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, root_, TiffMapping::findDecoder, nullptr, mdExif);
+  return exifData;
+}
+
 }  // namespace Exiv2::Internal
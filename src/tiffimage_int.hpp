@@ -5,14 +5,17 @@
 
 // *****************************************************************************
 // included header files
+#include "exif.hpp"
 #include "tifffwd_int.hpp"
 #include "types.hpp"
+#include "value.hpp"
 
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
@@ -21,7 +24,6 @@
 // namespace extensions
 namespace Exiv2 {
 class BasicIo;
-class ExifData;
 class IptcData;
 class XmpData;
 
@@ -215,12 +217,24 @@ class TiffParserWorker {
     @param findDecoderFct Function to access special decoding info.
     @param pHeader   Optional pointer to a TIFF header. If not provided,
                      a standard TIFF header is used.
+    @param metadataIds Bitmask of the MetadataId values to decode. IPTC
+                     and XMP found in the TIFF structure are skipped if
+                     they are not selected.
+    @param mnPolicy  How to handle the makernote. For MakerNotePolicy::rawBlob
+                     and MakerNotePolicy::lazy, the Exif.Photo.MakerNote tag
+                     in \em exifData gets a PendingMakerNote value, which
+                     keeps what is needed to decode the makernote later.
+    @param path      The file whose content is \em pData, if any. A
+                     PendingMakerNote reads it again when it is decoded,
+                     else it keeps a copy of the TIFF data.
 
     @return Byte order in which the data is encoded, invalidByteOrder if
             decoding failed.
   */
   static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
-                          uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader = nullptr);
+                          uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader = nullptr,
+                          uint16_t metadataIds = mdExif | mdIptc | mdXmp,
+                          MakerNotePolicy mnPolicy = MakerNotePolicy::full, const std::string& path = {});
   /*!
     @brief Encode TIFF metadata from the metadata containers into a
            memory block \em blob.
@@ -230,10 +244,19 @@ class TiffParserWorker {
     3) else, create a new tree and write a new TIFF structure ("intrusive
        writing"). If there is a parsed tree, it is only used to access the
        image data in this case.
+
+    A makernote that is still pending in \em exifData is decoded into a
+    copy of \em exifData first.
+
+    If \em spliceInPlace is true and \em io is a FileIo, \em pData must
+    be its mapped content, as for non-intrusive writing: an intrusive write
+    then splices the image data into the file in place instead of copying
+    it through memory. Only the images which write their own file set it.
    */
   static WriteMethod encode(BasicIo& io, const byte* pData, size_t size, const ExifData& exifData,
                             const IptcData& iptcData, const XmpData& xmpData, uint32_t root,
-                            FindEncoderFct findEncoderFct, TiffHeaderBase* pHeader, OffsetWriter* pOffsetWriter);
+                            FindEncoderFct findEncoderFct, TiffHeaderBase* pHeader, OffsetWriter* pOffsetWriter,
+                            bool spliceInPlace = false);
 
  private:
   /*!
@@ -245,11 +268,15 @@ class TiffParserWorker {
     @param size      Length of the data buffer.
     @param root      Root tag of the TIFF tree.
     @param pHeader   Pointer to a TIFF header.
+    @param mnPolicy  Makernote policy. The makernote is only parsed for
+                     MakerNotePolicy::full and not read at all for
+                     MakerNotePolicy::none.
     @return          An auto pointer with the root element of the TIFF
                      composite structure. If \em pData is 0 or \em size
                      is 0, the return value is a 0 pointer.
    */
-  static std::unique_ptr<TiffComponent> parse(const byte* pData, size_t size, uint32_t root, TiffHeaderBase* pHeader);
+  static std::unique_ptr<TiffComponent> parse(const byte* pData, size_t size, uint32_t root, TiffHeaderBase* pHeader,
+                                              MakerNotePolicy mnPolicy = MakerNotePolicy::full);
   /*!
     @brief Find primary groups in the source tree provided and populate
            the list of primary groups.
@@ -350,6 +377,76 @@ class OffsetWriter {
 
 };  // class OffsetWriter
 
+/*!
+  @brief Value of an Exif.Photo.MakerNote tag which was not decoded with the
+         rest of the Exif data, see MakerNotePolicy. Besides the makernote,
+         it keeps a reference to the TIFF data it was read from, as makernote
+         entries may refer to any part of it.
+ */
+class PendingMakerNote : public DataValue {
+ public:
+  //! @name Creators
+  //@{
+  /*!
+    @brief Constructor.
+
+    @param pData     Pointer to the makernote.
+    @param size      Size of the makernote.
+    @param offset    Offset of the makernote in the TIFF data.
+    @param root      Root tag of the TIFF data.
+    @param tiffData  The TIFF data, or nullptr if it is the content of the
+                     file \em path.
+    @param path      The file with the TIFF data, if \em tiffData is nullptr.
+                     The file is read again to decode the makernote.
+    @param onAccess  True to decode the makernote on the first lookup of a
+                     makernote key.
+   */
+  PendingMakerNote(const byte* pData, size_t size, size_t offset, uint32_t root,
+                   std::shared_ptr<const DataBuf> tiffData, std::string path, bool onAccess);
+  //@}
+
+  //! @name Manipulators
+  //@{
+  /*!
+    @brief Keep a copy of the TIFF data \em pData, \em size instead of
+           reading the file again. Must be called with the content of the
+           file before it is modified.
+   */
+  void copyTiffData(const byte* pData, size_t size);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return true if the makernote is decoded on the first lookup of a makernote key
+  [[nodiscard]] bool onAccess() const {
+    return onAccess_;
+  }
+  //! Return the file which the TIFF data is read from, empty if a copy of the TIFF data is kept
+  [[nodiscard]] const std::string& path() const {
+    return path_;
+  }
+  /*!
+    @brief Decode the makernote from the TIFF data it was read from. The
+           result contains all tags of the TIFF data, including those of the
+           makernote. It is empty if the TIFF data is no longer available or
+           the makernote in it differs from this value.
+   */
+  [[nodiscard]] ExifData decode() const;
+  //@}
+
+ private:
+  //! Internal virtual copy constructor.
+  [[nodiscard]] PendingMakerNote* clone_() const override;
+
+  // DATA
+  size_t offset_;                            //!< Offset of the makernote in the TIFF data
+  uint32_t root_;                            //!< Root tag of the TIFF data
+  std::shared_ptr<const DataBuf> tiffData_;  //!< The TIFF data, shared by all copies
+  std::string path_;                         //!< The file with the TIFF data, if it is not kept
+  bool onAccess_;                            //!< Decode on the first lookup of a makernote key
+
+};  // class PendingMakerNote
+
 // Todo: Move this class to metadatum_int.hpp or tags_int.hpp
 //! Unary predicate that matches an Exifdatum with a given IfdId.
 class FindExifdatum {
@@ -144,7 +144,7 @@ void TiffCopier::copyObject(const TiffComponent* object) {
     auto tiffPath = TiffCreator::getPath(object->tag(), object->group(), root_);
     pRoot_->addPath(object->tag(), tiffPath, pRoot_, std::move(clone));
 #ifdef EXIV2_DEBUG_MESSAGES
-    ExifKey key(object->tag(), groupName(object->group()));
+    ExifKey key(object->tag(), object->group());
     std::cerr << "Copied " << key << "\n";
 #endif
   }
@@ -191,8 +191,13 @@ void TiffCopier::visitBinaryElement(TiffBinaryElement* object) {
 }
 
 TiffDecoder::TiffDecoder(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, TiffComponent* pRoot,
-                         FindDecoderFct findDecoderFct) :
-    exifData_(exifData), iptcData_(iptcData), xmpData_(xmpData), pRoot_(pRoot), findDecoderFct_(findDecoderFct) {
+                         FindDecoderFct findDecoderFct, uint16_t metadataIds) :
+    exifData_(exifData),
+    iptcData_(iptcData),
+    xmpData_(xmpData),
+    pRoot_(pRoot),
+    findDecoderFct_(findDecoderFct),
+    metadataIds_(metadataIds) {
   // #1402 Fujifilm RAF. Search for the make
   // Find camera make in existing metadata (read from the JPEG)
   ExifKey key("Exif.Image.Make");
@@ -270,6 +275,8 @@ void TiffDecoder::getObjData(const byte*& pData, size_t& size, uint16_t tag, Ifd
 void TiffDecoder::decodeXmp(const TiffEntryBase* object) {
   // add Exif tag anyway
   decodeStdTiffEntry(object);
+  if (!(metadataIds_ & mdXmp))
+    return;
 
   const byte* pData = nullptr;
   size_t size = 0;
@@ -298,7 +305,7 @@ void TiffDecoder::decodeIptc(const TiffEntryBase* object) {
 
   // All tags are read at this point, so the first time we come here,
   // find the relevant IPTC tag and decode IPTC if found
-  if (decodedIptc_) {
+  if (decodedIptc_ || !(metadataIds_ & mdIptc)) {
     return;
   }
   decodedIptc_ = true;
@@ -422,7 +429,7 @@ void TiffDecoder::decodeTiffEntry(const TiffEntryBase* object) {
 }  // TiffDecoder::decodeTiffEntry
 
 void TiffDecoder::decodeStdTiffEntry(const TiffEntryBase* object) {
-  ExifKey key(object->tag(), groupName(object->group()));
+  ExifKey key(object->tag(), object->group());
   key.setIdx(object->idx());
   exifData_.add(key, object->pValue());
 
@@ -614,7 +621,7 @@ void TiffEncoder::visitMnEntry(TiffMnEntry* object) {
     encodeTiffComponent(object);
   } else if (del_) {
     // The makernote is made up of decoded tags, delete binary tag
-    ExifKey key(object->tag(), groupName(object->group()));
+    ExifKey key(object->tag(), object->group());
     auto pos = exifData_.findKey(key);
     if (pos != exifData_.end())
       exifData_.erase(pos);
@@ -706,7 +713,7 @@ void TiffEncoder::encodeTiffComponent(TiffEntryBase* object, const Exifdatum* da
   const Exifdatum* ed = datum;
   if (!ed) {
     // Non-intrusive writing: find matching tag
-    ExifKey key(object->tag(), groupName(object->group()));
+    ExifKey key(object->tag(), object->group());
     pos = exifData_.findKey(key);
     if (pos != exifData_.end()) {
       ed = &(*pos);
@@ -763,14 +770,14 @@ void TiffEncoder::encodeDataEntry(TiffDataEntry* object, const Exifdatum* datum)
   if (!dirty_ && writeMethod() == wmNonIntrusive) {
     if (object->sizeDataArea_ < object->pValue()->sizeDataArea()) {
 #ifdef EXIV2_DEBUG_MESSAGES
-      ExifKey key(object->tag(), groupName(object->group()));
+      ExifKey key(object->tag(), object->group());
       std::cerr << "DATAAREA GREW     " << key << "\n";
 #endif
       setDirty();
     } else {
       // Write the new dataarea, fill with 0x0
 #ifdef EXIV2_DEBUG_MESSAGES
-      ExifKey key(object->tag(), groupName(object->group()));
+      ExifKey key(object->tag(), object->group());
       std::cerr << "Writing data area for " << key << "\n";
 #endif
       DataBuf buf = object->pValue()->dataArea();
@@ -806,7 +813,7 @@ void TiffEncoder::encodeImageEntry(TiffImageEntry* object, const Exifdatum* datu
     std::cerr << "\t DATAAREA IS SET (INTRUSIVE WRITING)";
 #endif
     // Set pseudo strips (without a data pointer) from the size tag
-    ExifKey key(object->szTag(), groupName(object->szGroup()));
+    ExifKey key(object->szTag(), object->szGroup());
     auto pos = exifData_.findKey(key);
     const byte* zero = nullptr;
     if (pos == exifData_.end()) {
@@ -825,7 +832,7 @@ void TiffEncoder::encodeImageEntry(TiffImageEntry* object, const Exifdatum* datu
       }
       if (sizeTotal != sizeDataArea) {
 #ifndef SUPPRESS_WARNINGS
-        ExifKey key2(object->tag(), groupName(object->group()));
+        ExifKey key2(object->tag(), object->group());
         EXV_ERROR << "Sum of all sizes of " << key << " != data size of " << key2 << ". "
                   << "This results in an invalid image.\n";
 #endif
@@ -848,7 +855,7 @@ void TiffEncoder::encodeImageEntry(TiffImageEntry* object, const Exifdatum* datu
     }
 #ifndef SUPPRESS_WARNINGS
     else {
-      ExifKey key2(object->tag(), groupName(object->group()));
+      ExifKey key2(object->tag(), object->group());
       EXV_WARNING << "No image data to encode " << key2 << ".\n";
     }
 #endif
@@ -882,7 +889,7 @@ void TiffEncoder::encodeTiffEntryBase(TiffEntryBase* object, const Exifdatum* da
   }
   object->updateValue(datum->getValue(), byteOrder());  // clones the value
 #ifdef EXIV2_DEBUG_MESSAGES
-  ExifKey key(object->tag(), groupName(object->group()));
+  ExifKey key(object->tag(), object->group());
   std::cerr << "UPDATING DATA     " << key;
   if (tooLarge) {
     std::cerr << "\t\t\t ALLOCATED " << std::dec << object->size_ << " BYTES";
@@ -896,14 +903,14 @@ void TiffEncoder::encodeOffsetEntry(TiffEntryBase* object, const Exifdatum* datu
     setDirty();
     object->updateValue(datum->getValue(), byteOrder());  // clones the value
 #ifdef EXIV2_DEBUG_MESSAGES
-    ExifKey key(object->tag(), groupName(object->group()));
+    ExifKey key(object->tag(), object->group());
     std::cerr << "UPDATING DATA     " << key;
     std::cerr << "\t\t\t ALLOCATED " << object->size() << " BYTES";
 #endif
   } else {
     object->setValue(datum->getValue());  // clones the value
 #ifdef EXIV2_DEBUG_MESSAGES
-    ExifKey key(object->tag(), groupName(object->group()));
+    ExifKey key(object->tag(), object->group());
     std::cerr << "NOT UPDATING      " << key;
     std::cerr << "\t\t\t PRESERVE VALUE DATA";
 #endif
@@ -972,8 +979,15 @@ void TiffEncoder::add(TiffComponent* pRootDir, TiffComponent::UniquePtr pSourceD
 
 }  // TiffEncoder::add
 
-TiffReader::TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state) :
-    pData_(pData), size_(size), pLast_(pData + size), pRoot_(pRoot), origState_(state), mnState_(state) {
+TiffReader::TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state,
+                       MakerNotePolicy mnPolicy) :
+    pData_(pData),
+    size_(size),
+    pLast_(pData + size),
+    pRoot_(pRoot),
+    origState_(state),
+    mnState_(state),
+    mnPolicy_(mnPolicy) {
   pState_ = &origState_;
 
 }  // TiffReader::TiffReader
@@ -1175,7 +1189,12 @@ void TiffReader::visitSubIfd(TiffSubIfd* object) {
 }  // TiffReader::visitSubIfd
 
 void TiffReader::visitMnEntry(TiffMnEntry* object) {
+  if (mnPolicy_ == MakerNotePolicy::none)
+    return;
   readTiffEntry(object);
+  // Keep the makernote as a binary tag, it is decoded later if at all
+  if (mnPolicy_ != MakerNotePolicy::full)
+    return;
   // Find camera make
   TiffFinder finder(0x010f, IfdId::ifd0Id);
   pRoot_->accept(finder);
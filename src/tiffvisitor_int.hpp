@@ -255,11 +255,13 @@ class TiffDecoder : public TiffVisitor {
   //@{
   /*!
     @brief Constructor, taking metadata containers to add the metadata to,
-           the root element of the composite to decode and a FindDecoderFct
-           function to get the decoder function for each tag.
+           the root element of the composite to decode, a FindDecoderFct
+           function to get the decoder function for each tag and a bitmask
+           of the MetadataId values to decode. IPTC and XMP embedded in the
+           TIFF structure are only parsed if they are selected.
    */
   TiffDecoder(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, TiffComponent* pRoot,
-              FindDecoderFct findDecoderFct);
+              FindDecoderFct findDecoderFct, uint16_t metadataIds = mdExif | mdIptc | mdXmp);
   //@}
 
   //! @name Manipulators
@@ -317,6 +319,7 @@ class TiffDecoder : public TiffVisitor {
   XmpData& xmpData_;               //!< XMP metadata container
   TiffComponent* pRoot_;           //!< Root element of the composite
   FindDecoderFct findDecoderFct_;  //!< Ptr to the function to find special decoding functions
+  uint16_t metadataIds_;           //!< Bitmask of the MetadataId values to decode
   std::string make_;               //!< Camera make, determined from the tags to decode
   bool decodedIptc_{false};        //!< Indicates if IPTC has been decoded yet
 
@@ -586,8 +589,12 @@ class TiffReader : public TiffVisitor {
     @param pRoot     Root element of the TIFF composite.
     @param state     State object for creation function, byte order and
                      base offset.
+    @param mnPolicy  Makernote policy. The makernote entry is only parsed
+                     into its components for MakerNotePolicy::full and is
+                     not read at all for MakerNotePolicy::none.
    */
-  TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state);
+  TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state,
+             MakerNotePolicy mnPolicy = MakerNotePolicy::full);
   //@}
 
   //! @name Manipulators
@@ -659,17 +666,18 @@ class TiffReader : public TiffVisitor {
   using PostList = std::vector<TiffComponent*>;
 
   // DATA
-  const byte* pData_;      //!< Pointer to the memory buffer
-  size_t size_;            //!< Size of the buffer
-  const byte* pLast_;      //!< Pointer to the last byte
-  TiffComponent* pRoot_;   //!< Root element of the composite
-  TiffRwState* pState_;    //!< Pointer to the state in effect (origState_ or mnState_)
-  TiffRwState origState_;  //!< State class as set in the c'tor
-  TiffRwState mnState_;    //!< State class as set in the c'tor or by setMnState()
-  DirList dirList_;        //!< List of IFD pointers and their groups
-  IdxSeq idxSeq_;          //!< Sequences for group, used for the entry's idx
-  PostList postList_;      //!< List of components with deferred reading
-  bool postProc_{false};   //!< True in postProcessList()
+  const byte* pData_;         //!< Pointer to the memory buffer
+  size_t size_;               //!< Size of the buffer
+  const byte* pLast_;         //!< Pointer to the last byte
+  TiffComponent* pRoot_;      //!< Root element of the composite
+  TiffRwState* pState_;       //!< Pointer to the state in effect (origState_ or mnState_)
+  TiffRwState origState_;     //!< State class as set in the c'tor
+  TiffRwState mnState_;       //!< State class as set in the c'tor or by setMnState()
+  DirList dirList_;           //!< List of IFD pointers and their groups
+  IdxSeq idxSeq_;             //!< Sequences for group, used for the entry's idx
+  PostList postList_;         //!< List of components with deferred reading
+  bool postProc_{false};      //!< True in postProcessList()
+  MakerNotePolicy mnPolicy_;  //!< How to read the makernote
 };
 
 }  // namespace Internal
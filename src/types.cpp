@@ -7,6 +7,7 @@
 #include "utils.hpp"
 
 // + standard includes
+#include <algorithm>
 #include <bit>
 #include <cctype>
 #include <cmath>
@@ -66,6 +67,21 @@ constexpr struct TypeInfoTable {
     {Exiv2::langAlt, "LangAlt", 1},
 };
 
+//! Copy \em count values of type T from \em src to \em dst, reversing the order of the bytes of each
+template <typename T>
+void swapBytes(Exiv2::byte* dst, const Exiv2::byte* src, size_t count) {
+  // A plain loop over whole values, which compilers turn into vector byte shuffles
+  for (size_t i = 0; i < count; ++i) {
+    T v;
+    std::memcpy(&v, src + (i * sizeof(T)), sizeof(T));
+    T r = 0;
+    for (size_t b = 0; b < sizeof(T); ++b) {
+      r = static_cast<T>((r << 8) | (v & 0xff));
+      v = static_cast<T>(v >> 8);
+    }
+    std::memcpy(dst + (i * sizeof(T)), &r, sizeof(T));
+  }
+}
 }  // namespace
 
 // *****************************************************************************
@@ -472,6 +488,30 @@ size_t d2Data(byte* buf, double d, ByteOrder byteOrder) {
   return 8;
 }
 
+void convertByteOrder(byte* dst, const byte* src, size_t count, size_t size, ByteOrder byteOrder) {
+  if (count == 0)
+    return;
+  if ((byteOrder == littleEndian) == (std::endian::native == std::endian::little)) {
+    std::memmove(dst, src, count * size);
+    return;
+  }
+  switch (size) {
+    case 2:
+      swapBytes<uint16_t>(dst, src, count);
+      break;
+    case 4:
+      swapBytes<uint32_t>(dst, src, count);
+      break;
+    case 8:
+      swapBytes<uint64_t>(dst, src, count);
+      break;
+    default:
+      for (size_t i = 0; i < count * size; i += size)
+        std::reverse_copy(src + i, src + i + size, dst + i);
+      break;
+  }
+}
+
 void hexdump(std::ostream& os, const byte* buf, size_t len, size_t offset) {
   const size_t hexbase = 16;
   const std::string::size_type pos = 8 + (hexbase * 3) + 2;
@@ -1,7 +1,72 @@
 #include "utils.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <locale>
 #include <string>
+#include <vector>
+
+namespace {
+//! Values of the lowercase hex digits, 0xff for all other characters
+constexpr auto hexValues = [] {
+  std::array<uint8_t, 256> values{};
+  values.fill(0xff);
+  for (uint8_t i = 0; i < 10; ++i)
+    values['0' + i] = i;
+  for (uint8_t i = 0; i < 6; ++i)
+    values['a' + i] = 10 + i;
+  return values;
+}();
+
+//! Number of bytes decoded per block by hexDecode, without a branch per byte
+constexpr size_t hexBlockSize = 16;
+
+//! Per-thread cache of the streams of Exiv2::Internal::ScopedStringStream
+class StringStreamCache {
+ public:
+  StringStreamCache() = default;
+  ~StringStreamCache() {
+    destroyed_ = true;
+  }
+  StringStreamCache(const StringStreamCache&) = delete;
+  StringStreamCache& operator=(const StringStreamCache&) = delete;
+
+  //! Return a cached stream in the state of a new one, or a new stream
+  static std::unique_ptr<std::ostringstream> acquire() {
+    if (destroyed_ || instance().streams_.empty())
+      return std::make_unique<std::ostringstream>();
+    auto os = std::move(instance().streams_.back());
+    instance().streams_.pop_back();
+    os->str(std::string());
+    os->clear();
+    os->flags(std::ios_base::skipws | std::ios_base::dec);
+    os->precision(6);
+    os->width(0);
+    os->fill(' ');
+    if (os->getloc() != std::locale())
+      os->imbue(std::locale());
+    return os;
+  }
+
+  //! Keep \em os for reuse, unless the cache is full
+  static void release(std::unique_ptr<std::ostringstream> os) {
+    if (destroyed_ || instance().streams_.size() == maxStreams_)
+      return;
+    instance().streams_.push_back(std::move(os));
+  }
+
+ private:
+  static StringStreamCache& instance() {
+    thread_local StringStreamCache cache;
+    return cache;
+  }
+
+  static constexpr size_t maxStreams_ = 4;  //!< Enough for nested formatting
+  static inline thread_local bool destroyed_ = false;
+  std::vector<std::unique_ptr<std::ostringstream>> streams_;
+};
+}  // namespace
 
 namespace Exiv2::Internal {
 
@@ -21,4 +86,67 @@ std::string lower(std::string_view a) {
   return b;
 }
 
+void hexEncode(std::string& out, const uint8_t* data, size_t size, size_t lineLength, bool upperCase) {
+  const char* digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+  const size_t lines = lineLength ? (size + lineLength - 1) / lineLength : 0;
+  const size_t pos = out.size();
+  out.resize(pos + (2 * size) + lines);
+
+  char* dst = out.data() + pos;
+  for (size_t i = 0; i < size;) {
+    if (lineLength)
+      *dst++ = '\n';
+    const size_t count = lineLength ? std::min(lineLength, size - i) : size - i;
+    for (size_t j = 0; j < count; ++j) {
+      dst[2 * j] = digits[data[i + j] >> 4];
+      dst[(2 * j) + 1] = digits[data[i + j] & 0x0f];
+    }
+    dst += 2 * count;
+    i += count;
+  }
+}
+
+const char* hexDecode(uint8_t* buf, size_t size, const char* text, const char* end) {
+  auto value = [](char c) { return hexValues[static_cast<unsigned char>(c)]; };
+
+  size_t n = 0;
+  while (n < size) {
+    // Runs of hex digits, e.g., the lines of a raw profile, are decoded a block at a time
+    while (size - n >= hexBlockSize && static_cast<size_t>(end - text) >= 2 * hexBlockSize) {
+      uint8_t invalid = 0;
+      for (size_t i = 0; i < hexBlockSize; ++i) {
+        const uint8_t hi = value(text[2 * i]);
+        const uint8_t lo = value(text[(2 * i) + 1]);
+        invalid |= hi | lo;
+        buf[n + i] = static_cast<uint8_t>((hi << 4) | (lo & 0x0f));
+      }
+      if (invalid > 0x0f)
+        break;
+      n += hexBlockSize;
+      text += 2 * hexBlockSize;
+    }
+    if (n == size)
+      break;
+
+    // Decode one byte, skipping other characters before each digit
+    uint8_t nibbles[2];
+    for (auto& nibble : nibbles) {
+      while (text < end && value(*text) > 0x0f && *text != '\0')
+        ++text;
+      if (text == end || *text == '\0')
+        return nullptr;
+      nibble = value(*text++);
+    }
+    buf[n++] = static_cast<uint8_t>((nibbles[0] << 4) | nibbles[1]);
+  }
+  return text;
+}
+
+ScopedStringStream::ScopedStringStream() : os_(StringStreamCache::acquire()) {
+}
+
+ScopedStringStream::~ScopedStringStream() {
+  StringStreamCache::release(std::move(os_));
+}
+
 }  // namespace Exiv2::Internal
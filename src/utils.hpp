@@ -1,6 +1,9 @@
 #ifndef EXIV2_UTILS_HPP
 #define EXIV2_UTILS_HPP
 
+#include <cstdint>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <string_view>
 
@@ -20,6 +23,50 @@ std::string upper(std::string_view str);
 /// @brief Returns the lowercase version of \b str
 std::string lower(std::string_view a);
 
+/*!
+  @brief Append the hex encoding of \b size bytes at \b data to \b out.
+         With a non-zero \b lineLength, a line break is inserted before
+         each group of \b lineLength bytes.
+ */
+void hexEncode(std::string& out, const uint8_t* data, size_t size, size_t lineLength = 0, bool upperCase = false);
+
+/*!
+  @brief Decode \b size bytes from the lowercase hex digits in the text
+         from \b text to \b end into \b buf. Other characters, e.g.,
+         line breaks, are skipped; a NUL character ends the text.
+  @return Pointer past the last hex digit decoded, or nullptr if the text
+          ends before \b size bytes are decoded.
+ */
+const char* hexDecode(uint8_t* buf, size_t size, const char* text, const char* end);
+
+/*!
+  @brief An output string stream borrowed from a per-thread cache for the
+         lifetime of the object. Formatting a value into a new
+         std::ostringstream copies the global locale and allocates each
+         time; borrowing avoids that. The stream is reset to the state of a
+         newly constructed stream first, so the output is the same. Nested
+         instances borrow different streams.
+ */
+class ScopedStringStream {
+ public:
+  ScopedStringStream();
+  ~ScopedStringStream();
+  ScopedStringStream(const ScopedStringStream&) = delete;
+  ScopedStringStream& operator=(const ScopedStringStream&) = delete;
+
+  //! Return the stream
+  std::ostringstream& stream() {
+    return *os_;
+  }
+  //! Return the text written to the stream
+  [[nodiscard]] std::string str() const {
+    return os_->str();
+  }
+
+ private:
+  std::unique_ptr<std::ostringstream> os_;
+};
+
 }  // namespace Exiv2::Internal
 
 #endif  // EXIV2_UTILS_HPP
@@ -8,6 +8,7 @@
 #include "error.hpp"
 #include "image_int.hpp"
 #include "types.hpp"
+#include "utils.hpp"
 
 // + standard includes
 #include <iterator>
@@ -72,9 +73,9 @@ int Value::setDataArea(const byte* /*buf*/, size_t /*len*/) {
 }
 
 std::string Value::toString() const {
-  std::ostringstream os;
-  write(os);
-  ok_ = !os.fail();
+  Internal::ScopedStringStream os;
+  write(os.stream());
+  ok_ = !os.stream().fail();
   return os.str();
 }
 
@@ -446,8 +447,8 @@ XmpValue::XmpStruct XmpValue::xmpStruct() const {
 }
 
 size_t XmpValue::copy(byte* buf, ByteOrder /*byteOrder*/) const {
-  std::ostringstream os;
-  write(os);
+  Internal::ScopedStringStream os;
+  write(os.stream());
   std::string s = os.str();
   if (!s.empty())
     std::copy(s.begin(), s.end(), buf);
@@ -460,8 +461,8 @@ int XmpValue::read(const byte* buf, size_t len, ByteOrder /*byteOrder*/) {
 }
 
 size_t XmpValue::size() const {
-  std::ostringstream os;
-  write(os);
+  Internal::ScopedStringStream os;
+  write(os.stream());
   return os.str().size();
 }
 
@@ -510,8 +511,8 @@ XmpTextValue::UniquePtr XmpTextValue::clone() const {
 }
 
 size_t XmpTextValue::size() const {
-  std::ostringstream os;
-  write(os);
+  Internal::ScopedStringStream os;
+  write(os.stream());
   return os.str().size();
 }
 
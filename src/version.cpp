@@ -311,6 +311,7 @@ void Exiv2::dumpLibraryInfo(std::ostream& os, const std::vector<std::regex>& key
   int enable_webready = 0;
   int enable_nls = 0;
   int enable_video = 0;
+  int enable_stats = 0;
   int use_curl = 0;
 
 #if __has_include(<inttypes.h>)
@@ -409,6 +410,10 @@ void Exiv2::dumpLibraryInfo(std::ostream& os, const std::vector<std::regex>& key
   enable_video = 1;
 #endif
 
+#ifdef EXV_ENABLE_STATS
+  enable_stats = 1;
+#endif
+
 #ifdef EXV_USE_CURL
   use_curl = 1;
 #endif
@@ -476,6 +481,7 @@ void Exiv2::dumpLibraryInfo(std::ostream& os, const std::vector<std::regex>& key
   output(os, keys, "enable_webready", enable_webready);
   output(os, keys, "enable_nls", enable_nls);
   output(os, keys, "enable_video", enable_video);
+  output(os, keys, "enable_stats", enable_stats);
   output(os, keys, "use_curl", use_curl);
 
   output(os, keys, "config_path", Exiv2::Internal::getExiv2ConfigPath());
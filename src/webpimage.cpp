@@ -15,6 +15,7 @@
 #include "futils.hpp"
 #include "image_int.hpp"
 #include "safe_op.hpp"
+#include "stats_int.hpp"
 #include "types.hpp"
 
 #include <array>
@@ -100,6 +101,7 @@ void WebPImage::writeMetadata() {
   }
   IoCloser closer(*io_);
   MemIo tempIo;
+  tempIo.reserve(io_->size());
 
   doWriteMetadata(tempIo);  // may throw
   io_->close();
@@ -473,6 +475,7 @@ void WebPImage::printStructure(std::ostream& out, PrintStructureOption option, s
 /* =========================================== */
 
 void WebPImage::readMetadata() {
+  EXV_STATS_PHASE(segmentScan);
   if (io_->open() != 0)
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   IoCloser closer(*io_);
@@ -590,10 +593,10 @@ void WebPImage::decodeChunks(uint32_t filesize) {
       std::copy_n(payload.begin() + 9, 3, size_buf.begin());
       size_buf.back() = 0;
       pixelHeight_ = Exiv2::getULong(size_buf.data(), littleEndian) + 1;
-    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ICCP)) {
+    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ICCP) && (readFilter() & mdIccProfile)) {
       io_->readOrThrow(payload.data(), payload.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
       this->setIccProfile(std::move(payload));
-    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_EXIF)) {
+    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_EXIF) && (readFilter() & mdExif)) {
       io_->readOrThrow(payload.data(), payload.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
 
       std::array<byte, 2> size_buff2;
@@ -659,7 +662,7 @@ void WebPImage::decodeChunks(uint32_t filesize) {
 
       if (pos != std::string::npos) {
         XmpData xmpData;
-        ByteOrder bo = ExifParser::decode(exifData_, payload.c_data(pos), payload.size() - pos);
+        ByteOrder bo = ExifParser::decode(exifData_, payload.c_data(pos), payload.size() - pos, makerNotePolicy());
         setByteOrder(bo);
       } else {
 #ifndef SUPPRESS_WARNINGS
@@ -667,7 +670,7 @@ void WebPImage::decodeChunks(uint32_t filesize) {
 #endif
         exifData_.clear();
       }
-    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP)) {
+    } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP) && (readFilter() & mdXmp)) {
       io_->readOrThrow(payload.data(), payload.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
       xmpPacket_.assign(payload.c_str(), payload.size());
       if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
@@ -5,6 +5,7 @@
 // included header files
 #include "error.hpp"
 #include "properties.hpp"
+#include "stats_int.hpp"
 #include "types.hpp"
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
@@ -658,6 +659,7 @@ void XmpParser::terminate() {
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
 int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
+  EXV_STATS_PHASE(xmpParse);
   try {
     xmpData.setPacket(xmpPacket);
     if (xmpPacket.empty()) {
@@ -814,6 +816,7 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
 int XmpParser::encode(std::string& xmpPacket, const XmpData& xmpData, uint16_t formatFlags, uint32_t padding) {
+  EXV_STATS_PHASE(encode);
   try {
     // Acquire Giant Lock
     XmpProperties::XmpLock lock;
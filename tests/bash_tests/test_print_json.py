@@ -0,0 +1,19 @@
+# -*- coding: utf-8 -*-
+
+import system_tests
+
+
+class PrintJsonLines(metaclass=system_tests.CaseMeta):
+    filename = "$data_path/Reagan.tiff"
+    commands = [
+        "$exiv2 -pj -K Exif.Image.Model -K Exif.Photo.ExposureProgram -K Xmp.dc.subject $filename",
+        "$exiv2 -pj -g Exif.Image.NoSuchTag $filename",
+    ]
+    retval = [0, 1]
+    stderr = [""] * len(commands)
+    stdout = [
+        """{"file":"$filename","metadata":[{"key":"Exif.Image.Model","type":"Ascii","count":10,"value":"NIKON D1X","interpreted":"NIKON D1X"},{"key":"Exif.Photo.ExposureProgram","type":"Short","count":1,"value":"1","interpreted":"Manual"},{"key":"Xmp.dc.subject","type":"XmpBag","count":10,"value":"ronald reagan, reagan, cvn 76, cvn-76, straights magellan, magellan, carrier, nimitz-class, ship, underway","interpreted":"ronald reagan, reagan, cvn 76, cvn-76, straights magellan, magellan, carrier, nimitz-class, ship, underway"}]}
+""",
+        """{"file":"$filename","metadata":[]}
+""",
+    ]
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/error.hpp>
+#include <exiv2/tags.hpp>
+
+#include <unordered_set>
+
+using namespace Exiv2;
+
+TEST(ExifKey, creationFromTagAndIfdIdFormatsKey) {
+  const ExifKey key(0x0112, IfdId::ifd0Id);
+  ASSERT_EQ("Exif.Image.Orientation", key.key());
+  ASSERT_EQ("Image", key.groupName());
+  ASSERT_EQ("Orientation", key.tagName());
+  ASSERT_EQ(0x0112, key.tag());
+  ASSERT_EQ(IfdId::ifd0Id, key.ifdId());
+}
+
+TEST(ExifKey, creationFromTagAndIfdIdFormatsUnknownTagAsHex) {
+  const ExifKey key(0xabcd, IfdId::exifId);
+  ASSERT_EQ("Exif.Photo.0xabcd", key.key());
+}
+
+TEST(ExifKey, creationFromTagAndIfdIdThrowsForNonExifIfd) {
+  ASSERT_THROW(ExifKey(0x0112, IfdId::ifdIdNotSet), Exiv2::Error);
+}
+
+TEST(ExifKey, allConstructorsCreateTheSameKey) {
+  const ExifKey fromString("Exif.Photo.DateTimeOriginal");
+  const ExifKey fromGroupName(0x9003, "Photo");
+  const ExifKey fromIfdId(0x9003, IfdId::exifId);
+  ASSERT_EQ(fromString.key(), fromIfdId.key());
+  ASSERT_EQ(fromGroupName.key(), fromIfdId.key());
+  ASSERT_EQ(fromString, fromIfdId);
+  ASSERT_EQ(fromGroupName, fromIfdId);
+}
+
+TEST(ExifKey, copiesCompareEqual) {
+  const ExifKey key(0x0112, IfdId::ifd0Id);
+  ExifKey copy(0x0110, IfdId::ifd0Id);
+  ASSERT_NE(key, copy);
+  copy = key;
+  ASSERT_EQ(key, copy);
+  ASSERT_EQ(key.key(), copy.key());
+}
+
+TEST(ExifKey, keysInDifferentGroupsAreDifferent) {
+  ASSERT_NE(ExifKey(0x0112, IfdId::ifd0Id), ExifKey(0x0112, IfdId::ifd1Id));
+}
+
+TEST(ExifKey, hashIsConsistentWithEquality) {
+  std::unordered_set<ExifKey> keys;
+  keys.insert(ExifKey("Exif.Image.Orientation"));
+  keys.insert(ExifKey(0x0112, IfdId::ifd0Id));
+  keys.insert(ExifKey(0x0112, IfdId::ifd1Id));
+  ASSERT_EQ(2u, keys.size());
+  ASSERT_EQ(1u, keys.count(ExifKey(0x0112, "Image")));
+}
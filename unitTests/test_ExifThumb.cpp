@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/exif.hpp>  // Unit under test
+#include <exiv2/image.hpp>
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+Image::UniquePtr openImage(const std::string& name) {
+  return ImageFactory::open((fs::path(TESTDATA_PATH) / name).string());
+}
+}  // namespace
+
+TEST(ExifThumbC, findsTheSameJpegThumbnailAsTheDecoder) {
+  size_t found = 0;
+  for (auto&& file : fs::directory_iterator(TESTDATA_PATH)) {
+    Image::UniquePtr image;
+    DataBuf thumbnail;
+    try {
+      image = ImageFactory::open(file.path().string());
+      thumbnail = image->readExifThumbnail();
+      image->readMetadata();
+    } catch (const std::exception&) {
+      continue;
+    }
+    SCOPED_TRACE(file.path().filename().string());
+    const ExifThumbC exifThumb(image->exifData());
+    if (thumbnail.empty())
+      continue;
+    ++found;
+    EXPECT_STREQ("image/jpeg", exifThumb.mimeType());
+    const DataBuf copy = exifThumb.copy();
+    ASSERT_EQ(copy.size(), thumbnail.size());
+    EXPECT_EQ(0, thumbnail.cmpBytes(0, copy.c_data(), copy.size()));
+  }
+  EXPECT_GT(found, 50u);
+}
+
+TEST(ExifThumbC, readsTheThumbnailWithoutReadingTheMetadata) {
+  auto image = openImage("exiv2-canon-eos-20d.jpg");
+  const DataBuf thumbnail = image->readExifThumbnail();
+  ASSERT_FALSE(thumbnail.empty());
+  EXPECT_EQ(0xff, thumbnail.read_uint8(0));
+  EXPECT_EQ(0xd8, thumbnail.read_uint8(1));
+  EXPECT_TRUE(image->exifData().empty());
+
+  image = openImage("exiv2-bug922.tif");
+  image->readMetadata();
+  EXPECT_TRUE(image->readExifThumbnail().empty());
+  EXPECT_FALSE(image->exifData().empty());
+}
+
+TEST(ExifThumbC, findJpegChecksTheStructure) {
+  // Little endian TIFF header, IFD0 without entries, IFD1 with a 4 byte thumbnail at offset 52
+  std::array<byte, 56> tiff{
+      'I', 'I', 42, 0, 8, 0, 0, 0,                // Header
+      0, 0, 14, 0, 0, 0,                          // IFD0
+      3, 0,                                       // IFD1
+      0x03, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,   // Compression
+      0x01, 0x02, 4, 0, 1, 0, 0, 0, 52, 0, 0, 0,  // JPEGInterchangeFormat
+      0x02, 0x02, 4, 0, 1, 0, 0, 0, 4, 0, 0, 0,   // JPEGInterchangeFormatLength
+      0xff, 0xd8, 0xff, 0xd9,                     // Thumbnail
+  };
+  EXPECT_EQ(std::make_pair(size_t{52}, size_t{4}), ExifThumbC::findJpeg(tiff.data(), tiff.size()));
+  // Thumbnail exceeds the data
+  EXPECT_EQ(size_t{0}, ExifThumbC::findJpeg(tiff.data(), tiff.size() - 1).second);
+  // Not a JPEG thumbnail
+  tiff[24] = 1;
+  EXPECT_EQ(size_t{0}, ExifThumbC::findJpeg(tiff.data(), tiff.size()).second);
+  tiff[24] = 6;
+  // No IFD1
+  tiff[10] = 0;
+  EXPECT_EQ(size_t{0}, ExifThumbC::findJpeg(tiff.data(), tiff.size()).second);
+  // Bad header
+  tiff[10] = 14;
+  tiff[2] = 43;
+  EXPECT_EQ(size_t{0}, ExifThumbC::findJpeg(tiff.data(), tiff.size()).second);
+  EXPECT_EQ(size_t{0}, ExifThumbC::findJpeg(tiff.data(), 7).second);
+}
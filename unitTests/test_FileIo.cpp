@@ -2,11 +2,46 @@
 
 #include <gtest/gtest.h>
 #include "basicio.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace Exiv2;
+namespace fs = std::filesystem;
 
 namespace {
 constexpr auto imagePath = TESTDATA_PATH "/DSC_3079.jpg";
 constexpr auto nonExistingImagePath = TESTDATA_PATH "/nonExisting.jpg";
+
+//! Read the file with a mix of small and large reads and seeks
+std::vector<byte> readMixed(FileIo& file) {
+  std::vector<byte> data;
+  byte buf[70000];
+  size_t step = 0;
+  while (!file.eof()) {
+    const size_t sizes[] = {1, 3, 100, 5000, 70000, 12};
+    const size_t n = file.read(buf, sizes[step++ % std::size(sizes)]);
+    data.insert(data.end(), buf, buf + n);
+    if (int c = file.getb(); c != EOF)
+      data.push_back(static_cast<byte>(c));
+    // Jump back and forth, which resets the read-ahead
+    if (step % 4 == 0 && file.seek(-2, BasicIo::cur) == 0)
+      data.resize(data.size() - 2);
+  }
+  return data;
+}
+
+//! Copy the test image to a temporary file, which the test may modify
+std::string copyOfImage() {
+  const auto name = std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".jpg";
+  const auto path = fs::temp_directory_path() / name;
+  fs::copy_file(imagePath, path, fs::copy_options::overwrite_existing);
+  return path.string();
+}
 }  // namespace
 
 TEST(AFileIO, canBeInstantiatedWithFilePath) {
@@ -77,3 +112,143 @@ TEST(AFileIO, canSeekBeyondEOF) {
   ASSERT_FALSE(file.error());
   ASSERT_FALSE(file.eof());
 }
+
+TEST(AFileIO, usesTheDefaultBackend) {
+  EXPECT_EQ(FileIo::Backend::stdio, FileIo::defaultBackend());
+  EXPECT_EQ(FileIo::Backend::stdio, FileIo(imagePath).backend());
+#ifndef _WIN32
+  FileIo::setDefaultBackend(FileIo::Backend::positional);
+  EXPECT_EQ(FileIo::Backend::positional, FileIo(imagePath).backend());
+  FileIo::setDefaultBackend(FileIo::Backend::stdio);
+  EXPECT_EQ(FileIo::Backend::positional, FileIo(imagePath, FileIo::Backend::positional).backend());
+#endif
+}
+
+TEST(AFileIO, readsTheSameWithBothBackends) {
+  FileIo stdio(imagePath, FileIo::Backend::stdio);
+  FileIo positional(imagePath, FileIo::Backend::positional);
+  ASSERT_EQ(0, stdio.open());
+  ASSERT_EQ(0, positional.open());
+
+  const auto data = readMixed(stdio);
+  EXPECT_EQ(118685u, data.size());
+  EXPECT_EQ(data, readMixed(positional));
+  EXPECT_TRUE(positional.eof());
+  EXPECT_FALSE(positional.error());
+  EXPECT_EQ(stdio.tell(), positional.tell());
+
+  ASSERT_EQ(0, positional.seek(-10, BasicIo::end));
+  EXPECT_FALSE(positional.eof());
+  EXPECT_EQ(118675u, positional.tell());
+  EXPECT_EQ(0xd9, positional.read(10).c_data()[9]);
+}
+
+#ifndef _WIN32
+TEST(AFileIO, reportsAFailedReadWithThePositionalBackend) {
+  // A directory can be opened, but not read
+  FileIo file(TESTDATA_PATH, FileIo::Backend::positional);
+  ASSERT_EQ(0, file.open());
+  byte buf[16];
+  EXPECT_EQ(0u, file.read(buf, sizeof(buf)));
+  EXPECT_TRUE(file.error());
+  EXPECT_FALSE(file.eof());
+}
+#endif
+
+TEST(AFileIO, writesWithThePositionalBackendToAFileOpenedForReading) {
+  const auto path = copyOfImage();
+  {
+    FileIo file(path, FileIo::Backend::positional);
+    ASSERT_EQ(0, file.open());
+    byte buf[16];
+    ASSERT_EQ(sizeof(buf), file.read(buf, sizeof(buf)));
+    const byte data[] = {'e', 'x', 'i', 'v', '2'};
+    ASSERT_EQ(0, file.seek(4, BasicIo::beg));
+    ASSERT_EQ(sizeof(data), file.write(data, sizeof(data)));
+    EXPECT_EQ(9u, file.tell());
+    // The read-ahead buffer does not return the old data
+    ASSERT_EQ(0, file.seek(0, BasicIo::beg));
+    ASSERT_EQ(sizeof(buf), file.read(buf, sizeof(buf)));
+    EXPECT_EQ(0, std::memcmp(buf + 4, data, sizeof(data)));
+    ASSERT_EQ(0, file.seek(0, BasicIo::end));
+    EXPECT_EQ('!', file.putb('!'));
+    EXPECT_EQ(118686u, file.size());
+  }
+  FileIo file(path, FileIo::Backend::stdio);
+  ASSERT_EQ(0, file.open());
+  const DataBuf buf = file.read(file.size());
+  EXPECT_EQ(0, buf.cmpBytes(4, "exiv2", 5));
+  EXPECT_EQ('!', buf.read_uint8(118685));
+  file.close();
+  fs::remove(path);
+}
+
+TEST(AFileIO, readAtThrowsWithTheStdioBackend) {
+  FileIo file(imagePath, FileIo::Backend::stdio);
+  ASSERT_EQ(0, file.open());
+  byte buf[16];
+  EXPECT_THROW(file.readAt(buf, sizeof(buf), 0), Exiv2::Error);
+}
+
+#ifndef _WIN32
+TEST(AFileIO, readsAtAnOffsetFromSeveralThreads) {
+  FileIo reference(imagePath);
+  ASSERT_EQ(0, reference.open());
+  const DataBuf expected = reference.read(reference.size());
+
+  FileIo file(imagePath, FileIo::Backend::positional);
+  ASSERT_EQ(0, file.open());
+  ASSERT_EQ(0, file.seek(1000, BasicIo::beg));
+
+  std::vector<int> failures(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&, t] {
+      byte buf[997];
+      for (size_t offset = t * 100; offset < expected.size(); offset += sizeof(buf)) {
+        const size_t n = file.readAt(buf, sizeof(buf), offset);
+        if (n != std::min(sizeof(buf), expected.size() - offset) || std::memcmp(buf, expected.c_data(offset), n) != 0)
+          ++failures[t];
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  EXPECT_EQ(std::vector<int>(4), failures);
+  EXPECT_EQ(1000u, file.tell());
+}
+
+TEST(AFileIO, servesPrefetchedDataUntilItIsWritten) {
+  const auto path = copyOfImage();
+  FileIo file(path, FileIo::Backend::positional);
+  ASSERT_EQ(0, file.prefetch(1024));
+  ASSERT_FALSE(file.isopen());
+
+  // Change the file behind the back of the instance
+  const byte changed[] = {'a', 'b', 'c', 'd'};
+  {
+    FileIo other(path, FileIo::Backend::stdio);
+    ASSERT_EQ(0, other.open("r+b"));
+    ASSERT_EQ(0, other.seek(100, BasicIo::beg));
+    ASSERT_EQ(sizeof(changed), other.write(changed, sizeof(changed)));
+  }
+
+  FileIo reference(imagePath);
+  ASSERT_EQ(0, reference.open());
+  const DataBuf expected = reference.read(reference.size());
+  ASSERT_EQ(0, file.open());
+  const DataBuf prefetched = file.read(file.size());
+  ASSERT_EQ(expected.size(), prefetched.size());
+  EXPECT_EQ(0, std::memcmp(expected.c_data(), prefetched.c_data(), expected.size()));
+
+  // A write drops the prefetched data
+  ASSERT_EQ(0, file.seek(0, BasicIo::beg));
+  ASSERT_EQ(1u, file.write(expected.c_data(), 1));
+  ASSERT_EQ(0, file.seek(100, BasicIo::beg));
+  byte buf[sizeof(changed)];
+  ASSERT_EQ(sizeof(buf), file.read(buf, sizeof(buf)));
+  EXPECT_EQ(0, std::memcmp(changed, buf, sizeof(buf)));
+  file.close();
+  fs::remove(path);
+}
+#endif
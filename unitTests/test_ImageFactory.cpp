@@ -2,9 +2,13 @@
 
 #include <image.hpp>  // Unit under test
 
+#include <basicio.hpp>
+
 #include <error.hpp>  // Need to include this header for the Exiv2::Error exception
 
 #include <filesystem>
+#include <memory>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -143,6 +147,38 @@ TEST(TheImageFactory, loadInstancesDifferentImageTypes) {
   EXPECT_NO_THROW(ImageFactory::open(imagePath, false));
 }
 
+TEST(TheImageFactory, readsOnlySelectedMetadataFromJpegImages) {
+  fs::path testData(TESTDATA_PATH);
+  const std::string imagePath = (testData / "Reagan.jpg").string();
+
+  auto image = ImageFactory::open(imagePath, false);
+  EXPECT_EQ(mdExif | mdIptc | mdComment | mdXmp | mdIccProfile, image->readFilter());
+  image->setReadFilter(mdIptc);
+  EXPECT_EQ(mdIptc, image->readFilter());
+  image->readMetadata();
+  EXPECT_TRUE(image->exifData().empty());
+  EXPECT_FALSE(image->iptcData().empty());
+  EXPECT_TRUE(image->xmpData().empty());
+  EXPECT_TRUE(image->xmpPacket().empty());
+}
+
+TEST(TheImageFactory, readsOnlySelectedMetadataFromTiffImages) {
+  fs::path testData(TESTDATA_PATH);
+  const std::string imagePath = (testData / "Reagan.tiff").string();
+
+  auto image = ImageFactory::open(imagePath, false);
+  image->setReadFilter(mdExif);
+  image->readMetadata();
+  EXPECT_FALSE(image->exifData().empty());
+  EXPECT_TRUE(image->iptcData().empty());
+  EXPECT_TRUE(image->xmpData().empty());
+
+  image->setReadFilter(mdExif | mdIptc | mdComment | mdXmp | mdIccProfile);
+  image->readMetadata();
+  EXPECT_FALSE(image->iptcData().empty());
+  EXPECT_FALSE(image->xmpData().empty());
+}
+
 TEST(TheImageFactory, getsExpectedModesForJp2Images) {
   EXPECT_EQ(amNone, ImageFactory::checkMode(ImageType::jp2, mdNone));
   EXPECT_EQ(amReadWrite, ImageFactory::checkMode(ImageType::jp2, mdExif));
@@ -362,3 +398,66 @@ TEST(TheImageFactory, getsExpectedModesForXmpImages) {
 }
 
 /// \todo check why JpegBase is taking ImageType in the constructor
+
+namespace {
+//! Read the metadata of \em file through a TracingIo and return the summary of the calls
+TracingIo::Summary traceReadMetadata(const std::string& file, bool stopAtImageData = false) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / file).string(), false, true);
+  auto& tracingIo = dynamic_cast<TracingIo&>(image->io());
+  image->setStopAtImageData(stopAtImageData);
+  tracingIo.clearEvents();
+  image->readMetadata();
+  return tracingIo.summary();
+}
+}  // namespace
+
+TEST(TheImageFactory, opensImagesThroughATracingIo) {
+  auto io = std::make_unique<TracingIo>(ImageFactory::createIo((fs::path(TESTDATA_PATH) / "Reagan.tiff").string()));
+  auto& tracingIo = *io;
+  auto image = ImageFactory::open(std::move(io));
+  ASSERT_EQ(ImageType::tiff, image->imageType());
+  // Type detection reads through the tracing IO
+  EXPECT_EQ(TracingIo::opOpen, tracingIo.events().front().op_);
+  EXPECT_LT(0u, tracingIo.summary().reads_);
+  image->readMetadata();
+  EXPECT_FALSE(image->exifData().empty());
+}
+
+TEST(TheImageFactory, opensAFileThroughATracingIoOnRequest) {
+  const auto path = (fs::path(TESTDATA_PATH) / "Reagan.tiff").string();
+  auto image = ImageFactory::open(path, false, true);
+  const auto* tracingIo = dynamic_cast<TracingIo*>(&image->io());
+  ASSERT_NE(nullptr, tracingIo);
+  EXPECT_EQ(TracingIo::opOpen, tracingIo->events().front().op_);
+  EXPECT_EQ(path, tracingIo->path());
+
+  image = ImageFactory::open(path, false, false);
+  EXPECT_EQ(nullptr, dynamic_cast<TracingIo*>(&image->io()));
+}
+
+// I/O budgets of readMetadata, to catch parsers which read too much or in too many pieces
+TEST(TheImageFactory, readsJpegMetadataWithoutReadingTheFileTwice) {
+  auto summary = traceReadMetadata("exiv2-canon-eos-20d.jpg");
+  EXPECT_LE(summary.readAmplification(), 1.0);
+  EXPECT_LE(summary.seeks_, 2u);
+  EXPECT_LE(summary.reads_, 50u);
+}
+
+TEST(TheImageFactory, readsTiffMetadataFromAMappedFile) {
+  auto summary = traceReadMetadata("Reagan.tiff");
+  EXPECT_EQ(1u, summary.mmaps_);
+  EXPECT_LE(summary.reads_, 10u);
+  EXPECT_LE(summary.bytesRead_, 100u);
+}
+
+#ifdef EXV_HAVE_LIBZ
+TEST(TheImageFactory, readsPngMetadataInBlocks) {
+  auto summary = traceReadMetadata("imagemagick.png");
+  EXPECT_LE(summary.readAmplification(), 1.0);
+  EXPECT_LE(summary.reads_, 25u);
+
+  summary = traceReadMetadata("imagemagick.png", true);
+  EXPECT_LE(summary.reads_, 2u);
+  EXPECT_LT(summary.bytesRead_, summary.size_ / 2);
+}
+#endif
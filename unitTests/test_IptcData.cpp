@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/iptc.hpp>  // Unit under test
+#include <exiv2/datasets.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Exiv2;
+
+namespace {
+IptcData keywords(size_t count) {
+  IptcData iptcData;
+  iptcData["Iptc.Application2.City"] = "Zurich";
+  for (size_t i = 0; i < count; ++i) {
+    Iptcdatum keyword(IptcKey("Iptc.Application2.Keywords"));
+    keyword.setValue("keyword " + std::to_string(i));
+    iptcData.add(keyword);
+  }
+  iptcData["Iptc.Application2.Caption"] = "A caption";
+  return iptcData;
+}
+}  // namespace
+
+TEST(IptcData, eraseKeyRemovesAllDatasetsWithTheKey) {
+  IptcData iptcData = keywords(500);
+  ASSERT_EQ(502u, iptcData.count());
+
+  EXPECT_EQ(500u, iptcData.eraseKey(IptcKey("Iptc.Application2.Keywords")));
+  ASSERT_EQ(2u, iptcData.count());
+  EXPECT_EQ(iptcData.end(), iptcData.findKey(IptcKey("Iptc.Application2.Keywords")));
+  EXPECT_EQ("Iptc.Application2.City", iptcData.begin()->key());
+  EXPECT_EQ("Iptc.Application2.Caption", (iptcData.begin() + 1)->key());
+}
+
+TEST(IptcData, eraseKeyWithoutMatchKeepsTheData) {
+  IptcData iptcData = keywords(3);
+  EXPECT_EQ(0u, iptcData.eraseKey(IptcKey("Iptc.Application2.Headline")));
+  EXPECT_EQ(5u, iptcData.count());
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exif.hpp>  // Unit under test
+#include <basicio.hpp>
+#include <easyaccess.hpp>
+#include <image.hpp>
+#include <tags.hpp>
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+Image::UniquePtr readImage(const std::string& file, MakerNotePolicy mnPolicy) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / file).string());
+  image->setMakerNotePolicy(mnPolicy);
+  image->readMetadata();
+  return image;
+}
+
+Entries entries(const ExifData& exifData) {
+  Entries ret;
+  for (auto&& md : exifData)
+    ret.emplace_back(md.key(), md.toString());
+  return ret;
+}
+
+size_t countMakerNoteTags(const ExifData& exifData) {
+  size_t ret = 0;
+  for (auto&& md : exifData) {
+    if (ExifTags::isMakerGroup(md.groupName()))
+      ++ret;
+  }
+  return ret;
+}
+}  // namespace
+
+TEST(MakerNotePolicy, isFullByDefault) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / "exiv2-canon-eos-20d.jpg").string());
+  EXPECT_EQ(MakerNotePolicy::full, image->makerNotePolicy());
+  image->readMetadata();
+  EXPECT_FALSE(image->exifData().makerNotePending());
+  EXPECT_GT(countMakerNoteTags(image->exifData()), 0u);
+}
+
+TEST(MakerNotePolicy, noneSkipsTheMakerNote) {
+  auto full = readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::full);
+  auto none = readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::none);
+  const ExifData& exifData = none->exifData();
+
+  EXPECT_EQ(0u, countMakerNoteTags(exifData));
+  EXPECT_FALSE(exifData.makerNotePending());
+  EXPECT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Photo.MakerNote")));
+  EXPECT_EQ(full->exifData().findKey(ExifKey("Exif.Image.Model"))->toString(),
+            exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+}
+
+TEST(MakerNotePolicy, rawBlobKeepsTheMakerNoteUntilDecoded) {
+  auto full = readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::full);
+  auto raw = readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::rawBlob);
+  ExifData& exifData = raw->exifData();
+
+  EXPECT_TRUE(exifData.makerNotePending());
+  EXPECT_EQ(0u, countMakerNoteTags(exifData));
+  EXPECT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Photo.MakerNote")));
+  // A lookup does not decode the makernote
+  EXPECT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Canon.ModelID")));
+  EXPECT_TRUE(exifData.makerNotePending());
+
+  exifData.decodeMakerNote();
+  EXPECT_FALSE(exifData.makerNotePending());
+  EXPECT_EQ(entries(full->exifData()), entries(exifData));
+}
+
+TEST(MakerNotePolicy, lazyDecodesOnFirstMakerNoteLookup) {
+  auto full = readImage("NikonZ6.exv", MakerNotePolicy::full);
+  auto lazy = readImage("NikonZ6.exv", MakerNotePolicy::lazy);
+  ExifData& exifData = lazy->exifData();
+
+  EXPECT_TRUE(exifData.makerNotePending());
+  auto model = exifData.findKey(ExifKey("Exif.Image.Model"));
+  ASSERT_NE(exifData.end(), model);
+  EXPECT_TRUE(exifData.makerNotePending());
+
+  EXPECT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Nikon3.Lens")));
+  EXPECT_FALSE(exifData.makerNotePending());
+  EXPECT_EQ("Exif.Image.Model", model->key());
+  EXPECT_EQ(entries(full->exifData()), entries(exifData));
+}
+
+TEST(MakerNotePolicy, pendingMakerNoteIsCopied) {
+  auto full = readImage("exiv2-SonyILCE-7SM3.exv", MakerNotePolicy::full);
+  auto lazy = readImage("exiv2-SonyILCE-7SM3.exv", MakerNotePolicy::lazy);
+
+  ExifData copy = lazy->exifData();
+  EXPECT_TRUE(copy.makerNotePending());
+  copy.decodeMakerNote();
+  EXPECT_TRUE(lazy->exifData().makerNotePending());
+  EXPECT_EQ(entries(full->exifData()), entries(copy));
+}
+
+TEST(MakerNotePolicy, lazyDecodesOnConstLookup) {
+  auto full = readImage("NikonZ6.exv", MakerNotePolicy::full);
+  auto lazy = readImage("NikonZ6.exv", MakerNotePolicy::lazy);
+  const ExifData& exifData = lazy->exifData();
+
+  EXPECT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Nikon3.Lens")));
+  EXPECT_FALSE(exifData.makerNotePending());
+  EXPECT_EQ(entries(full->exifData()), entries(exifData));
+}
+
+TEST(MakerNotePolicy, easyAccessDecodesALazyMakerNote) {
+  auto full = readImage("exiv2-SonyILCE-7SM3.exv", MakerNotePolicy::full);
+  auto lazy = readImage("exiv2-SonyILCE-7SM3.exv", MakerNotePolicy::lazy);
+  auto raw = readImage("exiv2-SonyILCE-7SM3.exv", MakerNotePolicy::rawBlob);
+
+  // A standard tag is found without decoding the makernote
+  auto pos = exposureTime(lazy->exifData());
+  ASSERT_NE(lazy->exifData().end(), pos);
+  EXPECT_TRUE(lazy->exifData().makerNotePending());
+
+  pos = lensName(lazy->exifData());
+  ASSERT_NE(lazy->exifData().end(), pos);
+  EXPECT_FALSE(lazy->exifData().makerNotePending());
+  EXPECT_EQ(lensName(full->exifData())->key(), pos->key());
+  EXPECT_EQ(easyAccess(full->exifData()).whiteBalance->key(), easyAccess(lazy->exifData()).whiteBalance->key());
+
+  // Only the standard tags are found in a makernote kept as a raw blob
+  pos = whiteBalance(raw->exifData());
+  ASSERT_NE(raw->exifData().end(), pos);
+  EXPECT_FALSE(ExifTags::isMakerGroup(pos->groupName()));
+  EXPECT_TRUE(raw->exifData().makerNotePending());
+}
+
+TEST(MakerNotePolicy, decodesEntriesOutsideOfTheMakerNote) {
+  // Some Canon makernote entries of this image refer to data after the makernote
+  auto full = readImage("exiv2-canon-eos-300d.jpg", MakerNotePolicy::full);
+  auto raw = readImage("exiv2-canon-eos-300d.jpg", MakerNotePolicy::rawBlob);
+
+  raw->exifData().decodeMakerNote();
+  EXPECT_EQ(entries(full->exifData()), entries(raw->exifData()));
+}
+
+TEST(MakerNotePolicy, keepsTagsSetWhilePending) {
+  auto raw = readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::rawBlob);
+  ExifData& exifData = raw->exifData();
+
+  exifData["Exif.Canon.OwnerName"] = "Set while pending";
+  exifData.decodeMakerNote();
+  EXPECT_FALSE(exifData.makerNotePending());
+  size_t count = 0;
+  for (auto&& md : exifData) {
+    if (md.key() == "Exif.Canon.OwnerName") {
+      EXPECT_EQ("Set while pending", md.toString());
+      ++count;
+    }
+  }
+  EXPECT_EQ(1u, count);
+  EXPECT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Canon.ModelID")));
+}
+
+TEST(MakerNotePolicy, roundTripsOnWrite) {
+  const std::string file = "exiv2-canon-eos-300d.jpg";
+  // Read the image with the policy, write it, with a new tag to move the makernote, and read the result fully
+  auto writeAndRead = [&file](MakerNotePolicy mnPolicy, bool addTag) {
+    const DataBuf data = readFile((fs::path(TESTDATA_PATH) / file).string());
+    auto image = ImageFactory::open(data.c_data(), data.size());
+    image->setMakerNotePolicy(mnPolicy);
+    image->readMetadata();
+    if (addTag)
+      image->exifData()["Exif.Image.Artist"] = "Round trip";
+    image->writeMetadata();
+    EXPECT_EQ(mnPolicy != MakerNotePolicy::full, image->exifData().makerNotePending());
+
+    auto& io = image->io();
+    EXPECT_EQ(0, io.open());
+    const DataBuf written = io.read(io.size());
+    auto reread = ImageFactory::open(written.c_data(), written.size());
+    reread->readMetadata();
+    return entries(reread->exifData());
+  };
+
+  const Entries original = entries(readImage(file, MakerNotePolicy::full)->exifData());
+  const Entries moved = writeAndRead(MakerNotePolicy::full, true);
+  EXPECT_NE(original, moved);
+  for (auto mnPolicy : {MakerNotePolicy::rawBlob, MakerNotePolicy::lazy}) {
+    EXPECT_EQ(original, writeAndRead(mnPolicy, false));
+    EXPECT_EQ(moved, writeAndRead(mnPolicy, true));
+  }
+}
+
+TEST(MakerNotePolicy, decodesFromATiffFileAfterItIsWritten) {
+  const auto path = fs::temp_directory_path() / "exiv2-test-MakerNotePolicy.tif";
+  fs::copy_file(fs::path(TESTDATA_PATH) / "mini9.tif", path, fs::copy_options::overwrite_existing);
+  {
+    auto tiff = ImageFactory::open(path.string());
+    tiff->readMetadata();
+    tiff->setExifData(readImage("exiv2-canon-eos-20d.jpg", MakerNotePolicy::full)->exifData());
+    tiff->writeMetadata();
+  }
+  auto readTiff = [&path](MakerNotePolicy mnPolicy) {
+    auto image = ImageFactory::open(path.string());
+    image->setMakerNotePolicy(mnPolicy);
+    image->readMetadata();
+    return image;
+  };
+  const Entries expected = entries(readTiff(MakerNotePolicy::full)->exifData());
+  ASSERT_GT(countMakerNoteTags(readTiff(MakerNotePolicy::full)->exifData()), 0u);
+
+  // The makernote is decoded from the file, which the write replaces
+  auto raw = readTiff(MakerNotePolicy::rawBlob);
+  raw->exifData()["Exif.Image.Artist"] = "Round trip";
+  raw->writeMetadata();
+  ASSERT_TRUE(raw->exifData().makerNotePending());
+  raw->exifData().decodeMakerNote();
+  raw->exifData().erase(raw->exifData().findKey(ExifKey("Exif.Image.Artist")));
+  EXPECT_EQ(expected, entries(raw->exifData()));
+  EXPECT_EQ(countMakerNoteTags(raw->exifData()), countMakerNoteTags(readTiff(MakerNotePolicy::full)->exifData()));
+  fs::remove(path);
+}
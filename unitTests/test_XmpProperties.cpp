@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/properties.hpp>  // Unit under test
+#include <exiv2/error.hpp>
+
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Exiv2;
+
+namespace {
+//! Prefixes of all built-in schemas
+const char* const builtinPrefixes[] = {
+    "dc", "digiKam", "kipi", "xmp", "xmpRights", "xmpMM", "xmpBJ", "xmpTPg", "xmpDM", "MicrosoftPhoto", "lr", "pdf",
+    "photoshop", "crs", "crss", "tiff", "exif", "exifEX", "aux", "iptc", "Iptc4xmpCore", "iptcExt", "Iptc4xmpExt",
+    "plus", "mediapro", "expressionmedia", "MP", "MPRI", "MPReg", "mwg-rs", "mwg-kw", "video", "audio", "dwc",
+    "dcterms", "acdsee", "GPano", "xmpG", "xmpGImg", "stDim", "stFnt", "stEvt", "stRef", "stVer", "stJob", "stArea",
+    "xmpidq",
+};
+
+//! Return the first property \em name of the property list \em pl
+const XmpPropertyInfo* linearFind(const XmpPropertyInfo* pl, const char* name) {
+  for (; pl && pl->name_; ++pl) {
+    if (std::strcmp(pl->name_, name) == 0)
+      return pl;
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(XmpProperties, findsEveryBuiltinProperty) {
+  for (auto prefix : builtinPrefixes) {
+    const XmpPropertyInfo* pl = XmpProperties::propertyList(prefix);
+    for (auto pi = pl; pi && pi->name_; ++pi) {
+      const XmpKey key(prefix, pi->name_);
+      EXPECT_EQ(linearFind(pl, pi->name_), XmpProperties::propertyInfo(key)) << key.key();
+      EXPECT_EQ(linearFind(pl, pi->name_)->typeId_, XmpProperties::propertyType(key)) << key.key();
+    }
+    EXPECT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey(prefix, "NoSuchProperty"))) << prefix;
+  }
+}
+
+TEST(XmpProperties, findsTheInnermostPropertyOfANestedPath) {
+  const XmpPropertyInfo* pi = XmpProperties::propertyInfo(XmpKey("Xmp.mwg-rs.Regions/mwg-rs:RegionList[1]/mwg-rs:Name"));
+  ASSERT_NE(nullptr, pi);
+  EXPECT_STREQ("Name", pi->name_);
+  EXPECT_EQ(linearFind(XmpProperties::propertyList("mwg-rs"), "Name"), pi);
+  EXPECT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey("Xmp.xmpMM.History[1]/stEvt:action")));
+}
+
+TEST(XmpProperties, mapsBetweenBuiltinPrefixesAndNamespaces) {
+  EXPECT_EQ("http://purl.org/dc/elements/1.1/", XmpProperties::ns("dc"));
+  EXPECT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1/"));
+  EXPECT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1"));
+  EXPECT_EQ("", XmpProperties::prefix("http://example.com/no-such-namespace/"));
+  EXPECT_STREQ("dc", XmpProperties::nsInfo("dc")->prefix_);
+  EXPECT_THROW(XmpProperties::nsInfo("noSuchPrefix"), Error);
+  EXPECT_THROW(XmpProperties::ns("noSuchPrefix"), Error);
+  EXPECT_THROW(XmpKey("Xmp.noSuchPrefix.title"), Error);
+}
+
+TEST(XmpProperties, customNamespaceOverridesBuiltinPrefix) {
+  const std::string ns("http://example.com/exiv2/custom-dc/");
+  XmpProperties::registerNs(ns, "dc");
+  EXPECT_EQ(ns, XmpProperties::ns("dc"));
+  EXPECT_EQ("dc", XmpProperties::prefix(ns));
+  // Custom namespaces have no property list
+  EXPECT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey("Xmp.dc.title")));
+  EXPECT_EQ(xmpText, XmpProperties::propertyType(XmpKey("Xmp.dc.subject")));
+
+  XmpProperties::unregisterNs(ns);
+  EXPECT_EQ("http://purl.org/dc/elements/1.1/", XmpProperties::ns("dc"));
+  EXPECT_EQ("", XmpProperties::prefix(ns));
+  EXPECT_EQ(xmpBag, XmpProperties::propertyType(XmpKey("Xmp.dc.subject")));
+}
@@ -4,6 +4,8 @@
 #include <exiv2/basicio.hpp>
 
 #include <array>
+#include <memory>
+#include <vector>
 
 using namespace Exiv2;
 
@@ -169,3 +171,166 @@ TEST(MemIo, readMoreBytesThanAvailableReturnsAvailableBytes) {
   MemIo io(buf1.data(), buf1.size());
   ASSERT_EQ(10u, io.read(buf2.data(), 15));
 }
+
+TEST(MemIo, reserveKeepsSizeAndData) {
+  std::array<byte, 10> buf;
+  buf.fill(7);
+
+  MemIo io(buf.data(), buf.size());
+  io.reserve(1024 * 1024);
+  ASSERT_EQ(10u, io.size());
+  ASSERT_EQ(0u, io.tell());
+  ASSERT_EQ(7, io.mmap()[9]);
+  // The original data is not modified by a write after the copy
+  ASSERT_EQ(0, io.putb(0));
+  ASSERT_EQ(7, buf[0]);
+}
+
+TEST(MemIo, writesLargeDataInPieces) {
+  std::array<byte, 4096> buf;
+  MemIo io;
+  io.reserve(100);
+  for (size_t i = 0; i < 1024; ++i) {
+    buf.fill(static_cast<byte>(i));
+    ASSERT_EQ(buf.size(), io.write(buf.data(), buf.size()));
+  }
+  ASSERT_EQ(1024u * buf.size(), io.size());
+  for (size_t i = 0; i < 1024; ++i) {
+    ASSERT_EQ(static_cast<byte>(i), io.mmap()[i * buf.size()]);
+    ASSERT_EQ(static_cast<byte>(i), io.mmap()[i * buf.size() + buf.size() - 1]);
+  }
+}
+
+TEST(MemIo, canWriteAfterTransfer) {
+  std::array<byte, 100> buf;
+  buf.fill(1);
+  MemIo dst;
+  {
+    MemIo src;
+    src.reserve(1024 * 1024);
+    src.write(buf.data(), buf.size());
+    dst.transfer(src);
+  }
+  ASSERT_EQ(100u, dst.size());
+  ASSERT_EQ(0, dst.seek(0, BasicIo::end));
+  for (int i = 0; i < 1000; ++i)
+    dst.write(buf.data(), buf.size());
+  ASSERT_EQ(100100u, dst.size());
+  ASSERT_EQ(1, dst.mmap()[100099]);
+}
+
+TEST(MemIo, reusesReleasedMemory) {
+  constexpr size_t size = 2 * 1024 * 1024;
+  std::array<byte, 100> buf;
+  buf.fill(3);
+  const byte* block = nullptr;
+  {
+    MemIo io;
+    io.reserve(size);
+    io.write(buf.data(), buf.size());
+    block = io.mmap();
+  }
+  // A block given back to the allocator would likely be handed out here
+  std::vector<byte> other(size);
+  for (int i = 0; i < 10; ++i) {
+    MemIo io;
+    io.reserve(size);
+    ASSERT_EQ(0u, io.size());
+    io.write(buf.data(), buf.size());
+    ASSERT_EQ(100u, io.size());
+    ASSERT_EQ(3, io.mmap()[99]);
+    ASSERT_EQ(block, io.mmap());
+  }
+}
+
+TEST(MemIo, worksAfterItsPoolIsReleased) {
+  std::array<byte, 100> buf;
+  buf.fill(3);
+  {
+    MemIo io;
+    io.reserve(1024 * 1024);
+    io.write(buf.data(), buf.size());
+  }
+  MemIo::releasePool();
+  MemIo::releasePool();
+  const byte* block = nullptr;
+  {
+    MemIo io;
+    io.write(buf.data(), buf.size());
+    ASSERT_EQ(3, io.mmap()[99]);
+    block = io.mmap();
+  }
+  // The pool keeps blocks again after it was released
+  MemIo io;
+  io.write(buf.data(), buf.size());
+  EXPECT_EQ(block, io.mmap());
+}
+
+TEST(TracingIo, forwardsAndRecordsCalls) {
+  const std::array<byte, 8> data{1, 2, 3, 4, 5, 6, 7, 8};
+  TracingIo io(std::make_unique<MemIo>(data.data(), data.size()));
+  ASSERT_EQ(0, io.open());
+  std::array<byte, 3> buf{};
+  ASSERT_EQ(3u, io.read(buf.data(), buf.size()));
+  ASSERT_EQ(3, buf[2]);
+  ASSERT_EQ(0, io.seek(2, BasicIo::cur));
+  ASSERT_EQ(6, io.getb());
+  ASSERT_EQ(2u, io.read(8).size());
+  ASSERT_TRUE(io.eof());
+  ASSERT_EQ(data.data(), io.mmap());
+  ASSERT_EQ("MemIo", io.path());
+
+  const auto& events = io.events();
+  ASSERT_EQ(6u, events.size());
+  EXPECT_EQ(TracingIo::opOpen, events[0].op_);
+  EXPECT_EQ(TracingIo::opRead, events[1].op_);
+  EXPECT_EQ(0u, events[1].offset_);
+  EXPECT_EQ(3u, events[1].length_);
+  EXPECT_EQ(TracingIo::opSeek, events[2].op_);
+  EXPECT_EQ(5u, events[2].offset_);
+  EXPECT_EQ(TracingIo::opRead, events[3].op_);
+  EXPECT_EQ(5u, events[3].offset_);
+  EXPECT_EQ(1u, events[3].length_);
+  EXPECT_EQ(6u, events[4].offset_);
+  EXPECT_EQ(2u, events[4].length_);
+  EXPECT_EQ(TracingIo::opMmap, events[5].op_);
+  EXPECT_EQ(8u, events[5].length_);
+}
+
+TEST(TracingIo, summarizesTheRecordedCalls) {
+  const std::array<byte, 64> data{};
+  TracingIo io(std::make_unique<MemIo>(data.data(), data.size()));
+  io.open();
+  std::array<byte, 32> buf{};
+  io.read(buf.data(), 4);
+  io.read(buf.data(), 32);
+  io.seek(0, BasicIo::beg);
+  io.read(buf.data(), 32);
+  io.getb();
+
+  auto summary = io.summary();
+  EXPECT_EQ(1u, summary.opens_);
+  EXPECT_EQ(4u, summary.reads_);
+  EXPECT_EQ(2u, summary.smallReads_);
+  EXPECT_EQ(69u, summary.bytesRead_);
+  EXPECT_EQ(1u, summary.seeks_);
+  EXPECT_EQ(0u, summary.writes_);
+  EXPECT_EQ(64u, summary.size_);
+  EXPECT_DOUBLE_EQ(69.0 / 64.0, summary.readAmplification());
+
+  io.clearEvents();
+  EXPECT_TRUE(io.events().empty());
+  EXPECT_EQ(0u, io.summary().reads_);
+}
+
+TEST(TracingIo, recordsWrites) {
+  TracingIo io(std::make_unique<MemIo>());
+  const std::array<byte, 5> data{1, 2, 3, 4, 5};
+  ASSERT_EQ(5u, io.write(data.data(), data.size()));
+  ASSERT_EQ(9, io.putb(9));
+  auto summary = io.summary();
+  EXPECT_EQ(2u, summary.writes_);
+  EXPECT_EQ(6u, summary.bytesWritten_);
+  EXPECT_EQ(6u, summary.size_);
+  EXPECT_EQ(5u, io.events().back().offset_);
+}
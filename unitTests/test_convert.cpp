@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/convert.hpp>  // Unit under test
+#include <exiv2/config.h>
+#include <exiv2/exif.hpp>
+#include <exiv2/tags.hpp>
+#include <exiv2/iptc.hpp>
+#include <exiv2/xmp_exiv2.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Exiv2;
+
+namespace {
+ExifData sampleExifData() {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Camera maker";
+  exifData["Exif.Image.Model"] = "Camera model";
+  exifData["Exif.Photo.ExposureTime"] = URational(1, 250);
+  exifData["Exif.Photo.Flash"] = uint16_t{0x19};
+  exifData["Exif.Photo.DateTimeOriginal"] = "2008:03:17 10:20:30";
+  return exifData;
+}
+}  // namespace
+
+TEST(Converter, copiesExifToXmp) {
+  XmpData xmpData;
+  copyExifToXmp(sampleExifData(), xmpData);
+  EXPECT_EQ("Camera maker", xmpData["Xmp.tiff.Make"].toString());
+  EXPECT_EQ("Camera model", xmpData["Xmp.tiff.Model"].toString());
+  EXPECT_EQ("1/250", xmpData["Xmp.exif.ExposureTime"].toString());
+  EXPECT_EQ("True", xmpData["Xmp.exif.Flash/exif:Fired"].toString());
+  EXPECT_EQ("2008-03-17T10:20:30", xmpData["Xmp.photoshop.DateCreated"].toString());
+  EXPECT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.exif.UserComment")));
+}
+
+TEST(Converter, copiesXmpStructuresToExif) {
+  XmpData xmpData;
+  copyExifToXmp(sampleExifData(), xmpData);
+  ExifData exifData;
+  copyXmpToExif(xmpData, exifData);
+  EXPECT_EQ("25", exifData["Exif.Photo.Flash"].toString());
+  EXPECT_EQ("Camera model", exifData["Exif.Image.Model"].toString());
+}
+
+TEST(Converter, removesTheExifCommentIfXmpHasNone) {
+  ExifData exifData = sampleExifData();
+  exifData["Exif.Photo.UserComment"] = "charset=Ascii A comment";
+  XmpData xmpData;
+  xmpData["Xmp.tiff.Model"] = "Other model";
+  copyXmpToExif(xmpData, exifData);
+  EXPECT_EQ("Other model", exifData["Exif.Image.Model"].toString());
+  EXPECT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Photo.UserComment")));
+  EXPECT_EQ("Camera maker", exifData["Exif.Image.Make"].toString());
+}
+
+TEST(Converter, copiesIptcToXmpAndBack) {
+  IptcData iptcData;
+  iptcData["Iptc.Application2.City"] = "Zurich";
+  XmpData xmpData;
+  copyIptcToXmp(iptcData, xmpData);
+  EXPECT_EQ("Zurich", xmpData["Xmp.photoshop.City"].toString());
+
+  IptcData copy;
+  copyXmpToIptc(xmpData, copy);
+  EXPECT_EQ("Zurich", copy["Iptc.Application2.City"].toString());
+}
+
+#ifdef EXV_HAVE_XMP_TOOLKIT
+TEST(Converter, syncFollowsTheNewerSide) {
+  ExifData exifData = sampleExifData();
+  XmpData xmpData;
+  syncExifWithXmp(exifData, xmpData);
+  const std::string tiffDigest = xmpData["Xmp.tiff.NativeDigest"].toString();
+  const std::string exifDigest = xmpData["Xmp.exif.NativeDigest"].toString();
+  EXPECT_FALSE(tiffDigest.empty());
+  EXPECT_FALSE(exifDigest.empty());
+  EXPECT_EQ("Camera model", xmpData["Xmp.tiff.Model"].toString());
+
+  // The digests match the Exif data: XMP is newer and is copied to Exif
+  xmpData["Xmp.tiff.Model"] = "XMP model";
+  syncExifWithXmp(exifData, xmpData);
+  EXPECT_EQ("XMP model", exifData["Exif.Image.Model"].toString());
+  EXPECT_NE(tiffDigest, xmpData["Xmp.tiff.NativeDigest"].toString());
+  EXPECT_EQ(exifDigest, xmpData["Xmp.exif.NativeDigest"].toString());
+
+  // The Exif data changed since: Exif is newer and is copied to XMP
+  exifData["Exif.Image.Model"] = "Exif model";
+  syncExifWithXmp(exifData, xmpData);
+  EXPECT_EQ("Exif model", xmpData["Xmp.tiff.Model"].toString());
+  XmpData fresh;
+  syncExifWithXmp(exifData, fresh);
+  EXPECT_EQ(fresh["Xmp.tiff.NativeDigest"].toString(), xmpData["Xmp.tiff.NativeDigest"].toString());
+  EXPECT_EQ(fresh["Xmp.exif.NativeDigest"].toString(), xmpData["Xmp.exif.NativeDigest"].toString());
+}
+#endif
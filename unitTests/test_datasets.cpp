@@ -128,6 +128,24 @@ TEST(IptcDataSets, dataSetReturnsExpectedValueWhenRequestingValidDatasetName) {
   ASSERT_EQ(IptcDataSets::FixtureId, IptcDataSets::dataSet("FixtureId", IptcDataSets::application2));
 }
 
+TEST(IptcDataSets, dataSetFindsEveryDatasetOfARecordByNameAndNumber) {
+  for (auto recordId : {IptcDataSets::envelope, IptcDataSets::application2}) {
+    const DataSet* dataSet = recordId == IptcDataSets::envelope ? IptcDataSets::envelopeRecordList()
+                                                                : IptcDataSets::application2RecordList();
+    for (int i = 0; dataSet[i].number_ != 0xffff; ++i) {
+      ASSERT_EQ(dataSet[i].number_, IptcDataSets::dataSet(dataSet[i].name_, recordId)) << dataSet[i].name_;
+      ASSERT_EQ(dataSet[i].name_, IptcDataSets::dataSetName(dataSet[i].number_, recordId));
+      ASSERT_EQ(dataSet[i].type_, IptcDataSets::dataSetType(dataSet[i].number_, recordId));
+      ASSERT_EQ(dataSet[i].repeatable_, IptcDataSets::dataSetRepeatable(dataSet[i].number_, recordId));
+    }
+  }
+}
+
+TEST(IptcDataSets, dataSetAcceptsHexNumbersOfUnknownDatasets) {
+  ASSERT_EQ(0x00aa, IptcDataSets::dataSet("0x00aa", IptcDataSets::application2));
+  ASSERT_EQ("0x00aa", IptcDataSets::dataSetName(0x00aa, IptcDataSets::application2));
+}
+
 TEST(IptcDataSets, dataSetThrowWithNonExistingDatasetName) {
   try {
     IptcDataSets::dataSet("NonExistingName", IptcDataSets::envelope);
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <easyaccess.hpp>  // Unit under test
+#include <image.hpp>
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+void expectSameAsIndividualFunctions(const std::string& file) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / file).string());
+  image->readMetadata();
+  const ExifData& ed = image->exifData();
+  ASSERT_FALSE(ed.empty());
+
+  const auto data = easyAccess(ed);
+  EXPECT_EQ(data.orientation, orientation(ed));
+  EXPECT_EQ(data.isoSpeed, isoSpeed(ed));
+  EXPECT_EQ(data.dateTimeOriginal, dateTimeOriginal(ed));
+  EXPECT_EQ(data.flashBias, flashBias(ed));
+  EXPECT_EQ(data.exposureMode, exposureMode(ed));
+  EXPECT_EQ(data.sceneMode, sceneMode(ed));
+  EXPECT_EQ(data.macroMode, macroMode(ed));
+  EXPECT_EQ(data.imageQuality, imageQuality(ed));
+  EXPECT_EQ(data.whiteBalance, whiteBalance(ed));
+  EXPECT_EQ(data.lensName, lensName(ed));
+  EXPECT_EQ(data.saturation, saturation(ed));
+  EXPECT_EQ(data.sharpness, sharpness(ed));
+  EXPECT_EQ(data.contrast, contrast(ed));
+  EXPECT_EQ(data.sceneCaptureType, sceneCaptureType(ed));
+  EXPECT_EQ(data.meteringMode, meteringMode(ed));
+  EXPECT_EQ(data.make, make(ed));
+  EXPECT_EQ(data.model, model(ed));
+  EXPECT_EQ(data.exposureTime, exposureTime(ed));
+  EXPECT_EQ(data.fNumber, fNumber(ed));
+  EXPECT_EQ(data.shutterSpeedValue, shutterSpeedValue(ed));
+  EXPECT_EQ(data.apertureValue, apertureValue(ed));
+  EXPECT_EQ(data.brightnessValue, brightnessValue(ed));
+  EXPECT_EQ(data.exposureBiasValue, exposureBiasValue(ed));
+  EXPECT_EQ(data.maxApertureValue, maxApertureValue(ed));
+  EXPECT_EQ(data.subjectDistance, subjectDistance(ed));
+  EXPECT_EQ(data.lightSource, lightSource(ed));
+  EXPECT_EQ(data.flash, flash(ed));
+  EXPECT_EQ(data.serialNumber, serialNumber(ed));
+  EXPECT_EQ(data.focalLength, focalLength(ed));
+  EXPECT_EQ(data.subjectArea, subjectArea(ed));
+  EXPECT_EQ(data.flashEnergy, flashEnergy(ed));
+  EXPECT_EQ(data.exposureIndex, exposureIndex(ed));
+  EXPECT_EQ(data.sensingMethod, sensingMethod(ed));
+  EXPECT_EQ(data.afPoint, afPoint(ed));
+}
+}  // namespace
+
+TEST(EasyAccess, findsStandardAndMakernoteTags) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / "NikonZ6.exv").string());
+  image->readMetadata();
+  const ExifData& ed = image->exifData();
+
+  auto md = make(ed);
+  ASSERT_NE(md, ed.end());
+  EXPECT_EQ(md->key(), "Exif.Image.Make");
+  md = isoSpeed(ed);
+  ASSERT_NE(md, ed.end());
+  EXPECT_EQ(md->key(), "Exif.Photo.ISOSpeedRatings");
+}
+
+TEST(EasyAccess, batchResolutionMatchesIndividualFunctions) {
+  expectSameAsIndividualFunctions("NikonZ6.exv");
+  expectSameAsIndividualFunctions("exiv2-canon-eos-20d.jpg");
+  expectSameAsIndividualFunctions("exiv2-SonyILCE-7SM3.exv");
+  expectSameAsIndividualFunctions("SonyDSLR-A100.exv");
+}
@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/metadatacache.hpp>  // Unit under test
+#include <exiv2/error.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/iptc.hpp>
+#include <exiv2/scanner.hpp>
+#include <exiv2/tags.hpp>
+#include <exiv2/xmp_exiv2.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+//! Return a path in the temporary directory which is unique to the test
+std::string tempPath(const std::string& suffix) {
+  const auto name = std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + suffix;
+  const auto path = fs::temp_directory_path() / name;
+  fs::remove(path);
+  return path.string();
+}
+
+//! Copy the test image \em name to a temporary file, which the test may modify
+std::string copyOfImage(const std::string& name) {
+  const auto path = tempPath("-" + name);
+  fs::copy_file(fs::path(TESTDATA_PATH) / name, path);
+  return path;
+}
+
+template <typename Data>
+Entries entries(const Data& data) {
+  Entries ret;
+  for (auto&& md : data)
+    ret.emplace_back(md.key(), md.toString());
+  return ret;
+}
+
+Image::UniquePtr readImage(const std::string& path) {
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  return image;
+}
+}  // namespace
+
+TEST(MetadataCache, returnsTheMetadataOfAnUnchangedFile) {
+  const auto cachePath = tempPath(".cache");
+  const auto file = copyOfImage("exiv2-canon-eos-20d.jpg");
+  auto image = readImage(file);
+  ASSERT_FALSE(image->exifData().empty());
+  image->iptcData()["Iptc.Application2.City"] = "Zurich";
+  image->xmpData()["Xmp.dc.subject"] = "Cached";
+  image->setComment("A comment");
+
+  MetadataCache cache(cachePath);
+  EXPECT_EQ(0u, cache.size());
+  cache.write(*image);
+  EXPECT_EQ(1u, cache.size());
+
+  auto cached = ImageFactory::open(file);
+  ASSERT_TRUE(cache.read(*cached));
+  EXPECT_EQ(entries(image->exifData()), entries(cached->exifData()));
+  EXPECT_EQ(entries(image->iptcData()), entries(cached->iptcData()));
+  EXPECT_EQ(entries(image->xmpData()), entries(cached->xmpData()));
+  EXPECT_EQ(image->xmpPacket(), cached->xmpPacket());
+  EXPECT_EQ(image->byteOrder(), cached->byteOrder());
+  EXPECT_EQ("A comment", cached->comment());
+
+  fs::remove(file);
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, returnsTheMetadataOfImagesWithoutComments) {
+  const auto cachePath = tempPath(".cache");
+  MetadataCache cache(cachePath);
+  for (auto&& name : {"exiv2-bug1044.tif", "issue_1791_new.raf"}) {
+    SCOPED_TRACE(name);
+    const auto file = copyOfImage(name);
+    auto image = readImage(file);
+    ASSERT_EQ(amNone, image->checkMode(mdComment));
+    ASSERT_FALSE(image->exifData().empty());
+    cache.write(*image);
+
+    auto cached = ImageFactory::open(file);
+    ASSERT_TRUE(cache.read(*cached));
+    EXPECT_EQ(entries(image->exifData()), entries(cached->exifData()));
+    EXPECT_EQ(entries(image->xmpData()), entries(cached->xmpData()));
+    fs::remove(file);
+  }
+  EXPECT_EQ(2u, cache.size());
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, missesAChangedFile) {
+  const auto cachePath = tempPath(".cache");
+  const auto file = copyOfImage("exiv2-canon-eos-20d.jpg");
+  MetadataCache cache(cachePath);
+  cache.write(*readImage(file));
+
+  auto image = readImage(file);
+  image->exifData()["Exif.Image.Model"] = "Another model";
+  image->writeMetadata();
+  auto reopened = ImageFactory::open(file);
+  EXPECT_FALSE(cache.read(*reopened));
+
+  // A new entry supersedes the old one
+  cache.write(*readImage(file));
+  EXPECT_EQ(1u, cache.size());
+  ASSERT_TRUE(cache.read(*reopened));
+  EXPECT_EQ("Another model", reopened->exifData()["Exif.Image.Model"].toString());
+
+  fs::remove(file);
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, seesTheEntriesOfOtherInstances) {
+  const auto cachePath = tempPath(".cache");
+  const auto file1 = copyOfImage("exiv2-canon-eos-20d.jpg");
+  const auto file2 = copyOfImage("DSC_3079.jpg");
+  MetadataCache writer(cachePath);
+  writer.write(*readImage(file1));
+
+  MetadataCache reader(cachePath);
+  EXPECT_EQ(1u, reader.size());
+  // Entries appended after the reader opened the cache are found too
+  writer.write(*readImage(file2));
+  auto image = ImageFactory::open(file2);
+  ASSERT_TRUE(reader.read(*image));
+  EXPECT_EQ(entries(readImage(file2)->exifData()), entries(image->exifData()));
+  EXPECT_EQ(2u, reader.size());
+
+  fs::remove(file1);
+  fs::remove(file2);
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, skipsDamagedAndIncompleteEntries) {
+  const auto cachePath = tempPath(".cache");
+  const auto file1 = copyOfImage("exiv2-canon-eos-20d.jpg");
+  const auto file2 = copyOfImage("DSC_3079.jpg");
+  size_t firstEnd = 0;
+  {
+    MetadataCache cache(cachePath);
+    cache.write(*readImage(file1));
+    firstEnd = fs::file_size(cachePath);
+    cache.write(*readImage(file2));
+  }
+  {
+    // Damage the payload of the first entry
+    std::fstream f(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(static_cast<std::streamoff>(firstEnd - 10));
+    f.put('\xff');
+  }
+  {
+    // An entry which is still being written
+    std::ofstream f(cachePath, std::ios::app | std::ios::binary);
+    f.write("MDCE\x10\0\0\0", 8);
+  }
+  MetadataCache cache(cachePath);
+  EXPECT_EQ(1u, cache.size());
+  auto image1 = ImageFactory::open(file1);
+  EXPECT_FALSE(cache.read(*image1));
+  auto image2 = ImageFactory::open(file2);
+  EXPECT_TRUE(cache.read(*image2));
+
+  fs::remove(file1);
+  fs::remove(file2);
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, refusesAFileWhichIsNotACache) {
+  const auto file = copyOfImage("DSC_3079.jpg");
+  const auto size = fs::file_size(file);
+  EXPECT_THROW(MetadataCache cache(file), Error);
+  EXPECT_EQ(size, fs::file_size(file));
+  fs::remove(file);
+}
+
+TEST(MetadataCache, isUsedByTheScanner) {
+  const auto cachePath = tempPath(".cache");
+  const std::vector<std::string> files{copyOfImage("exiv2-canon-eos-20d.jpg"), copyOfImage("DSC_3079.jpg")};
+  MetadataCache cache(cachePath);
+  ScanOptions options;
+  options.cache_ = &cache;
+  options.order_ = ScanOrder::input;
+
+  std::vector<Entries> first;
+  MetadataScanner(options).scan(files, [&](ScanResult& result) {
+    ASSERT_TRUE(result.ok()) << result.error_;
+    first.push_back(entries(result.image_->exifData()));
+  });
+  EXPECT_EQ(files.size(), cache.size());
+  const auto cacheSize = fs::file_size(cachePath);
+
+  std::vector<Entries> second;
+  MetadataScanner(options).scan(files, [&](ScanResult& result) {
+    ASSERT_TRUE(result.ok()) << result.error_;
+    second.push_back(entries(result.image_->exifData()));
+  });
+  EXPECT_EQ(first, second);
+  // Nothing was read again
+  EXPECT_EQ(cacheSize, fs::file_size(cachePath));
+
+  for (auto&& file : files)
+    fs::remove(file);
+  fs::remove(cachePath);
+}
+
+TEST(MetadataCache, isNotUsedByTheScannerWithAModifier) {
+  const auto cachePath = tempPath(".cache");
+  const std::vector<std::string> files{copyOfImage("exiv2-canon-eos-20d.jpg")};
+  MetadataCache cache(cachePath);
+  ScanOptions options;
+  options.cache_ = &cache;
+  MetadataScanner(options).scan(files, [](ScanResult& result) { ASSERT_TRUE(result.ok()) << result.error_; });
+  const auto cacheSize = fs::file_size(cachePath);
+
+  MetadataScanner scanner(options);
+  scanner.setModifier([](Image& image) { image.exifData()["Exif.Image.Model"] = "Modified"; });
+  scanner.scan(files, [](ScanResult& result) { ASSERT_TRUE(result.ok()) << result.error_; });
+  EXPECT_EQ(cacheSize, fs::file_size(cachePath));
+
+  // The changed file is read again
+  MetadataScanner(options).scan(files, [](ScanResult& result) {
+    ASSERT_TRUE(result.ok()) << result.error_;
+    EXPECT_EQ("Modified", result.image_->exifData().findKey(ExifKey("Exif.Image.Model"))->toString());
+  });
+  EXPECT_LT(cacheSize, fs::file_size(cachePath));
+
+  for (auto&& file : files)
+    fs::remove(file);
+  fs::remove(cachePath);
+}
@@ -8,11 +8,63 @@
 
 #include <algorithm>
 #include <array>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <string_view>
 
 using namespace Exiv2;
 
+namespace {
+void appendChunk(std::string& png, std::string_view type, std::string_view data) {
+  const auto length = static_cast<uint32_t>(data.size());
+  for (int shift = 24; shift >= 0; shift -= 8)
+    png += static_cast<char>((length >> shift) & 0xff);
+  png += type;
+  png += data;
+  png.append(4, '\0');  // CRC, not checked when reading
+}
+
+//! A 2x3 PNG image with \em idatCount IDAT chunks of \em idatSize bytes followed by a comment
+std::string pngWithCommentAfterImageData(size_t idatCount, size_t idatSize, const std::string& comment) {
+  std::string png("\x89PNG\r\n\x1a\n", 8);
+  appendChunk(png, "IHDR", std::string_view("\0\0\0\x02\0\0\0\x03\x08\x02\0\0\0", 13));
+  for (size_t i = 0; i < idatCount; ++i)
+    appendChunk(png, "IDAT", std::string(idatSize, 'x'));
+  appendChunk(png, "tEXt", std::string("Description", 12) + comment);
+  appendChunk(png, "IEND", "");
+  return png;
+}
+
+//! MemIo which counts the bytes read from it
+class CountingMemIo : public MemIo {
+ public:
+  using MemIo::MemIo;
+
+  DataBuf read(size_t rcount) override {
+    DataBuf buf = MemIo::read(rcount);
+    bytesRead_ += buf.size();
+    return buf;
+  }
+  size_t read(byte* buf, size_t rcount) override {
+    const size_t n = MemIo::read(buf, rcount);
+    bytesRead_ += n;
+    return n;
+  }
+
+  size_t bytesRead_{0};
+};
+
+std::unique_ptr<PngImage> readPng(const std::string& data, bool stopAtImageData = false) {
+  auto png = std::make_unique<PngImage>(
+      std::make_unique<MemIo>(reinterpret_cast<const byte*>(data.data()), data.size()), false);
+  png->setStopAtImageData(stopAtImageData);
+  png->readMetadata();
+  return png;
+}
+}  // namespace
+
 TEST(PngChunk, keyTxtChunkExtractsKeywordCorrectlyInPresenceOfNullChar) {
   // The following data is: '\0\0"AzTXtRaw profile type exif\0\0x'
   const std::array<std::uint8_t, 32> data{0x00, 0x00, 0x22, 0x41, 0x7a, 0x54, 0x58, 0x74, 0x52, 0x61, 0x77,
@@ -45,6 +97,34 @@ TEST(PngChunk, keyTxtChunkThrowsIfSizeIsNotEnough) {
   ASSERT_THROW(Internal::PngChunk::keyTXTChunk(emptyChunk, false), Exiv2::Error);
 }
 
+TEST(PngChunk, zlibDeflateAndInflateRoundTrip) {
+  std::string text;
+  for (int i = 0; i < 20000; ++i)
+    text += std::to_string(i) + ' ';
+  const auto data = reinterpret_cast<const byte*>(text.data());
+
+  for (int level : {-1, 0, 1, 9}) {
+    DataBuf compressed;
+    ASSERT_TRUE(Internal::PngChunk::zlibDeflate(data, text.size(), compressed, level));
+    DataBuf inflated;
+    ASSERT_TRUE(Internal::PngChunk::zlibInflate(compressed.c_data(), compressed.size(), inflated, text.size()));
+    ASSERT_EQ(0, inflated.cmpBytes(0, text.data(), text.size()));
+    ASSERT_EQ(text.size(), inflated.size());
+  }
+}
+
+TEST(PngChunk, zlibInflateRejectsOversizedAndTruncatedStreams) {
+  const std::string text(100000, 'a');
+  DataBuf compressed;
+  ASSERT_TRUE(Internal::PngChunk::zlibDeflate(reinterpret_cast<const byte*>(text.data()), text.size(), compressed, 9));
+
+  DataBuf inflated;
+  ASSERT_FALSE(Internal::PngChunk::zlibInflate(compressed.c_data(), compressed.size(), inflated, text.size() - 1));
+  ASSERT_TRUE(inflated.empty());
+  ASSERT_FALSE(Internal::PngChunk::zlibInflate(compressed.c_data(), compressed.size() - 5, inflated, text.size()));
+  ASSERT_TRUE(inflated.empty());
+}
+
 TEST(PngImage, canBeCreatedFromScratch) {
   auto memIo = std::make_unique<MemIo>();
   const bool create{true};
@@ -114,6 +194,90 @@ TEST(PngImage, cannotReadMetadataFromIoWhichCannotBeOpened) {
   }
 }
 
+TEST(PngImage, readsMetadataAfterManySmallImageDataChunks) {
+  auto png = readPng(pngWithCommentAfterImageData(20000, 16, "after the image"));
+  ASSERT_EQ(2u, png->pixelWidth());
+  ASSERT_EQ(3u, png->pixelHeight());
+  ASSERT_EQ("after the image", png->comment());
+}
+
+TEST(PngImage, readsChunksLargerThanTheScanBlock) {
+  const std::string comment(100000, 'c');
+  auto png = readPng(pngWithCommentAfterImageData(3, 200000, comment));
+  ASSERT_EQ(comment, png->comment());
+}
+
+TEST(PngImage, readsChunksLargerThanTheScanBlockOnlyOnce) {
+  const std::string comment(300000, 'c');
+  const std::string data = pngWithCommentAfterImageData(1, 16, comment);
+  auto io = std::make_unique<CountingMemIo>(reinterpret_cast<const byte*>(data.data()), data.size());
+  const auto& counter = *io;
+  PngImage png(std::move(io), false);
+  png.readMetadata();
+  ASSERT_EQ(comment, png.comment());
+  ASSERT_LE(counter.bytesRead_, data.size());
+}
+
+TEST(PngImage, stopsAtTheImageDataOnRequest) {
+  auto png = readPng(pngWithCommentAfterImageData(20000, 16, "after the image"), true);
+  ASSERT_TRUE(png->stopAtImageData());
+  ASSERT_EQ(2u, png->pixelWidth());
+  ASSERT_TRUE(png->comment().empty());
+}
+
+TEST(PngImage, refusesToWriteAfterStoppingAtTheImageData) {
+  const std::string data = pngWithCommentAfterImageData(2, 16, "after the image");
+  auto png = readPng(data, true);
+  ASSERT_THROW(png->writeMetadata(), Exiv2::Error);
+  // A complete read makes the image writable again
+  png->setStopAtImageData(false);
+  png->readMetadata();
+  ASSERT_EQ("after the image", png->comment());
+  ASSERT_NO_THROW(png->writeMetadata());
+}
+
+TEST(PngImage, cannotReadMetadataFromTruncatedChunks) {
+  const std::string data = pngWithCommentAfterImageData(100, 16, "after the image");
+  ASSERT_THROW(readPng(data.substr(0, data.size() - 30)), Exiv2::Error);
+  ASSERT_THROW(readPng(data.substr(0, data.size() - 12)), Exiv2::Error);
+}
+
+TEST(PngImage, writesCompressedChunksWithTheChosenLevel) {
+  std::string comment;
+  for (int i = 0; i < 5000; ++i)
+    comment += std::to_string(i * 7) + ' ';
+
+  std::map<int, size_t> sizes;
+  for (int level : {-1, 0, 1, 9}) {
+    PngImage png(std::make_unique<MemIo>(), true);
+    png.setCompressionLevel(level);
+    ASSERT_EQ(level, png.compressionLevel());
+    png.setComment(comment);
+    png.writeMetadata();
+
+    auto& io = png.io();
+    ASSERT_EQ(0, io.open());
+    const DataBuf written = io.read(io.size());
+    io.close();
+    sizes[level] = written.size();
+
+    auto reread = readPng(std::string(written.c_str(), written.size()));
+    ASSERT_EQ(comment, reread->comment());
+  }
+  ASSERT_GT(sizes[0], comment.size());
+  ASSERT_LT(sizes[1], sizes[0]);
+  ASSERT_LT(sizes[9], sizes[0]);
+  ASSERT_EQ(sizes[9], sizes[-1]);
+}
+
+TEST(PngImage, rejectsAnInvalidCompressionLevel) {
+  PngImage png(std::make_unique<MemIo>(), true);
+  ASSERT_EQ(-1, png.compressionLevel());
+  ASSERT_THROW(png.setCompressionLevel(10), Error);
+  ASSERT_THROW(png.setCompressionLevel(-2), Error);
+  ASSERT_EQ(-1, png.compressionLevel());
+}
+
 TEST(PngImage, cannotWriteMetadataToEmptyIo) {
   auto memIo = std::make_unique<MemIo>();
   const bool create{false};
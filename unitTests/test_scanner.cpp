@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/scanner.hpp>  // Unit under test
+#include <exiv2/basicio.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/tags.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+const char* const images[] = {
+    "exiv2-canon-eos-20d.jpg", "DSC_3079.jpg", "Reagan.jpg", "FurnaceCreekInn.jpg", "exiv2-bug1026.jpg", "NikonZ6.exv",
+};
+
+std::vector<std::string> imagePaths() {
+  std::vector<std::string> ret;
+  for (auto name : images)
+    ret.push_back((fs::path(TESTDATA_PATH) / name).string());
+  return ret;
+}
+
+//! Return the Exif model of \em path, read without the scanner
+std::string model(const std::string& path) {
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  auto pos = image->exifData().findKey(ExifKey("Exif.Image.Model"));
+  return pos == image->exifData().end() ? "" : pos->toString();
+}
+
+std::string modelOf(const ScanResult& result) {
+  auto pos = result.image_->exifData().findKey(ExifKey("Exif.Image.Model"));
+  return pos == result.image_->exifData().end() ? "" : pos->toString();
+}
+}  // namespace
+
+TEST(MetadataScanner, deliversResultsInInputOrder) {
+  auto paths = imagePaths();
+  paths.insert(paths.begin() + 2, (fs::path(TESTDATA_PATH) / "no-such-file.jpg").string());
+  paths.insert(paths.begin() + 4, (fs::path(TESTDATA_PATH) / "COPYRIGHT").string());
+
+  ScanOptions options;
+  options.threads_ = 3;
+  options.order_ = ScanOrder::input;
+  std::vector<size_t> order;
+  const size_t failed = MetadataScanner(options).scan(paths, [&](ScanResult& result) {
+    order.push_back(result.index_);
+    ASSERT_EQ(paths.at(result.index_), result.path_);
+    if (result.index_ == 2 || result.index_ == 4) {
+      EXPECT_FALSE(result.ok());
+      EXPECT_FALSE(result.error_.empty());
+      EXPECT_EQ(nullptr, result.image_);
+    } else {
+      ASSERT_TRUE(result.ok()) << result.error_;
+      EXPECT_EQ(model(result.path_), modelOf(result));
+    }
+  });
+  EXPECT_EQ(2u, failed);
+  ASSERT_EQ(paths.size(), order.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    EXPECT_EQ(i, order[i]);
+}
+
+TEST(MetadataScanner, boundsThePendingFiles) {
+  const auto paths = imagePaths();
+  for (auto order : {ScanOrder::completion, ScanOrder::input}) {
+    ScanOptions options;
+    options.threads_ = 2;
+    options.maxPending_ = 2;
+    options.order_ = order;
+    size_t claimed = 0;
+    size_t delivered = 0;
+    std::vector<bool> seen(paths.size());
+    auto next = [&](std::string& path) {
+      if (claimed == paths.size())
+        return false;
+      path = paths[claimed++];
+      return true;
+    };
+    MetadataScanner(options).scan(next, [&](ScanResult& result) {
+      // The source is called by the workers, but only while fewer than two files are pending
+      EXPECT_LE(claimed - delivered, 2u);
+      EXPECT_TRUE(result.ok()) << result.error_;
+      seen.at(result.index_) = true;
+      ++delivered;
+    });
+    EXPECT_EQ(paths.size(), delivered);
+    EXPECT_EQ(std::vector<bool>(paths.size(), true), seen);
+  }
+}
+
+TEST(MetadataScanner, readsTheSameWithPrefetching) {
+  auto paths = imagePaths();
+  paths.push_back((fs::path(TESTDATA_PATH) / "no-such-file.jpg").string());
+  paths.push_back((fs::path(TESTDATA_PATH) / "COPYRIGHT").string());
+
+  ScanOptions options;
+  options.threads_ = 2;
+  options.order_ = ScanOrder::input;
+  options.prefetchSize_ = 4096;
+  std::vector<FileIo::Backend> backends{FileIo::Backend::stdio};
+#ifndef _WIN32
+  backends.push_back(FileIo::Backend::positional);
+#endif
+  for (auto backend : backends) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    FileIo::setDefaultBackend(backend);
+    std::vector<ErrorCode> errors;
+    const size_t failed = MetadataScanner(options).scan(paths, [&](ScanResult& result) {
+      errors.push_back(result.errorCode_);
+      if (result.ok()) {
+        EXPECT_EQ(model(result.path_), modelOf(result)) << result.path_;
+      }
+    });
+    EXPECT_EQ(2u, failed);
+    ASSERT_EQ(paths.size(), errors.size());
+    EXPECT_EQ(ErrorCode::kerDataSourceOpenFailed, errors.at(paths.size() - 2));
+    EXPECT_EQ(ErrorCode::kerFileContainsUnknownImageType, errors.at(paths.size() - 1));
+  }
+  FileIo::setDefaultBackend(FileIo::Backend::stdio);
+}
+
+TEST(MetadataScanner, rethrowsAnExceptionOfTheCallback) {
+  ScanOptions options;
+  options.threads_ = 2;
+  size_t calls = 0;
+  EXPECT_THROW(MetadataScanner(options).scan(imagePaths(),
+                                             [&](ScanResult&) {
+                                               ++calls;
+                                               throw std::runtime_error("stop");
+                                             }),
+               std::runtime_error);
+  EXPECT_EQ(1u, calls);
+}
+
+TEST(MetadataScanner, writesTheModifiedMetadata) {
+  const auto path = fs::temp_directory_path() / "MetadataScanner_writesTheModifiedMetadata.jpg";
+  fs::copy_file(fs::path(TESTDATA_PATH) / "exiv2-canon-eos-20d.jpg", path, fs::copy_options::overwrite_existing);
+
+  MetadataScanner scanner;
+  scanner.setModifier([](Image& image) { image.exifData()["Exif.Image.Model"] = "Scanned model"; });
+  const size_t failed = scanner.scan(std::vector<std::string>{path.string()}, [](ScanResult& result) {
+    EXPECT_TRUE(result.ok()) << result.error_;
+  });
+  EXPECT_EQ(0u, failed);
+  EXPECT_EQ("Scanned model", model(path.string()));
+  fs::remove(path);
+}
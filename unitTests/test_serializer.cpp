@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <exiv2/serializer.hpp>  // Unit under test
+#include <exiv2/error.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/properties.hpp>
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+using Entries = std::vector<std::tuple<std::string, TypeId, size_t, std::string>>;
+
+template <typename Data>
+Entries entries(const Data& data) {
+  Entries ret;
+  for (auto&& md : data)
+    ret.emplace_back(md.key(), md.typeId(), md.count(), md.toString());
+  return ret;
+}
+
+//! Serialize the metadata of \em image and return the decoded result
+struct Decoded {
+  explicit Decoded(const Image& image) {
+    MetadataSerializer::encode(blob_, image.exifData(), image.iptcData(), image.xmpData(), bigEndian);
+    byteOrder_ = MetadataSerializer::decode(exifData_, iptcData_, xmpData_, blob_.data(), blob_.size());
+  }
+
+  Blob blob_;
+  ByteOrder byteOrder_;
+  ExifData exifData_;
+  IptcData iptcData_;
+  XmpData xmpData_;
+};
+
+Image::UniquePtr readImage(const std::string& name) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / name).string());
+  image->readMetadata();
+  return image;
+}
+}  // namespace
+
+TEST(MetadataSerializer, roundTripsTheMetadataOfTheTestImages) {
+  size_t images = 0;
+  for (auto&& file : fs::directory_iterator(TESTDATA_PATH)) {
+    Image::UniquePtr image;
+    try {
+      image = ImageFactory::open(file.path().string());
+      image->readMetadata();
+    } catch (const std::exception&) {
+      continue;
+    }
+    if (image->exifData().empty() && image->iptcData().empty() && image->xmpData().empty())
+      continue;
+    ++images;
+    SCOPED_TRACE(file.path().filename().string());
+
+    const Decoded decoded(*image);
+    EXPECT_EQ(bigEndian, decoded.byteOrder_);
+    EXPECT_EQ(entries(image->exifData()), entries(decoded.exifData_));
+    EXPECT_EQ(entries(image->iptcData()), entries(decoded.iptcData_));
+    EXPECT_EQ(entries(image->xmpData()), entries(decoded.xmpData_));
+    // Data areas and indices are kept too
+    auto pos = decoded.exifData_.begin();
+    for (auto&& md : image->exifData()) {
+      EXPECT_EQ(md.idx(), pos->idx()) << md.key();
+      EXPECT_EQ(md.dataArea().size(), pos->dataArea().size()) << md.key();
+      ++pos;
+    }
+  }
+  EXPECT_GT(images, 100u);
+}
+
+TEST(MetadataSerializer, keepsTheThumbnail) {
+  auto image = readImage("exiv2-canon-eos-20d.jpg");
+  const Decoded decoded(*image);
+  const DataBuf thumbnail = ExifThumbC(image->exifData()).copy();
+  ASSERT_FALSE(thumbnail.empty());
+  const DataBuf copy = ExifThumbC(decoded.exifData_).copy();
+  ASSERT_EQ(thumbnail.size(), copy.size());
+  EXPECT_EQ(0, thumbnail.cmpBytes(0, copy.c_data(), copy.size()));
+}
+
+TEST(MetadataSerializer, keepsTheMakerNoteOfALazilyDecodedImage) {
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / "exiv2-canon-eos-20d.jpg").string());
+  image->setMakerNotePolicy(MakerNotePolicy::lazy);
+  image->readMetadata();
+  const Decoded decoded(*image);
+  EXPECT_NE(decoded.exifData_.end(), decoded.exifData_.findKey(ExifKey("Exif.Canon.ModelID")));
+  EXPECT_EQ(entries(readImage("exiv2-canon-eos-20d.jpg")->exifData()), entries(decoded.exifData_));
+}
+
+TEST(MetadataSerializer, viewsTheEntriesWithoutCopying) {
+  auto image = readImage("exiv2-canon-eos-20d.jpg");
+  image->iptcData()["Iptc.Application2.City"] = "Zurich";
+  image->xmpData()["Xmp.dc.subject"] = "Landscape";
+  Blob blob;
+  MetadataSerializer::encode(blob, image->exifData(), image->iptcData(), image->xmpData());
+  const MetadataView view(blob.data(), blob.size());
+  EXPECT_EQ(littleEndian, view.byteOrder());
+  ASSERT_EQ(image->exifData().count(), view.exifData().size());
+  ASSERT_EQ(1u, view.iptcData().size());
+  ASSERT_EQ(1u, view.xmpData().size());
+
+  const auto isInBlob = [&](const byte* p, size_t size) {
+    return p >= blob.data() && p + size <= blob.data() + blob.size();
+  };
+  for (auto&& entry : view.exifData()) {
+    EXPECT_TRUE(isInBlob(entry.data_, entry.size_));
+    if (entry.key().key() == "Exif.Image.Model") {
+      EXPECT_EQ("Canon EOS 20D", entry.value()->toString());
+      EXPECT_EQ(asciiString, entry.typeId_);
+    }
+  }
+  const auto& city = view.iptcData().front();
+  EXPECT_TRUE(isInBlob(city.data_, city.size_));
+  EXPECT_EQ("Iptc.Application2.City", city.key().key());
+  EXPECT_EQ("Zurich", std::string(reinterpret_cast<const char*>(city.data_), city.size_));
+  const auto& subject = view.xmpData().front();
+  EXPECT_EQ("dc", subject.prefix_);
+  EXPECT_EQ("subject", subject.property_);
+  EXPECT_EQ(xmpBag, subject.typeId_);
+  EXPECT_EQ("Landscape", subject.value()->toString(0));
+}
+
+TEST(MetadataSerializer, registersUnknownXmpNamespaces) {
+  const std::string ns = "http://example.com/serializer/";
+  XmpProperties::registerNs(ns, "serializer");
+  XmpData xmpData;
+  xmpData["Xmp.serializer.Title"] = "Title";
+  LangAltValue langAlt("lang=de-DE Titel");
+  langAlt.read("Title");
+  xmpData.add(XmpKey("Xmp.serializer.Alt"), &langAlt);
+  XmpTextValue bag;
+  bag.setXmpArrayType(XmpValue::xaBag);
+  xmpData.add(XmpKey("Xmp.serializer.EmptyBag"), &bag);
+  Blob blob;
+  MetadataSerializer::encode(blob, ExifData(), IptcData(), xmpData);
+  XmpProperties::unregisterNs(ns);
+
+  ExifData exifData;
+  IptcData iptcData;
+  XmpData decoded;
+  MetadataSerializer::decode(exifData, iptcData, decoded, blob.data(), blob.size());
+  EXPECT_EQ("serializer", XmpProperties::prefix(ns));
+  EXPECT_EQ(entries(xmpData), entries(decoded));
+  EXPECT_EQ(XmpValue::xaBag, dynamic_cast<const XmpValue&>(decoded["Xmp.serializer.EmptyBag"].value()).xmpArrayType());
+  EXPECT_EQ("Titel", dynamic_cast<const LangAltValue&>(decoded["Xmp.serializer.Alt"].value()).toString("de-DE"));
+
+  // A namespace known under another prefix keeps that prefix
+  XmpProperties::unregisterNs(ns);
+  XmpProperties::registerNs(ns, "serializer2");
+  MetadataSerializer::decode(exifData, iptcData, decoded, blob.data(), blob.size());
+  ASSERT_EQ(3u, decoded.count());
+  EXPECT_EQ("Xmp.serializer2.Title", decoded.begin()->key());
+  XmpProperties::unregisterNs(ns);
+}
+
+TEST(MetadataSerializer, rejectsDamagedData) {
+  auto image = readImage("exiv2-canon-eos-20d.jpg");
+  image->xmpData()["Xmp.dc.title"] = "lang=en-US Title";
+  Blob blob;
+  MetadataSerializer::encode(blob, image->exifData(), image->iptcData(), image->xmpData());
+  ExifData exifData;
+  IptcData iptcData;
+  XmpData xmpData;
+  for (size_t size = 0; size < blob.size(); ++size)
+    EXPECT_THROW(MetadataSerializer::decode(exifData, iptcData, xmpData, blob.data(), size), Error) << size;
+  blob[0] = 'X';
+  EXPECT_THROW(MetadataView(blob.data(), blob.size()), Error);
+}
+
+TEST(MetadataSerializer, rejectsInvalidIdsAndNames) {
+  ExifData exifData;
+  exifData["Exif.Image.Model"] = "Model";
+  IptcData iptcData;
+  XmpData xmpData;
+  Blob blob;
+  MetadataSerializer::encode(blob, exifData, iptcData, xmpData);
+  // The IFD id of the first Exif entry follows the header, the byte order and the number of entries
+  const size_t ifdPos = 16;
+  ASSERT_EQ(static_cast<byte>(IfdId::ifd0Id), blob.at(ifdPos));
+  blob[ifdPos] = static_cast<byte>(IfdId::ifdIdNotSet);
+  EXPECT_THROW(MetadataView(blob.data(), blob.size()), Error);
+  blob[ifdPos] = 0xff;
+  blob[ifdPos + 1] = 0xff;
+  EXPECT_THROW(MetadataView(blob.data(), blob.size()), Error);
+
+  // No Exif and IPTC entries, an XMP namespace with an empty name and no XMP entries
+  const std::vector<byte> emptyNs{'E', 'x', 'i', 'v', '2', 'M', 'D', 'B', 1, 0, 'I', 'I', 0, 0, 0, 0, 0, 0, 0, 0,
+                                  1,   0,   0,   0,   1,   0,   0,   0,   'p', 0, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_THROW(MetadataView(emptyNs.data(), emptyNs.size()), Error);
+}
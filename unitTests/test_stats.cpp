@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stats.hpp>  // Unit under test
+#include <basicio.hpp>
+#include <image.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+TEST(Stats, resetClearsAllCounters) {
+  Stats stats;
+  stats.phase(StatsPhase::tiffParse).calls_ = 3;
+  stats.phase(StatsPhase::tiffParse).time_ = std::chrono::nanoseconds(42);
+  stats.reads_ = 1;
+  stats.mmaps_ = 2;
+  stats.reset();
+  EXPECT_EQ(0u, stats.phase(StatsPhase::tiffParse).calls_);
+  EXPECT_EQ(0, stats.phase(StatsPhase::tiffParse).time_.count());
+  EXPECT_EQ(0u, stats.reads_);
+  EXPECT_EQ(0u, stats.mmaps_);
+}
+
+TEST(Stats, phasesHaveNames) {
+  EXPECT_STREQ("typeDetection", statsPhaseName(StatsPhase::typeDetection));
+  EXPECT_STREQ("makerNoteDecode", statsPhaseName(StatsPhase::makerNoteDecode));
+  EXPECT_STREQ("transfer", statsPhaseName(StatsPhase::transfer));
+}
+
+TEST(Stats, countsMemIoAccess) {
+  const byte data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  MemIo io(data, sizeof(data));
+  threadStats().reset();
+  byte buf[4];
+  io.read(buf, sizeof(buf));
+  io.getb();
+  io.seek(0, BasicIo::beg);
+  io.mmap();
+
+  const Stats& stats = threadStats();
+  const uint64_t expected = statsEnabled() ? 1 : 0;
+  EXPECT_EQ(2 * expected, stats.reads_);
+  EXPECT_EQ(5 * expected, stats.bytesRead_);
+  EXPECT_EQ(expected, stats.seeks_);
+  EXPECT_EQ(expected, stats.mmaps_);
+  EXPECT_EQ(0u, stats.writes_);
+}
+
+TEST(Stats, timesThePhasesOfReadMetadata) {
+  threadStats().reset();
+  auto image = ImageFactory::open((fs::path(TESTDATA_PATH) / "exiv2-canon-eos-20d.jpg").string());
+  image->readMetadata();
+
+  const Stats& stats = threadStats();
+  if (!statsEnabled()) {
+    EXPECT_EQ(0u, stats.phase(StatsPhase::typeDetection).calls_);
+    EXPECT_EQ(0u, stats.reads_);
+    return;
+  }
+  EXPECT_EQ(1u, stats.phase(StatsPhase::typeDetection).calls_);
+  EXPECT_EQ(1u, stats.phase(StatsPhase::segmentScan).calls_);
+  EXPECT_EQ(1u, stats.phase(StatsPhase::tiffParse).calls_);
+  EXPECT_LT(0u, stats.phase(StatsPhase::makerNoteDecode).calls_);
+  EXPECT_EQ(0u, stats.phase(StatsPhase::encode).calls_);
+  EXPECT_LT(0u, stats.reads_);
+  EXPECT_LT(0u, stats.bytesRead_);
+}
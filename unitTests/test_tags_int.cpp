@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <tags_int.hpp>  // Unit under test
+#include <value.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Exiv2;
+using namespace Exiv2::Internal;
+
+namespace {
+// Unsorted, with duplicate values and more entries than are searched linearly
+constexpr TagDetails largeTable[] = {
+    {40, "forty"}, {3, "three"}, {-7, "minus seven"}, {12, "twelve"}, {3, "three again"},
+    {99, "ninety-nine"}, {0, "zero"}, {21, "twenty-one"}, {8, "eight"}, {1000, "thousand"},
+    {5, "five"}, {-7, "minus seven again"}, {64, "sixty-four"}, {2, "two"}, {17, "seventeen"},
+    {33, "thirty-three"}, {7, "seven"}, {40, "forty again"}, {11, "eleven"}, {6, "six"},
+};
+
+constexpr TagDetails smallTable[] = {
+    {2, "two"},
+    {1, "one"},
+    {2, "two again"},
+};
+
+constexpr StringTagDetails stringTable[] = {
+    {"m", "m"}, {"b", "b"}, {"x", "x"}, {"a", "a"}, {"k", "k"}, {"b", "b again"}, {"q", "q"},
+    {"c", "c"}, {"z", "z"}, {"e", "e"}, {"f", "f"}, {"g", "g"}, {"h", "h"}, {"i", "i"},
+    {"j", "j"}, {"l", "l"}, {"n", "n"}, {"o", "o"}, {"0 1", "0 1"},
+};
+
+template <typename T>
+std::string print(std::ostream& (*fct)(std::ostream&, const T&, const ExifData*), const T& value) {
+  std::ostringstream os;
+  fct(os, value, nullptr);
+  return os.str();
+}
+}  // namespace
+
+TEST(tagDetailsLookup, indexIsSortedByValueAndPosition) {
+  const auto& index = lookupIndex<largeTable>;
+  ASSERT_EQ(std::size(largeTable), index.size());
+  for (size_t i = 1; i < index.size(); ++i) {
+    const auto& prev = largeTable[index[i - 1]];
+    const auto& cur = largeTable[index[i]];
+    EXPECT_TRUE(prev.val_ < cur.val_ || (prev.val_ == cur.val_ && index[i - 1] < index[i]));
+  }
+}
+
+TEST(tagDetailsLookup, findsTheSameEntryAsALinearSearch) {
+  for (int64_t key = -10; key <= 1001; ++key) {
+    EXPECT_EQ(Exiv2::find(largeTable, key), findDetails<largeTable>(key)) << key;
+    EXPECT_EQ(Exiv2::find(smallTable, key), findDetails<smallTable>(key)) << key;
+  }
+  EXPECT_STREQ("three", findDetails<largeTable>(int64_t{3})->label_);
+  EXPECT_STREQ("minus seven", findDetails<largeTable>(int64_t{-7})->label_);
+  EXPECT_STREQ("two", findDetails<smallTable>(int64_t{2})->label_);
+}
+
+TEST(tagDetailsLookup, findsStringValues) {
+  for (const auto& td : stringTable)
+    EXPECT_EQ(Exiv2::find(stringTable, td.val_), findDetails<stringTable>(td.val_));
+  EXPECT_STREQ("b", findDetails<stringTable>(std::string_view("b"))->label_);
+  EXPECT_EQ(nullptr, findDetails<stringTable>(std::string_view("d")));
+  EXPECT_EQ(nullptr, findDetails<stringTable>(std::string_view("")));
+}
+
+TEST(tagDetailsLookup, printTemplatesUseTheLookup) {
+  UShortValue value;
+  value.read("40");
+  EXPECT_EQ("forty", print<Value>(EXV_PRINT_TAG(largeTable), value));
+  value.read("41");
+  EXPECT_EQ("(41)", print<Value>(EXV_PRINT_TAG(largeTable), value));
+  EXPECT_EQ("41", print<Value>(EXV_PRINT_TAG_NO_ERROR(largeTable), value));
+
+  AsciiValue text("x");
+  EXPECT_EQ("x", print<Value>(EXV_PRINT_STRING_TAG_1(stringTable), text));
+  text.read("y");
+  EXPECT_EQ("(y)", print<Value>(EXV_PRINT_STRING_TAG_1(stringTable), text));
+  UShortValue pair;
+  pair.read("0 1");
+  EXPECT_EQ("0 1", print<Value>(EXV_PRINT_STRING_TAG_2(stringTable), pair));
+}
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <tiffcomposite_int.hpp>  // Unit under test
+#include <basicio.hpp>
+#include <exif.hpp>
+#include <futils.hpp>
+#include <image.hpp>
+#include <iptc.hpp>
+#include <tags.hpp>
+#include <tiffimage.hpp>
+#include <value.hpp>
+#include <xmp_exiv2.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+using namespace Exiv2::Internal;
+
+namespace {
+std::unique_ptr<Value> asciiValue(const std::string& str) {
+  auto value = Value::create(asciiString);
+  value->read(str);
+  return value;
+}
+}  // namespace
+
+class ATiffLayout : public ::testing::Test {
+ public:
+  ATiffLayout() : ifd0(0, IfdId::ifd0Id) {
+    auto entry = std::make_shared<TiffEntry>(0x010e, IfdId::ifd0Id, ttAsciiString);
+    entry->updateValue(asciiValue("An image description"), littleEndian);
+    description = entry.get();
+    ifd0.addChild(std::move(entry));
+    auto software = std::make_shared<TiffEntry>(0x0131, IfdId::ifd0Id, ttAsciiString);
+    software->updateValue(asciiValue("abc"), littleEndian);
+    ifd0.addChild(std::move(software));
+  }
+
+  TiffDirectory ifd0;
+  TiffEntry* description;
+};
+
+TEST_F(ATiffLayout, isNotActiveByDefault) {
+  ASSERT_EQ(0U, TiffLayout::epoch());
+}
+
+TEST_F(ATiffLayout, computesTheSameSizesAsWithoutLayout) {
+  const auto size = ifd0.size();
+  const auto sizeData = ifd0.sizeData();
+  const auto sizeImage = ifd0.sizeImage();
+  TiffLayout layout(ifd0);
+  ASSERT_NE(0U, TiffLayout::epoch());
+  ASSERT_EQ(size, ifd0.size());
+  ASSERT_EQ(sizeData, ifd0.sizeData());
+  ASSERT_EQ(sizeImage, ifd0.sizeImage());
+  // 2 + 2 * 12 + 4 bytes for the directory, 22 bytes for the description value
+  ASSERT_EQ(52U, size);
+}
+
+TEST_F(ATiffLayout, restoresThePreviousLayoutWhenNested) {
+  TiffLayout outer(ifd0);
+  const auto epoch = TiffLayout::epoch();
+  {
+    TiffLayout inner(ifd0);
+    ASSERT_NE(epoch, TiffLayout::epoch());
+  }
+  ASSERT_EQ(epoch, TiffLayout::epoch());
+}
+
+TEST_F(ATiffLayout, doesNotKeepSizesBeyondItsScope) {
+  { TiffLayout layout(ifd0); }
+  ASSERT_EQ(0U, TiffLayout::epoch());
+  description->updateValue(asciiValue("A longer image description"), littleEndian);
+  const auto size = ifd0.size();
+  ASSERT_EQ(58U, size);
+  TiffLayout layout(ifd0);
+  ASSERT_EQ(size, ifd0.size());
+}
+
+namespace {
+//! Apply the same edit to an image read from \em file in a file and in memory and return both results
+std::pair<DataBuf, DataBuf> writeInFileAndMemory(const std::string& file, void (*edit)(Image&)) {
+  const auto path = (fs::path(TESTDATA_PATH) / file).string();
+  const auto copy = fs::path("tiffcomposite_" + file);
+  fs::copy_file(path, copy, fs::copy_options::overwrite_existing);
+
+  auto inFile = ImageFactory::open(copy.string());
+  inFile->readMetadata();
+  edit(*inFile);
+  inFile->writeMetadata();
+
+  const DataBuf data = readFile(path);
+  auto inMemory = ImageFactory::open(data.c_data(), data.size());
+  inMemory->readMetadata();
+  edit(*inMemory);
+  inMemory->writeMetadata();
+  auto& io = inMemory->io();
+  io.open();
+  DataBuf expected = io.read(io.size());
+
+  DataBuf written = readFile(copy.string());
+  fs::remove(copy);
+  return {std::move(expected), std::move(written)};
+}
+
+void growMetadata(Image& image) {
+  image.exifData()["Exif.Image.ImageDescription"] = std::string(10000, 'x');
+  image.exifData()["Exif.Photo.UserComment"] = "charset=Ascii A spliced write";
+}
+
+void shrinkMetadata(Image& image) {
+  image.exifData().erase(image.exifData().findKey(ExifKey("Exif.Image.ImageDescription")));
+  image.xmpData().clear();
+  image.iptcData().clear();
+}
+}  // namespace
+
+TEST(ASplicedTiffWrite, writesTheSameFileAsAWriteInMemoryWhenTheImageDataMovesToTheEnd) {
+  for (auto&& file : {"Reagan.tiff", "exiv2-bug1044.tif"}) {
+    auto [expected, written] = writeInFileAndMemory(file, growMetadata);
+    ASSERT_EQ(expected.size(), written.size()) << file;
+    ASSERT_EQ(0, expected.cmpBytes(0, written.c_data(), written.size())) << file;
+  }
+}
+
+TEST(ASplicedTiffWrite, writesTheSameFileAsAWriteInMemoryWhenTheImageDataMovesToTheStart) {
+  for (auto&& file : {"Reagan.tiff", "exiv2-bug1044.tif"}) {
+    auto [expected, written] = writeInFileAndMemory(file, shrinkMetadata);
+    ASSERT_EQ(expected.size(), written.size()) << file;
+    ASSERT_EQ(0, expected.cmpBytes(0, written.c_data(), written.size())) << file;
+  }
+}
+
+TEST(ASplicedTiffWrite, keepsHardLinks) {
+  const auto copy = fs::path("tiffcomposite_link.tiff");
+  const auto link = fs::path("tiffcomposite_link2.tiff");
+  fs::copy_file(fs::path(TESTDATA_PATH) / "Reagan.tiff", copy, fs::copy_options::overwrite_existing);
+  fs::remove(link);
+  fs::create_hard_link(copy, link);
+
+  auto image = ImageFactory::open(copy.string());
+  image->readMetadata();
+  growMetadata(*image);
+  image->writeMetadata();
+
+  EXPECT_EQ(2U, fs::hard_link_count(copy));
+  EXPECT_TRUE(fs::equivalent(copy, link));
+  fs::remove(link);
+  fs::remove(copy);
+}
+
+TEST(ASplicedTiffWrite, isNotUsedToEncodeIntoAnotherFile) {
+  const DataBuf data = readFile((fs::path(TESTDATA_PATH) / "Reagan.tiff").string());
+  auto image = ImageFactory::open(data.c_data(), data.size());
+  image->readMetadata();
+  growMetadata(*image);
+  image->writeMetadata();
+  auto& memIo = image->io();
+  memIo.open();
+  const DataBuf expected = memIo.read(memIo.size());
+
+  // The source data is not the content of the destination file
+  const auto target = fs::path("tiffcomposite_target.tiff");
+  fs::remove(target);
+  FileIo io(target.string());
+  DataBuf source(data.c_data(), data.size());
+  EXPECT_EQ(wmIntrusive, TiffParser::encode(io, source.c_data(), source.size(), image->byteOrder(), image->exifData(),
+                                            image->iptcData(), image->xmpData()));
+  const DataBuf written = readFile(target.string());
+  fs::remove(target);
+  ASSERT_EQ(expected.size(), written.size());
+  ASSERT_EQ(0, expected.cmpBytes(0, written.c_data(), written.size()));
+}
@@ -1,13 +1,16 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <exiv2/types.hpp>
+#include <exiv2/value.hpp>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 using namespace Exiv2;
 
@@ -244,3 +247,64 @@ TEST(parseUint32, withNumberOutOfRangeReturnsFalse) {
   ASSERT_EQ(0u, parseUint32("4333333333", ok));
   ASSERT_FALSE(ok);
 }
+
+TEST(convertByteOrder, readsValuesLikeTheScalarFunctions) {
+  std::array<byte, 40> buf;
+  std::iota(buf.begin(), buf.end(), byte{1});
+  for (auto byteOrder : {littleEndian, bigEndian}) {
+    std::array<uint16_t, 20> us;
+    convertByteOrder(reinterpret_cast<byte*>(us.data()), buf.data(), us.size(), 2, byteOrder);
+    for (size_t i = 0; i < us.size(); ++i)
+      ASSERT_EQ(getUShort(buf.data() + (2 * i), byteOrder), us[i]);
+    std::array<uint32_t, 10> ul;
+    convertByteOrder(reinterpret_cast<byte*>(ul.data()), buf.data(), ul.size(), 4, byteOrder);
+    for (size_t i = 0; i < ul.size(); ++i)
+      ASSERT_EQ(getULong(buf.data() + (4 * i), byteOrder), ul[i]);
+    std::array<uint64_t, 5> ull;
+    convertByteOrder(reinterpret_cast<byte*>(ull.data()), buf.data(), ull.size(), 8, byteOrder);
+    for (size_t i = 0; i < ull.size(); ++i)
+      ASSERT_EQ(getULongLong(buf.data() + (8 * i), byteOrder), ull[i]);
+  }
+}
+
+TEST(convertByteOrder, writesValuesLikeTheScalarFunctions) {
+  const std::array<uint32_t, 3> ul{0x01020304, 0xa0b0c0d0, 42};
+  for (auto byteOrder : {littleEndian, bigEndian}) {
+    std::array<byte, 12> expected;
+    for (size_t i = 0; i < ul.size(); ++i)
+      ul2Data(expected.data() + (4 * i), ul[i], byteOrder);
+    std::array<byte, 12> buf;
+    convertByteOrder(buf.data(), reinterpret_cast<const byte*>(ul.data()), ul.size(), 4, byteOrder);
+    ASSERT_EQ(expected, buf);
+  }
+}
+
+TEST(convertByteOrder, convertsInPlace) {
+  std::array<byte, 6> buf{1, 2, 3, 4, 5, 6};
+  const bool swaps = std::endian::native == std::endian::little;
+  convertByteOrder(buf.data(), buf.data(), 3, 2, bigEndian);
+  const std::array<byte, 6> swapped{2, 1, 4, 3, 6, 5};
+  const std::array<byte, 6> same{1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(swaps ? swapped : same, buf);
+}
+
+TEST(ValueType, readsAndCopiesArraysInBothByteOrders) {
+  std::array<byte, 24> buf;
+  std::iota(buf.begin(), buf.end(), byte{0x70});
+  for (auto byteOrder : {littleEndian, bigEndian}) {
+    URationalValue value;
+    ASSERT_EQ(0, value.read(buf.data(), buf.size(), byteOrder));
+    ASSERT_EQ(3U, value.count());
+    for (size_t i = 0; i < value.count(); ++i)
+      ASSERT_EQ(getURational(buf.data() + (8 * i), byteOrder), value.value_.at(i));
+
+    std::array<byte, 24> copy;
+    ASSERT_EQ(copy.size(), value.copy(copy.data(), byteOrder));
+    ASSERT_EQ(buf, copy);
+
+    ShortValue shorts;
+    ASSERT_EQ(0, shorts.read(buf.data(), 5, byteOrder));
+    ASSERT_EQ(2U, shorts.count());
+    ASSERT_EQ(getShort(buf.data() + 2, byteOrder), shorts.toInt64(1));
+  }
+}
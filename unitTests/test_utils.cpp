@@ -2,6 +2,9 @@
 
 #include "utils.hpp"
 
+#include <iomanip>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace Exiv2::Internal;
@@ -23,3 +26,72 @@ TEST(stringUtils, upperTransformStringToUpperCase) {
 TEST(stringUtils, lowerTransformStringToLowerCase) {
   ASSERT_EQ("exiv2 rocks", lower("EXIV2 ROCKS"));
 }
+
+TEST(ScopedStringStream, startsLikeANewStream) {
+  {
+    ScopedStringStream ss;
+    ss.stream() << std::hex << std::setprecision(2) << std::setfill('0') << std::showpos << 255 << 1.2345;
+    ss.stream().setstate(std::ios::failbit);
+  }
+  ScopedStringStream ss;
+  ss.stream() << std::setw(4) << 255 << " " << 1.2345678;
+  ASSERT_FALSE(ss.stream().fail());
+  ASSERT_EQ(" 255 1.23457", ss.str());
+}
+
+TEST(ScopedStringStream, nestedStreamsAreDistinct) {
+  ScopedStringStream outer;
+  outer.stream() << "outer";
+  {
+    ScopedStringStream inner;
+    ASSERT_NE(&outer.stream(), &inner.stream());
+    inner.stream() << "inner";
+    ASSERT_EQ("inner", inner.str());
+  }
+  ASSERT_EQ("outer", outer.str());
+}
+
+TEST(hexCodec, encodesWithAndWithoutLineBreaks) {
+  const std::vector<uint8_t> data{0x00, 0x1f, 0xa0, 0xff, 0x7e};
+  std::string out = "x";
+  hexEncode(out, data.data(), data.size());
+  ASSERT_EQ("x001fa0ff7e", out);
+
+  out.clear();
+  hexEncode(out, data.data(), data.size(), 2, true);
+  ASSERT_EQ("\n001F\nA0FF\n7E", out);
+}
+
+TEST(hexCodec, decodesSkippingOtherCharacters) {
+  const std::string text = "= 00 1f\na\n0ffZ7e";
+  std::vector<uint8_t> buf(5);
+  const char* end = hexDecode(buf.data(), buf.size(), text.data(), text.data() + text.size());
+  ASSERT_EQ(text.data() + text.size(), end);
+  ASSERT_EQ((std::vector<uint8_t>{0x00, 0x1f, 0xa0, 0xff, 0x7e}), buf);
+}
+
+TEST(hexCodec, failsOnNulOrTruncatedText) {
+  std::vector<uint8_t> buf(4);
+  const std::string nul("0011\0" "2233", 9);
+  ASSERT_EQ(nullptr, hexDecode(buf.data(), buf.size(), nul.data(), nul.data() + nul.size()));
+  const std::string truncated = "0011223";
+  ASSERT_EQ(nullptr, hexDecode(buf.data(), buf.size(), truncated.data(), truncated.data() + truncated.size()));
+  // Uppercase digits are not hex digits of the text
+  const std::string upper = "0011AA2233";
+  ASSERT_NE(nullptr, hexDecode(buf.data(), buf.size(), upper.data(), upper.data() + upper.size()));
+  ASSERT_EQ((std::vector<uint8_t>{0x00, 0x11, 0x22, 0x33}), buf);
+}
+
+TEST(hexCodec, roundTripsLinesOfARawProfile) {
+  std::vector<uint8_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>((i * 131) ^ (i >> 7));
+  std::string text;
+  hexEncode(text, data.data(), data.size(), 36);
+  ASSERT_EQ(2 * data.size() + (data.size() + 35) / 36, text.size());
+
+  std::vector<uint8_t> decoded(data.size());
+  ASSERT_EQ(text.data() + text.size(),
+            hexDecode(decoded.data(), decoded.size(), text.data(), text.data() + text.size()));
+  ASSERT_EQ(data, decoded);
+}